@@ -11,12 +11,17 @@
 #include "barycentric_coordinates.h"
 #include "colon.h"
 #include "doublearea.h"
+#include "get_seconds.h"
+#include "morton_order.h"
+#include "parallel_for.h"
 #include "point_simplex_squared_distance.h"
 #include "project_to_line_segment.h"
 #include "sort.h"
 #include "volume.h"
 #include "ray_box_intersect.h"
 #include "ray_mesh_intersect.h"
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <iomanip>
 #include <limits>
@@ -99,6 +104,340 @@ void igl::AABB<DerivedV,DIM>::init(
   return init(V,Ele,MatrixXDIMS(),MatrixXDIMS(),VectorXi(),0);
 }
 
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::MatrixXi & Ele,
+    const AABBSplitMethod method)
+{
+  BuildStats stats;
+  return init(V,Ele,method,stats);
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::MatrixXi & Ele,
+    const AABBSplitMethod method,
+    BuildStats & stats)
+{
+  using namespace Eigen;
+  using namespace std;
+  const double t_start = get_seconds();
+  switch(method)
+  {
+    default:
+      assert(false && "Unknown split method");
+    case MEDIAN_AABB_SPLIT_METHOD:
+      init(V,Ele);
+      break;
+    case SAH_AABB_SPLIT_METHOD:
+    {
+      deinit();
+      if(V.size() == 0 || Ele.size() == 0)
+      {
+        break;
+      }
+      assert(DIM == V.cols() && "V.cols() should matched declared dimension");
+      const int m = Ele.rows();
+      // Element boxes are computed once, splits only reorder I
+      MatrixXDIMS Emin,Emax;
+      element_boxes(V,Ele,Emin,Emax);
+      std::vector<int> I(m);
+      for(int e = 0;e<m;e++)
+      {
+        I[e] = e;
+      }
+      init_sah(Emin,Emax,I,0,m);
+      break;
+    }
+  }
+  stats.seconds = get_seconds()-t_start;
+  stats.sah_cost = sah_cost();
+  stats.depth = depth();
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::init_sah(
+    const MatrixXDIMS & Emin,
+    const MatrixXDIMS & Emax,
+    std::vector<int> & I,
+    const int begin,
+    const int end)
+{
+  using namespace Eigen;
+  using namespace std;
+  assert(end > begin);
+  // Bounding box of elements and of their centers
+  m_box = AlignedBox<Scalar,DIM>();
+  AlignedBox<Scalar,DIM> centers;
+  for(int k = begin;k<end;k++)
+  {
+    m_box.extend(Emin.row(I[k]).transpose());
+    m_box.extend(Emax.row(I[k]).transpose());
+    centers.extend((0.5*(Emin.row(I[k])+Emax.row(I[k]))).transpose());
+  }
+  if(end-begin == 1)
+  {
+    m_primitive = I[begin];
+    return;
+  }
+  // Bins live on the stack: no allocation per level
+  const int num_bins = 16;
+  const auto & bin_of = [&](const int e, const int d)->int
+  {
+    const Scalar lo = centers.min()(d);
+    const Scalar extent = centers.max()(d)-lo;
+    const Scalar c = 0.5*(Emin(e,d)+Emax(e,d));
+    return std::min(num_bins-1,(int)((c-lo)*(num_bins/extent)));
+  };
+  int best_d = -1;
+  int best_bin = -1;
+  Scalar best_cost = numeric_limits<Scalar>::infinity();
+  for(int d = 0;d<DIM;d++)
+  {
+    if(!(centers.max()(d) > centers.min()(d)))
+    {
+      continue;
+    }
+    AlignedBox<Scalar,DIM> bin_box[num_bins];
+    int bin_count[num_bins] = {0};
+    for(int k = begin;k<end;k++)
+    {
+      const int b = bin_of(I[k],d);
+      bin_count[b]++;
+      bin_box[b].extend(Emin.row(I[k]).transpose());
+      bin_box[b].extend(Emax.row(I[k]).transpose());
+    }
+    // Sweep from the right to get cost of right side of each split plane
+    Scalar right_cost[num_bins];
+    AlignedBox<Scalar,DIM> acc;
+    int n = 0;
+    for(int b = num_bins-1;b>0;b--)
+    {
+      acc.extend(bin_box[b]);
+      n += bin_count[b];
+      right_cost[b] = half_area(acc)*n;
+    }
+    // Sweep from the left: split between bins b and b+1
+    acc.setEmpty();
+    n = 0;
+    for(int b = 0;b+1<num_bins;b++)
+    {
+      acc.extend(bin_box[b]);
+      n += bin_count[b];
+      const Scalar cost = half_area(acc)*n + right_cost[b+1];
+      if(n > 0 && n < end-begin && cost < best_cost)
+      {
+        best_cost = cost;
+        best_d = d;
+        best_bin = b+1;
+      }
+    }
+  }
+  int mid;
+  if(best_d == -1)
+  {
+    // All centers coincide: any split is as good as another
+    mid = begin + (end-begin+1)/2;
+  }else
+  {
+    mid = std::partition(I.begin()+begin,I.begin()+end,
+      [&](const int e){ return bin_of(e,best_d) < best_bin; }) - I.begin();
+  }
+  assert(mid > begin && mid < end);
+  m_left = new AABB();
+  m_right = new AABB();
+  const auto & build_child = [&](const int c)
+  {
+    if(c == 0)
+    {
+      m_left->init_sah(Emin,Emax,I,begin,mid);
+    }else
+    {
+      m_right->init_sah(Emin,Emax,I,mid,end);
+    }
+  };
+  // Subtrees touch disjoint ranges of I: build big ones concurrently
+  if(end-begin >= 4096)
+  {
+    parallel_for(2,build_child);
+  }else
+  {
+    build_child(0);
+    build_child(1);
+  }
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::element_boxes(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::MatrixXi & Ele,
+    MatrixXDIMS & Emin,
+    MatrixXDIMS & Emax)
+{
+  const int m = Ele.rows();
+  Emin.resize(m,DIM);
+  Emax.resize(m,DIM);
+  parallel_for(m,[&](const int e)
+  {
+    Emin.row(e) = V.row(Ele(e,0));
+    Emax.row(e) = V.row(Ele(e,0));
+    for(int c = 1;c<Ele.cols();c++)
+    {
+      Emin.row(e) = Emin.row(e).cwiseMin(V.row(Ele(e,c)));
+      Emax.row(e) = Emax.row(e).cwiseMax(V.row(Ele(e,c)));
+    }
+  },1000);
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE int igl::AABB<DerivedV,DIM>::refit(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::MatrixXi & Ele,
+    const Scalar max_growth)
+{
+  if(!is_leaf() && m_left == NULL)
+  {
+    // Empty tree
+    return 0;
+  }
+  assert(DIM == V.cols() && "V.cols() should matched declared dimension");
+  MatrixXDIMS Emin,Emax;
+  element_boxes(V,Ele,Emin,Emax);
+  refit_boxes(Emin,Emax,0);
+  if(!(max_growth < std::numeric_limits<Scalar>::infinity()))
+  {
+    return 0;
+  }
+  const Scalar root_growth =
+    m_build_area > 0 ? half_area(m_box)/m_build_area : Scalar(1);
+  std::vector<AABB *> grown;
+  find_grown(root_growth,max_growth,grown);
+  // Rebuilt subtrees keep their elements, so ancestors' boxes stay valid
+  parallel_for(grown.size(),[&](const size_t g)
+  {
+    AABB * node = grown[g];
+    std::vector<int> I;
+    node->gather_primitives(I);
+    node->deinit();
+    node->init_sah(Emin,Emax,I,0,I.size());
+    // Build areas are compared to the root's growth since the root was
+    // built, so undo the growth the root had until now
+    node->record_build_areas(1./root_growth);
+  },2);
+  return grown.size();
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::refit_boxes(
+    const MatrixXDIMS & Emin,
+    const MatrixXDIMS & Emax,
+    const int depth)
+{
+  // First refit records the boxes the tree was built with
+  if(m_build_area < 0)
+  {
+    m_build_area = half_area(m_box);
+  }
+  if(is_leaf())
+  {
+    m_box.min() = Emin.row(m_primitive).transpose();
+    m_box.max() = Emax.row(m_primitive).transpose();
+    return;
+  }
+  const auto & refit_child = [&](const int c)
+  {
+    (c == 0 ? m_left : m_right)->refit_boxes(Emin,Emax,depth+1);
+  };
+  // Top 8 levels fan out to the thread pool, deeper levels stay serial
+  if(depth < 8)
+  {
+    parallel_for(2,refit_child);
+  }else
+  {
+    refit_child(0);
+    refit_child(1);
+  }
+  m_box = m_left->m_box;
+  m_box.extend(m_right->m_box);
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::record_build_areas(
+    const Scalar scale)
+{
+  m_build_area = scale*half_area(m_box);
+  if(is_leaf())
+  {
+    return;
+  }
+  m_left->record_build_areas(scale);
+  m_right->record_build_areas(scale);
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::find_grown(
+    const Scalar root_growth,
+    const Scalar max_growth,
+    std::vector<AABB *> & grown)
+{
+  if(is_leaf())
+  {
+    return;
+  }
+  if(m_build_area > 0 && half_area(m_box) > max_growth*root_growth*m_build_area)
+  {
+    grown.push_back(this);
+    return;
+  }
+  m_left->find_grown(root_growth,max_growth,grown);
+  m_right->find_grown(root_growth,max_growth,grown);
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::gather_primitives(
+    std::vector<int> & I) const
+{
+  if(is_leaf())
+  {
+    I.push_back(m_primitive);
+    return;
+  }
+  if(m_left != NULL)
+  {
+    m_left->gather_primitives(I);
+  }
+  if(m_right != NULL)
+  {
+    m_right->gather_primitives(I);
+  }
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE typename igl::AABB<DerivedV,DIM>::Scalar
+igl::AABB<DerivedV,DIM>::half_area(const Eigen::AlignedBox<Scalar,DIM> & box)
+{
+  if(box.isEmpty())
+  {
+    return 0;
+  }
+  const VectorDIMS e = box.diagonal();
+  if(DIM < 3)
+  {
+    return e.sum();
+  }
+  Scalar a = 0;
+  for(int i = 0;i<DIM;i++)
+  {
+    for(int j = i+1;j<DIM;j++)
+    {
+      a += e(i)*e(j);
+    }
+  }
+  return a;
+}
+
   template <typename DerivedV, int DIM>
 IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
     const Eigen::PlainObjectBase<DerivedV> & V,
@@ -314,6 +653,50 @@ IGL_INLINE int igl::AABB<DerivedV,DIM>::subtree_size() const
 }
 
 
+template <typename DerivedV, int DIM>
+IGL_INLINE int igl::AABB<DerivedV,DIM>::depth() const
+{
+  int d = 0;
+  if(m_left != NULL)
+  {
+    d = std::max(d,m_left->depth()+1);
+  }
+  if(m_right != NULL)
+  {
+    d = std::max(d,m_right->depth()+1);
+  }
+  return d;
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE double igl::AABB<DerivedV,DIM>::sah_cost(
+  const double traversal_cost,
+  const double intersection_cost) const
+{
+  const double root_area = half_area(m_box);
+  const std::function<double(const AABB *)> cost =
+    [&](const AABB * node)->double
+  {
+    const double area = half_area(node->m_box);
+    if(node->is_leaf())
+    {
+      return area*intersection_cost;
+    }
+    double c = area*traversal_cost;
+    if(node->m_left != NULL)
+    {
+      c += cost(node->m_left);
+    }
+    if(node->m_right != NULL)
+    {
+      c += cost(node->m_right);
+    }
+    return c;
+  };
+  // Relative areas are meaningless if all elements lie on a line
+  return root_area > 0 ? cost(this)/root_area : 0;
+}
+
 template <typename DerivedV, int DIM>
 template <typename Derivedbb_mins, typename Derivedbb_maxs>
 IGL_INLINE void igl::AABB<DerivedV,DIM>::serialize(
@@ -455,21 +838,81 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::squared_distance(
   Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
   Eigen::PlainObjectBase<DerivedI> & I,
   Eigen::PlainObjectBase<DerivedC> & C) const
+{
+  return squared_distance_batch(V,Ele,P,true,sqrD,I,C);
+}
+
+template <typename DerivedV, int DIM>
+template <
+  typename DerivedP, 
+  typename DerivedsqrD, 
+  typename DerivedI>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::squared_distance(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::MatrixXi & Ele, 
+  const Eigen::PlainObjectBase<DerivedP> & P,
+  Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
+  Eigen::PlainObjectBase<DerivedI> & I) const
+{
+  MatrixXDIMS C;
+  return squared_distance_batch(V,Ele,P,false,sqrD,I,C);
+}
+
+template <typename DerivedV, int DIM>
+template <
+  typename DerivedP, 
+  typename DerivedsqrD, 
+  typename DerivedI, 
+  typename DerivedC>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::squared_distance_batch(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::MatrixXi & Ele, 
+  const Eigen::PlainObjectBase<DerivedP> & P,
+  const bool compute_C,
+  Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedC> & C) const
 {
   assert(P.cols() == V.cols() && "cols in P should match dim of cols in V");
-  sqrD.resize(P.rows(),1);
-  I.resize(P.rows(),1);
-  C.resizeLike(P);
+  const int np = P.rows();
+  sqrD.resize(np,1);
+  I.resize(np,1);
+  if(compute_C)
+  {
+    C.resizeLike(P);
+  }
   // O( #P * log #Ele ), where log #Ele is really the depth of this AABB
   // hierarchy
-  for(int p = 0;p<P.rows();p++)
+  Eigen::VectorXi order;
+  morton_order(P,order);
+  // Each thread takes contiguous runs of the Morton order so that every
+  // query but the first of a run is seeded by its spatial neighbour
+  const int run = 256;
+  const int num_runs = (np+run-1)/run;
+  parallel_for(num_runs,[&](const int r)
   {
-    RowVectorDIMS Pp = P.row(p), c;
-    int Ip;
-    sqrD(p) = squared_distance(V,Ele,Pp,Ip,c);
-    I(p) = Ip;
-    C.row(p).head(DIM) = c;
-  }
+    int prev = -1;
+    for(int k = r*run;k<std::min(np,(r+1)*run);k++)
+    {
+      const int p = order(k);
+      RowVectorDIMS Pp = P.row(p), c;
+      Scalar sqr_d = std::numeric_limits<Scalar>::infinity();
+      int Ip = -1;
+      if(prev >= 0)
+      {
+        // Upper bound (and candidate) from the previous closest primitive
+        igl::point_simplex_squared_distance<DIM>(Pp,V,Ele,prev,sqr_d,c);
+        Ip = prev;
+      }
+      sqrD(p) = squared_distance(V,Ele,Pp,sqr_d,Ip,c);
+      I(p) = Ip;
+      if(compute_C)
+      {
+        C.row(p).head(DIM) = c;
+      }
+      prev = Ip;
+    }
+  },2);
 }
 
 template <typename DerivedV, int DIM>
@@ -953,6 +1396,8 @@ igl::AABB<DerivedV,DIM>::intersect_ray(
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&) const;
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&) const;
 // generated by autoexplicit.sh
 template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 3, 0, -1, 3> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&) const;
 // generated by autoexplicit.sh
@@ -962,6 +1407,12 @@ template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_di
 // generated by autoexplicit.sh
 template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::init(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&);
 template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::init(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::init(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, igl::AABBSplitMethod);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::init(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, igl::AABBSplitMethod);
+template int igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::refit(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, double);
+template int igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::refit(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, double);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::init(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, igl::AABBSplitMethod, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::BuildStats&);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::init(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, igl::AABBSplitMethod, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::BuildStats&);
 template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
 template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, int&, Eigen::Matrix<double, 1, 3, 1, 1, 3>&) const;
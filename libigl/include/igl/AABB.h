@@ -8,6 +8,7 @@
 #ifndef IGL_AABB_H
 #define IGL_AABB_H
 
+#include "AABBSplitMethod.h"
 #include "Hit.h"
 #include "igl_inline.h"
 #include <Eigen/Core>
@@ -36,11 +37,14 @@ public:
       Eigen::AlignedBox<Scalar,DIM> m_box;
       // -1 non-leaf
       int m_primitive;
+      // Half area of m_box when this subtree was built, divided by the growth
+      // of the root's area at that time, -1 if not yet recorded (see refit)
+      Scalar m_build_area;
       //Scalar m_max_sqr_d;
       //int m_depth;
       AABB():
         m_left(NULL), m_right(NULL),
-        m_box(), m_primitive(-1)
+        m_box(), m_primitive(-1), m_build_area(-1)
         //m_max_sqr_d(std::numeric_limits<double>::infinity()),
         //m_depth(0)
     {}
@@ -49,7 +53,8 @@ public:
         m_left(other.m_left ? new AABB(*other.m_left) : NULL),
         m_right(other.m_right ? new AABB(*other.m_right) : NULL),
         m_box(other.m_box),
-        m_primitive(other.m_primitive)
+        m_primitive(other.m_primitive),
+        m_build_area(other.m_build_area)
         //m_max_sqr_d(other.m_max_sqr_d),
         //m_depth(std::max(
         //   m_left ? m_left->m_depth + 1 : 0,
@@ -65,6 +70,7 @@ public:
         swap(first.m_right,second.m_right);
         swap(first.m_box,second.m_box);
         swap(first.m_primitive,second.m_primitive);
+        swap(first.m_build_area,second.m_build_area);
         //swap(first.m_max_sqr_d,second.m_max_sqr_d);
         //swap(first.m_depth,second.m_depth);
       }
@@ -85,6 +91,7 @@ public:
       IGL_INLINE void deinit()
       {
         m_primitive = -1;
+        m_build_area = -1;
         m_box = Eigen::AlignedBox<Scalar,DIM>();
         delete m_left;
         m_left = NULL;
@@ -117,6 +124,37 @@ public:
       IGL_INLINE void init(
           const Eigen::PlainObjectBase<DerivedV> & V,
           const Eigen::MatrixXi & Ele);
+      // Statistics of a build, see init(V,Ele,method,stats)
+      struct BuildStats
+      {
+        // Wall-clock time spent in init
+        double seconds;
+        // Surface area heuristic cost of the tree (see sah_cost())
+        double sah_cost;
+        // Depth of deepest leaf (root is 0)
+        int depth;
+      };
+      // Build an Axis-Aligned Bounding Box tree for a given mesh, choosing how
+      // elements are split.
+      //
+      // Inputs:
+      //   V  #V by dim list of mesh vertex positions.
+      //   Ele  #Ele by dim+1 list of mesh indices into #V.
+      //   method  method used to split elements at each node:
+      //     MEDIAN_AABB_SPLIT_METHOD  same as init(V,Ele)
+      //     SAH_AABB_SPLIT_METHOD  binned surface area heuristic, subtrees
+      //       built in parallel on igl::ThreadPool
+      // Outputs:
+      //   stats  build time and quality of resulting tree
+      IGL_INLINE void init(
+          const Eigen::PlainObjectBase<DerivedV> & V,
+          const Eigen::MatrixXi & Ele,
+          const AABBSplitMethod method);
+      IGL_INLINE void init(
+          const Eigen::PlainObjectBase<DerivedV> & V,
+          const Eigen::MatrixXi & Ele,
+          const AABBSplitMethod method,
+          BuildStats & stats);
       // Build an Axis-Aligned Bounding Box tree for a given mesh.
       //
       // Inputs:
@@ -134,6 +172,24 @@ public:
           const Eigen::MatrixXi & Ele, 
           const Eigen::MatrixXi & SI,
           const Eigen::VectorXi & I);
+      // Update boxes after vertices moved, keeping the tree topology. Boxes
+      // are recomputed bottom-up (the top levels in parallel). A subtree is
+      // rebuilt (with SAH_AABB_SPLIT_METHOD) if its box area grew, relative to
+      // when it was built, more than max_growth times as much as the root's:
+      // this catches subtrees whose elements drifted apart without punishing
+      // uniform scaling.
+      //
+      // Inputs:
+      //   V  #V by dim list of new mesh vertex positions
+      //   Ele  #Ele by dim+1 list of mesh indices into #V, **same as used to
+      //     build the tree**
+      //   max_growth  relative area growth above which a subtree is rebuilt
+      //     (infinity to never rebuild) {2}
+      // Returns number of subtrees rebuilt
+      IGL_INLINE int refit(
+          const Eigen::PlainObjectBase<DerivedV> & V,
+          const Eigen::MatrixXi & Ele,
+          const Scalar max_growth = 2);
       // Return whether at leaf node
       IGL_INLINE bool is_leaf() const;
       // Find the indices of elements containing given point: this makes sense
@@ -158,6 +214,20 @@ public:
       // If number of elements m then total tree size should be 2*h where h is
       // the deepest depth 2^ceil(log(#Ele*2-1))
       IGL_INLINE int subtree_size() const;
+      // Returns depth of deepest leaf below this node (0 if this is a leaf)
+      IGL_INLINE int depth() const;
+      // Surface area heuristic cost of this subtree: expected cost of a random
+      // ray traversing it, relative to the area of this node's box
+      //
+      //   sum_internal area(n)/area(root) * traversal_cost +
+      //   sum_leaves   area(n)/area(root) * intersection_cost
+      //
+      // Inputs:
+      //   traversal_cost  cost of visiting an internal node {1}
+      //   intersection_cost  cost of testing a primitive {1}
+      IGL_INLINE double sah_cost(
+          const double traversal_cost = 1,
+          const double intersection_cost = 1) const;
 
       // Serialize this class into 3 arrays (so we can pass it pack to matlab)
       //
@@ -244,6 +314,11 @@ public:
       // _closest_ points on the primitives stored in the AABB hierarchy for
       // the mesh (V,Ele).
       //
+      // Queries are visited in Morton order and split across igl::ThreadPool.
+      // Each query's search is seeded with the distance to its predecessor's
+      // closest primitive, so neighbouring queries prune most of the tree
+      // immediately.
+      //
       // Inputs:
       //   V  #V by dim list of vertex positions
       //   Ele  #Ele by dim list of simplex indices
@@ -264,6 +339,18 @@ public:
         Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
         Eigen::PlainObjectBase<DerivedI> & I,
         Eigen::PlainObjectBase<DerivedC> & C) const;
+      // Same as above but without computing closest points (C is never
+      // allocated)
+      template <
+        typename DerivedP, 
+        typename DerivedsqrD, 
+        typename DerivedI>
+      IGL_INLINE void squared_distance(
+        const Eigen::PlainObjectBase<DerivedV> & V,
+        const Eigen::MatrixXi & Ele, 
+        const Eigen::PlainObjectBase<DerivedP> & P,
+        Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
+        Eigen::PlainObjectBase<DerivedI> & I) const;
 
       // Compute the squared distance from all query points in P already stored
       // in its own AABB hierarchy to the _closest_ points on the primitives
@@ -295,6 +382,66 @@ public:
         Eigen::PlainObjectBase<DerivedI> & I,
         Eigen::PlainObjectBase<DerivedC> & C) const;
 private:
+      // Implementation of batched squared_distance, C is only written if
+      // compute_C is true
+      template <
+        typename DerivedP, 
+        typename DerivedsqrD, 
+        typename DerivedI, 
+        typename DerivedC>
+      IGL_INLINE void squared_distance_batch(
+        const Eigen::PlainObjectBase<DerivedV> & V,
+        const Eigen::MatrixXi & Ele, 
+        const Eigen::PlainObjectBase<DerivedP> & P,
+        const bool compute_C,
+        Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
+        Eigen::PlainObjectBase<DerivedI> & I,
+        Eigen::PlainObjectBase<DerivedC> & C) const;
+      // Build this subtree over elements I[begin,end) using binned surface
+      // area heuristic splits. I is partitioned in place.
+      //
+      // Inputs:
+      //   Emin  #Ele by dim list of element box min corners
+      //   Emax  #Ele by dim list of element box max corners
+      //   I  #Ele list of element indices, see output
+      //   begin  first index into I of this subtree
+      //   end  one past last index into I of this subtree
+      // Outputs:
+      //   I  reordered so that each subtree is contiguous
+      IGL_INLINE void init_sah(
+          const MatrixXDIMS & Emin,
+          const MatrixXDIMS & Emax,
+          std::vector<int> & I,
+          const int begin,
+          const int end);
+      // Compute box of each element
+      //
+      // Outputs:
+      //   Emin  #Ele by dim list of element box min corners
+      //   Emax  #Ele by dim list of element box max corners
+      IGL_INLINE static void element_boxes(
+          const Eigen::PlainObjectBase<DerivedV> & V,
+          const Eigen::MatrixXi & Ele,
+          MatrixXDIMS & Emin,
+          MatrixXDIMS & Emax);
+      // Recompute boxes of this subtree from element boxes (see refit)
+      IGL_INLINE void refit_boxes(
+          const MatrixXDIMS & Emin,
+          const MatrixXDIMS & Emax,
+          const int depth);
+      // Record the build areas of all nodes of this subtree, scaled to the
+      // frame of the root's build area (see refit)
+      IGL_INLINE void record_build_areas(const Scalar scale);
+      // Collect topmost subtrees that grew too much (see refit)
+      IGL_INLINE void find_grown(
+          const Scalar root_growth,
+          const Scalar max_growth,
+          std::vector<AABB *> & grown);
+      // Append indices of all elements in this subtree to I
+      IGL_INLINE void gather_primitives(std::vector<int> & I) const;
+      // Returns half the surface area of a box (perimeter in 2D), 0 if empty
+      IGL_INLINE static Scalar half_area(
+          const Eigen::AlignedBox<Scalar,DIM> & box);
       template < 
         typename Derivedother_V,
         typename DerivedsqrD, 
@@ -0,0 +1,23 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2015 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_AABBSPLITMETHOD_H
+#define IGL_AABBSPLITMETHOD_H
+namespace igl
+{
+  // MEDIAN_AABB_SPLIT_METHOD  split at median barycenter along longest axis
+  //   (serial)
+  // SAH_AABB_SPLIT_METHOD  split at binned surface area heuristic minimum
+  //   (large subtrees built in parallel)
+  enum AABBSplitMethod
+  {
+    MEDIAN_AABB_SPLIT_METHOD = 0,
+    SAH_AABB_SPLIT_METHOD = 1,
+    NUM_AABB_SPLIT_METHODS = 2
+  };
+}
+#endif
@@ -0,0 +1,79 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "AndersonAcceleration.h"
+#include <Eigen/SVD>
+#include <algorithm>
+#include <cassert>
+
+IGL_INLINE void igl::AndersonAcceleration::init(
+  const int m,
+  const Eigen::VectorXd & x0)
+{
+  assert(m >= 0 && "Window size should be non-negative");
+  m_m = m;
+  m_dF.resize(x0.size(),m);
+  m_dG.resize(x0.size(),m);
+  m_M.resize(m,m);
+  reset(x0);
+}
+
+IGL_INLINE const Eigen::VectorXd & igl::AndersonAcceleration::compute(
+  const Eigen::VectorXd & g)
+{
+  assert(g.size() == m_x.size() && "g should have the size of the iterates");
+  const Eigen::VectorXd f = g-m_x;
+  if(m_iter == 0 || m_m == 0)
+  {
+    m_x = g;
+  }else
+  {
+    Eigen::VectorXd df = f-m_f_prev;
+    const double df_norm = df.norm();
+    if(df_norm == 0)
+    {
+      // Nothing to extrapolate from
+      m_x = g;
+    }else
+    {
+      m_dF.col(m_col) = df/df_norm;
+      m_dG.col(m_col) = (g-m_g_prev)/df_norm;
+      m_num = std::min(m_num+1,m_m);
+      const int k = m_num;
+      for(int j = 0;j<k;j++)
+      {
+        m_M(m_col,j) = m_M(j,m_col) = m_dF.col(m_col).dot(m_dF.col(j));
+      }
+      // theta = argmin |f - dF*theta| via the normal equations, ignoring
+      // (nearly) dependent columns of dF
+      Eigen::JacobiSVD<Eigen::MatrixXd> svd(
+        m_M.topLeftCorner(k,k),Eigen::ComputeThinU|Eigen::ComputeThinV);
+      svd.setThreshold(1e-10);
+      const Eigen::VectorXd theta = svd.solve(m_dF.leftCols(k).transpose()*f);
+      m_x = g-m_dG.leftCols(k)*theta;
+      m_col = (m_col+1)%m_m;
+    }
+  }
+  m_g_prev = g;
+  m_f_prev = f;
+  m_iter++;
+  return m_x;
+}
+
+IGL_INLINE void igl::AndersonAcceleration::reset(const Eigen::VectorXd & x)
+{
+  m_x = x;
+  m_iter = 0;
+  m_num = 0;
+  m_col = 0;
+}
+
+IGL_INLINE void igl::AndersonAcceleration::replace(const Eigen::VectorXd & x)
+{
+  assert(x.size() == m_x.size() && "x should have the size of the iterates");
+  m_x = x;
+}
@@ -0,0 +1,92 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_ANDERSON_ACCELERATION_H
+#define IGL_ANDERSON_ACCELERATION_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  // Anderson acceleration of a fixed point iteration x <- G(x) (e.g. the
+  // local/global iterations of ARAP or SLIM) according to "Anderson
+  // Acceleration for Geometry Optimization and Physics Simulation" [Peng et
+  // al. 2018]. Each new iterate combines G of the current iterate with the
+  // last m iterates so as to minimize the residual G(x)-x in the least
+  // squares sense. The accelerated iterate is not guaranteed to decrease the
+  // energy being minimized: callers should check it against the energy of
+  // the previous iterate and replace it by G(x) otherwise.
+  //
+  // Example:
+  //   igl::AndersonAcceleration aa;
+  //   aa.init(5,x);
+  //   while(...)
+  //   {
+  //     g = G(x);
+  //     e_prev = energy(x);
+  //     x = aa.compute(g);
+  //     if(energy(x) >= e_prev)
+  //     {
+  //       x = g;
+  //       aa.replace(x);
+  //     }
+  //   }
+  class AndersonAcceleration
+  {
+    public:
+      AndersonAcceleration():m_m(0),m_iter(0),m_num(0),m_col(0){}
+      // Start a new sequence of iterates
+      //
+      // Inputs:
+      //   m  number of previous iterates used (window size)
+      //   x0  initial iterate
+      IGL_INLINE void init(const int m,const Eigen::VectorXd & x0);
+      // Compute the next iterate
+      //
+      // Inputs:
+      //   g  G(x) for the current iterate x
+      // Returns the next (accelerated) iterate, which becomes the current one
+      IGL_INLINE const Eigen::VectorXd & compute(const Eigen::VectorXd & g);
+      // Discard the previous iterates and restart from x
+      //
+      // Inputs:
+      //   x  new current iterate
+      IGL_INLINE void reset(const Eigen::VectorXd & x);
+      // Replace the current iterate by x, keeping the previous iterates (e.g.
+      // by G(x) after rejecting an accelerated iterate)
+      //
+      // Inputs:
+      //   x  new current iterate
+      IGL_INLINE void replace(const Eigen::VectorXd & x);
+      // Returns the window size
+      int window() const { return m_m; }
+      // Returns the current iterate
+      const Eigen::VectorXd & current() const { return m_x; }
+    private:
+      // Window size
+      int m_m;
+      // Number of calls to compute since the last reset
+      int m_iter;
+      // Number of differences in the history
+      int m_num;
+      // Column of the history overwritten next
+      int m_col;
+      // Current iterate, G(x) and G(x)-x of the previous iterate
+      Eigen::VectorXd m_x;
+      Eigen::VectorXd m_g_prev;
+      Eigen::VectorXd m_f_prev;
+      // #x by m differences of successive G(x)-x and G(x) (scaled so that
+      // the former have unit norm) and m by m dot products of the former
+      Eigen::MatrixXd m_dF;
+      Eigen::MatrixXd m_dG;
+      Eigen::MatrixXd m_M;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "AndersonAcceleration.cpp"
+#endif
+#endif
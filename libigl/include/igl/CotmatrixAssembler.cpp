@@ -0,0 +1,121 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "CotmatrixAssembler.h"
+#include "cotmatrix_entries.h"
+#include "parallel_for.h"
+#include "sparse_assembly.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+IGL_INLINE void igl::CotmatrixAssembler::element_edge(
+  const int t,
+  int & i,
+  int & e) const
+{
+  const int q = t/4;
+  i = m_num_edges == 3 ? q/3 : q/6;
+  e = q - i*m_num_edges;
+}
+
+template <typename DerivedF>
+IGL_INLINE void igl::CotmatrixAssembler::init(
+  const int n,
+  const Eigen::MatrixBase<DerivedF> & F)
+{
+  assert((F.cols() == 3 || F.cols() == 4) && "F should contain triangles or tets");
+  m_F = F.template cast<int>();
+  m_num_edges = F.cols() == 3 ? 3 : 6;
+  m_C.resize(F.rows(),m_num_edges);
+  // Same edges and triplets as cotmatrix
+  const int edges[6][2] = {{1,2},{2,0},{0,1},{3,0},{3,1},{3,2}};
+  const auto ij = [&](const int t,int & r,int & c)
+  {
+    int i,e;
+    element_edge(t,i,e);
+    const int k = t%4;
+    const int source = m_F(i,edges[e][0]);
+    const int dest = m_F(i,edges[e][1]);
+    r = (k == 0 || k == 2) ? source : dest;
+    c = (k == 1 || k == 2) ? source : dest;
+  };
+  sparse_assembly_pattern(
+    n,n,m_F.rows()*m_num_edges*4,ij,m_pattern,m_slots,m_order);
+}
+
+template <typename DerivedV>
+IGL_INLINE void igl::CotmatrixAssembler::update(
+  const Eigen::MatrixBase<DerivedV> & V,
+  Eigen::SparseMatrix<double> & L)
+{
+  using namespace std;
+  assert(V.rows() == m_pattern.rows() && "V should have n rows");
+  const int m = m_F.rows();
+  if(m_F.cols() == 3)
+  {
+    // Same computation as cotmatrix_entries, one triangle at a time
+    parallel_for(m,[&](const int i)
+    {
+      double l2[3];
+      l2[0] = (V.row(m_F(i,1))-V.row(m_F(i,2))).squaredNorm();
+      l2[1] = (V.row(m_F(i,2))-V.row(m_F(i,0))).squaredNorm();
+      l2[2] = (V.row(m_F(i,0))-V.row(m_F(i,1))).squaredNorm();
+      // Sorted edge lengths
+      double l[3] = {sqrt(l2[0]),sqrt(l2[1]),sqrt(l2[2])};
+      std::sort(l,l+3,std::greater<double>());
+      // Kahan's Heron's formula (see doublearea.h)
+      const double arg =
+        (l[0]+(l[1]+l[2]))*
+        (l[2]-(l[0]-l[1]))*
+        (l[2]+(l[0]-l[1]))*
+        (l[0]+(l[1]-l[2]));
+      double dblA = 2.0*0.25*sqrt(arg);
+      if(dblA != dblA)
+      {
+        dblA = 0;
+      }
+      m_C(i,0) = (l2[1] + l2[2] - l2[0])/dblA/4.0;
+      m_C(i,1) = (l2[2] + l2[0] - l2[1])/dblA/4.0;
+      m_C(i,2) = (l2[0] + l2[1] - l2[2])/dblA/4.0;
+    },1000);
+  }else
+  {
+    cotmatrix_entries(V,m_F,m_C);
+  }
+  if(
+    L.rows() != m_pattern.rows() ||
+    L.cols() != m_pattern.cols() ||
+    L.nonZeros() != m_pattern.nonZeros() ||
+    !L.isCompressed() ||
+    !std::equal(
+      m_pattern.outerIndexPtr(),
+      m_pattern.outerIndexPtr()+m_pattern.cols()+1,
+      L.outerIndexPtr()) ||
+    !std::equal(
+      m_pattern.innerIndexPtr(),
+      m_pattern.innerIndexPtr()+m_pattern.nonZeros(),
+      L.innerIndexPtr()))
+  {
+    L = m_pattern;
+  }
+  const auto value = [this](const int t)->double
+  {
+    int i,e;
+    element_edge(t,i,e);
+    return t%4 < 2 ? m_C(i,e) : -m_C(i,e);
+  };
+  sparse_assembly_values(m_slots,m_order,value,L);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::CotmatrixAssembler::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(int, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::CotmatrixAssembler::init<Eigen::Matrix<int, -1, 3, 0, -1, 3> >(int, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&);
+template void igl::CotmatrixAssembler::update<Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::CotmatrixAssembler::update<Eigen::Matrix<double, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::SparseMatrix<double, 0, int>&);
+#endif
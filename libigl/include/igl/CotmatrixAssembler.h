@@ -0,0 +1,82 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_COTMATRIX_ASSEMBLER_H
+#define IGL_COTMATRIX_ASSEMBLER_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+namespace igl
+{
+  // Assembler of the cotangent Laplacian (see cotmatrix.h) of a mesh whose
+  // connectivity stays fixed while its vertices move (e.g., across the
+  // iterations of ARAP, SLIM or curvature flow). The sparsity pattern and
+  // the entries of the compressed matrix receiving each cotangent are
+  // computed once from F. Each update only recomputes the cotangents and
+  // overwrites the values of L in place, so that a factorization of a matrix
+  // with the same pattern can be refreshed numerically. For triangle meshes
+  // updates do not allocate memory.
+  //
+  // The result is bitwise identical to igl::cotmatrix(V,F,L).
+  //
+  // Example:
+  //   igl::CotmatrixAssembler assembler(V.rows(),F);
+  //   Eigen::SparseMatrix<double> L;
+  //   while(...)
+  //   {
+  //     assembler.update(V,L);
+  //     ...
+  //   }
+  class CotmatrixAssembler
+  {
+    public:
+      CotmatrixAssembler(){}
+      template <typename DerivedF>
+      CotmatrixAssembler(const int n,const Eigen::MatrixBase<DerivedF> & F)
+      {
+        init(n,F);
+      }
+      // Precompute the sparsity pattern of the Laplacian of a mesh
+      //
+      // Inputs:
+      //   n  number of vertices
+      //   F  #F by simplex_size list of mesh elements (triangles or
+      //     tetrahedra)
+      template <typename DerivedF>
+      IGL_INLINE void init(const int n,const Eigen::MatrixBase<DerivedF> & F);
+      // Assemble the Laplacian for new vertex positions
+      //
+      // Inputs:
+      //   V  n by dim list of mesh vertex positions
+      //   L  n by n output of a previous update (its values are overwritten),
+      //     otherwise it is first set to the sparsity pattern
+      // Outputs:
+      //   L  n by n cotangent matrix
+      template <typename DerivedV>
+      IGL_INLINE void update(
+        const Eigen::MatrixBase<DerivedV> & V,
+        Eigen::SparseMatrix<double> & L);
+    private:
+      // Element and edge (see cotmatrix.cpp) of triplet t
+      IGL_INLINE void element_edge(const int t,int & i,int & e) const;
+      // #F by simplex_size list of mesh elements
+      Eigen::MatrixXi m_F;
+      // Number of edges per element (3 or 6)
+      int m_num_edges;
+      // Sparsity pattern and triplets of each entry (see sparse_assembly.h)
+      Eigen::SparseMatrix<double> m_pattern;
+      Eigen::VectorXi m_slots;
+      Eigen::VectorXi m_order;
+      // #F by m_num_edges list of cotangents (see cotmatrix_entries.h)
+      Eigen::MatrixXd m_C;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "CotmatrixAssembler.cpp"
+#endif
+#endif
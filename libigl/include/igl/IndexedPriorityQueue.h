@@ -0,0 +1,207 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_INDEXEDPRIORITYQUEUE_H
+#define IGL_INDEXEDPRIORITYQUEUE_H
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace igl
+{
+  // Min-priority queue of (cost,id) pairs with ids in [0,n), stored as an
+  // implicit D-ary heap in one contiguous array. Each id appears at most once
+  // and its position in the heap is tracked, so its cost can be changed
+  // (decreased or increased) or it can be removed by id in O(D log_D n).
+  // Entries are ordered like the pairs in a std::set<std::pair<double,int> >
+  // (by cost, ties broken by id).
+  //
+  // Removal by id is lazy: the entry is only marked dead and stays in the heap
+  // until it surfaces at the top (or its id is updated again, which revives
+  // it). The top of the queue is always a live entry.
+  //
+  // Template:
+  //   D  number of children per heap node
+  //
+  // See also: SetPriorityQueue, decimate, collapse_edge
+  template <int D = 4>
+  class IndexedPriorityQueue
+  {
+    public:
+      typedef std::pair<double,int> Entry;
+      inline IndexedPriorityQueue():m_heap(),m_pos(),m_num_dead(0){}
+      // Clear the queue and prepare for ids in [0,n)
+      inline void resize(const int n)
+      {
+        m_heap.clear();
+        m_heap.reserve(n);
+        m_pos.assign(n,-1);
+        m_num_dead = 0;
+      }
+      // Number of live entries
+      inline int size() const { return (int)m_heap.size() - m_num_dead; }
+      inline bool empty() const { return size() == 0; }
+      // Returns whether id has a live entry
+      inline bool contains(const int id) const
+      {
+        return m_pos[id] >= 0 && m_heap[m_pos[id]].second >= 0;
+      }
+      // Returns cost of live entry id
+      inline double cost(const int id) const
+      {
+        assert(contains(id));
+        return m_heap[m_pos[id]].first;
+      }
+      // Returns least (cost,id) entry. Queue must not be empty.
+      inline const Entry & top() const
+      {
+        assert(!empty());
+        return m_heap.front();
+      }
+      // Remove least entry
+      inline void pop()
+      {
+        assert(!empty());
+        remove_top();
+        prune();
+      }
+      // Insert id with cost, or change the cost of id if already present
+      inline void update(const int id, const double cost)
+      {
+        int i = m_pos[id];
+        if(i < 0)
+        {
+          i = m_heap.size();
+          m_heap.push_back(Entry(cost,id));
+          m_pos[id] = i;
+          sift_up(i);
+        }else
+        {
+          Entry & entry = m_heap[i];
+          if(entry.second < 0)
+          {
+            // revive
+            entry.second = id;
+            m_num_dead--;
+          }
+          const bool decrease = Entry(cost,id) < entry;
+          entry.first = cost;
+          if(decrease)
+          {
+            sift_up(i);
+          }else
+          {
+            sift_down(i);
+          }
+        }
+        prune();
+      }
+      // Remove id (no-op if not present)
+      inline void erase(const int id)
+      {
+        if(!contains(id))
+        {
+          return;
+        }
+        const int i = m_pos[id];
+        if(i == 0)
+        {
+          pop();
+          return;
+        }
+        m_heap[i].second = dead(id);
+        m_num_dead++;
+      }
+    private:
+      // Dead entries store -1-id in place of id
+      static inline int dead(const int id){ return -1-id; }
+      static inline int id_of(const Entry & entry)
+      {
+        return entry.second < 0 ? dead(entry.second) : entry.second;
+      }
+      static inline bool less(const Entry & a, const Entry & b)
+      {
+        return a.first < b.first || (a.first == b.first && id_of(a) < id_of(b));
+      }
+      inline void place(const int i, const Entry & entry)
+      {
+        m_heap[i] = entry;
+        m_pos[id_of(entry)] = i;
+      }
+      inline void sift_up(int i)
+      {
+        const Entry entry = m_heap[i];
+        while(i > 0)
+        {
+          const int parent = (i-1)/D;
+          if(!less(entry,m_heap[parent]))
+          {
+            break;
+          }
+          place(i,m_heap[parent]);
+          i = parent;
+        }
+        place(i,entry);
+      }
+      inline void sift_down(int i)
+      {
+        const int n = m_heap.size();
+        const Entry entry = m_heap[i];
+        while(true)
+        {
+          const int first = D*i+1;
+          if(first >= n)
+          {
+            break;
+          }
+          const int last = first+D < n ? first+D : n;
+          int c = first;
+          for(int j = first+1;j<last;j++)
+          {
+            if(less(m_heap[j],m_heap[c]))
+            {
+              c = j;
+            }
+          }
+          if(!less(m_heap[c],entry))
+          {
+            break;
+          }
+          place(i,m_heap[c]);
+          i = c;
+        }
+        place(i,entry);
+      }
+      inline void remove_top()
+      {
+        m_pos[id_of(m_heap.front())] = -1;
+        const Entry last = m_heap.back();
+        m_heap.pop_back();
+        if(!m_heap.empty())
+        {
+          m_heap.front() = last;
+          m_pos[id_of(last)] = 0;
+          sift_down(0);
+        }
+      }
+      // Drop dead entries from the top
+      inline void prune()
+      {
+        while(!m_heap.empty() && m_heap.front().second < 0)
+        {
+          remove_top();
+          m_num_dead--;
+        }
+      }
+      std::vector<Entry> m_heap;
+      // m_pos[id] position of id's (live or dead) entry in m_heap, or -1
+      std::vector<int> m_pos;
+      int m_num_dead;
+  };
+}
+
+#endif
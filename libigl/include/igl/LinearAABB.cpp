@@ -0,0 +1,609 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2015 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "LinearAABB.h"
+#include "EPS.h"
+#include "barycenter.h"
+#include "doublearea.h"
+#include "morton_order.h"
+#include "parallel_for.h"
+#include "point_simplex_squared_distance.h"
+#include "volume.h"
+#include "ray_box_intersect.h"
+#include "ray_mesh_intersect.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::LinearAABB<DerivedV,DIM>::init(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::MatrixXi & Ele,
+    const int leaf_size)
+{
+  using namespace Eigen;
+  using namespace std;
+  deinit();
+  if(V.size() == 0 || Ele.size() == 0)
+  {
+    return;
+  }
+  assert(DIM == V.cols() && "V.cols() should matched declared dimension");
+  assert(leaf_size >= 1 && "leaf_size should be positive");
+  const int m = Ele.rows();
+  MatrixXDIMS BC;
+  if(Ele.cols() == 1)
+  {
+    // points
+    BC = V;
+  }else
+  {
+    // Simplices
+    barycenter(V,Ele,BC);
+  }
+  const auto nodes = std::make_shared<std::vector<Node> >();
+  nodes->reserve(2*m-1);
+  const auto prims = std::make_shared<std::vector<int> >(m);
+  std::vector<int> & I = *prims;
+  for(int e = 0;e<m;e++)
+  {
+    I[e] = e;
+  }
+  // Elements of node are I[begin,end); partitioned in place so that no
+  // per-level index lists are allocated.
+  const std::function<int(const int,const int)> build =
+    [&](const int begin, const int end)->int
+  {
+    const int id = nodes->size();
+    nodes->push_back(Node());
+    AlignedBox<Scalar,DIM> box;
+    for(int k = begin;k<end;k++)
+    {
+      for(int c = 0;c<Ele.cols();c++)
+      {
+        box.extend(V.row(Ele(I[k],c)).transpose());
+      }
+    }
+    set_box(box,(*nodes)[id]);
+    if(end-begin <= leaf_size)
+    {
+      (*nodes)[id].offset = begin;
+      (*nodes)[id].count = end-begin;
+      return id;
+    }
+    // Split at median barycenter along longest axis of barycenters
+    AlignedBox<Scalar,DIM> centers;
+    for(int k = begin;k<end;k++)
+    {
+      centers.extend(BC.row(I[k]).transpose());
+    }
+    int max_d = -1;
+    centers.diagonal().maxCoeff(&max_d);
+    const int mid = begin + (end-begin+1)/2;
+    // Break ties by index so the result does not depend on the std library
+    std::nth_element(I.begin()+begin,I.begin()+mid,I.begin()+end,
+      [&BC,max_d](const int a, const int b)->bool
+      {
+        return BC(a,max_d)<BC(b,max_d) || (BC(a,max_d)==BC(b,max_d) && a<b);
+      });
+    build(begin,mid);
+    const int right = build(mid,end);
+    (*nodes)[id].offset = right;
+    (*nodes)[id].count = 0;
+    return id;
+  };
+  build(0,m);
+  m_nodes = nodes;
+  m_primitives = prims;
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::LinearAABB<DerivedV,DIM>::init(
+  const AABB<DerivedV,DIM> & tree)
+{
+  deinit();
+  // Empty tree
+  if(!tree.is_leaf() && tree.m_left == NULL)
+  {
+    return;
+  }
+  const auto nodes = std::make_shared<std::vector<Node> >();
+  const auto prims = std::make_shared<std::vector<int> >();
+  const std::function<int(const AABB<DerivedV,DIM> *)> flatten =
+    [&](const AABB<DerivedV,DIM> * t)->int
+  {
+    const int id = nodes->size();
+    nodes->push_back(Node());
+    set_box(t->m_box,(*nodes)[id]);
+    if(t->is_leaf())
+    {
+      (*nodes)[id].offset = prims->size();
+      (*nodes)[id].count = 1;
+      prims->push_back(t->m_primitive);
+      return id;
+    }
+    assert(t->m_left && t->m_right && "Internal nodes should have 2 children");
+    flatten(t->m_left);
+    const int right = flatten(t->m_right);
+    (*nodes)[id].offset = right;
+    (*nodes)[id].count = 0;
+    return id;
+  };
+  flatten(&tree);
+  m_nodes = nodes;
+  m_primitives = prims;
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::LinearAABB<DerivedV,DIM>::deinit()
+{
+  m_nodes.reset();
+  m_primitives.reset();
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE int igl::LinearAABB<DerivedV,DIM>::size() const
+{
+  return m_nodes ? m_nodes->size() : 0;
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE bool igl::LinearAABB<DerivedV,DIM>::is_leaf(const int i) const
+{
+  return (*m_nodes)[i].count > 0;
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE Eigen::AlignedBox<typename DerivedV::Scalar,DIM>
+igl::LinearAABB<DerivedV,DIM>::box(const int i) const
+{
+  const Node & n = (*m_nodes)[i];
+  Eigen::AlignedBox<Scalar,DIM> b;
+  for(int d = 0;d<DIM;d++)
+  {
+    b.min()(d) = n.min[d];
+    b.max()(d) = n.max[d];
+  }
+  return b;
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE const std::vector<typename igl::LinearAABB<DerivedV,DIM>::Node> &
+igl::LinearAABB<DerivedV,DIM>::nodes() const
+{
+  static const std::vector<Node> empty;
+  return m_nodes ? *m_nodes : empty;
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE const std::vector<int> &
+igl::LinearAABB<DerivedV,DIM>::primitives() const
+{
+  static const std::vector<int> empty;
+  return m_primitives ? *m_primitives : empty;
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::LinearAABB<DerivedV,DIM>::set_box(
+  const Eigen::AlignedBox<Scalar,DIM> & box,
+  Node & node)
+{
+  const float inf = std::numeric_limits<float>::infinity();
+  for(int d = 0;d<DIM;d++)
+  {
+    float lo = (float)box.min()(d);
+    if(Scalar(lo) > box.min()(d))
+    {
+      lo = std::nextafter(lo,-inf);
+    }
+    float hi = (float)box.max()(d);
+    if(Scalar(hi) < box.max()(d))
+    {
+      hi = std::nextafter(hi,inf);
+    }
+    node.min[d] = lo;
+    node.max[d] = hi;
+  }
+}
+
+template <typename DerivedV, int DIM>
+template <typename Derivedq>
+IGL_INLINE std::vector<int> igl::LinearAABB<DerivedV,DIM>::find(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::MatrixXi & Ele,
+    const Eigen::PlainObjectBase<Derivedq> & q,
+    const bool first) const
+{
+  assert(q.size() == DIM &&
+      "Query dimension should match aabb dimension");
+  assert(Ele.cols() == V.cols()+1 &&
+      "LinearAABB::find only makes sense for (d+1)-simplices");
+  std::vector<int> found;
+  if(size() > 0)
+  {
+    find_helper(V,Ele,0,q,first,found);
+  }
+  return found;
+}
+
+template <typename DerivedV, int DIM>
+template <typename Derivedq>
+IGL_INLINE void igl::LinearAABB<DerivedV,DIM>::find_helper(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::MatrixXi & Ele,
+    const int node,
+    const Eigen::PlainObjectBase<Derivedq> & q,
+    const bool first,
+    std::vector<int> & found) const
+{
+  const Scalar epsilon = igl::EPS<Scalar>();
+  const Node & n = (*m_nodes)[node];
+  for(int d = 0;d<DIM;d++)
+  {
+    if(q(d) < n.min[d] || q(d) > n.max[d])
+    {
+      return;
+    }
+  }
+  if(n.count == 0)
+  {
+    find_helper(V,Ele,node+1,q,first,found);
+    if(first && !found.empty())
+    {
+      return;
+    }
+    find_helper(V,Ele,n.offset,q,first,found);
+    return;
+  }
+  for(int k = 0;k<n.count;k++)
+  {
+    const int e = (*m_primitives)[n.offset+k];
+    // Initialize to some value > -epsilon
+    Scalar a1=0,a2=0,a3=0,a4=0;
+    switch(DIM)
+    {
+      case 3:
+        {
+          // Barycentric coordinates
+          typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+          const RowVector3S V1 = V.row(Ele(e,0));
+          const RowVector3S V2 = V.row(Ele(e,1));
+          const RowVector3S V3 = V.row(Ele(e,2));
+          const RowVector3S V4 = V.row(Ele(e,3));
+          a1 = volume_single(V2,V4,V3,(RowVector3S)q);
+          a2 = volume_single(V1,V3,V4,(RowVector3S)q);
+          a3 = volume_single(V1,V4,V2,(RowVector3S)q);
+          a4 = volume_single(V1,V2,V3,(RowVector3S)q);
+          break;
+        }
+      case 2:
+        {
+          // Barycentric coordinates
+          typedef Eigen::Matrix<Scalar,2,1> Vector2S;
+          const Vector2S V1 = V.row(Ele(e,0));
+          const Vector2S V2 = V.row(Ele(e,1));
+          const Vector2S V3 = V.row(Ele(e,2));
+          const Vector2S q2 = q.head(2);
+          a1 = doublearea_single(V1,V2,q2);
+          a2 = doublearea_single(V2,V3,q2);
+          a3 = doublearea_single(V3,V1,q2);
+          break;
+        }
+      default:assert(false);
+    }
+    // Normalization is important for correcting sign
+    Scalar sum = a1+a2+a3+a4;
+    a1 /= sum;
+    a2 /= sum;
+    a3 /= sum;
+    a4 /= sum;
+    if(
+        a1>=-epsilon &&
+        a2>=-epsilon &&
+        a3>=-epsilon &&
+        a4>=-epsilon)
+    {
+      found.push_back(e);
+      if(first)
+      {
+        return;
+      }
+    }
+  }
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE typename igl::LinearAABB<DerivedV,DIM>::Scalar
+igl::LinearAABB<DerivedV,DIM>::squared_distance(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::MatrixXi & Ele,
+  const RowVectorDIMS & p,
+  int & i,
+  RowVectorDIMS & c) const
+{
+  return squared_distance(V,Ele,p,std::numeric_limits<Scalar>::infinity(),i,c);
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE typename igl::LinearAABB<DerivedV,DIM>::Scalar
+igl::LinearAABB<DerivedV,DIM>::squared_distance(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::MatrixXi & Ele,
+  const RowVectorDIMS & p,
+  const Scalar min_sqr_d,
+  int & i,
+  RowVectorDIMS & c) const
+{
+  assert((Ele.cols() == 3 || Ele.cols() == 2 || Ele.cols() == 1)
+    && "Code has only been tested for simplex sizes 3,2,1");
+  Scalar sqr_d = min_sqr_d;
+  if(size() > 0)
+  {
+    squared_distance_helper(V,Ele,0,p,sqr_d,i,c);
+  }
+  return sqr_d;
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::LinearAABB<DerivedV,DIM>::squared_distance_helper(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::MatrixXi & Ele,
+  const int node,
+  const RowVectorDIMS & p,
+  Scalar & sqr_d,
+  int & i,
+  RowVectorDIMS & c) const
+{
+  const Node & n = (*m_nodes)[node];
+  if(n.count > 0)
+  {
+    for(int k = 0;k<n.count;k++)
+    {
+      const int e = (*m_primitives)[n.offset+k];
+      Scalar sqr_d_candidate;
+      RowVectorDIMS c_candidate;
+      igl::point_simplex_squared_distance<DIM>(
+        p,V,Ele,e,sqr_d_candidate,c_candidate);
+      if(sqr_d_candidate < sqr_d)
+      {
+        i = e;
+        c = c_candidate;
+        sqr_d = sqr_d_candidate;
+      }
+    }
+    return;
+  }
+  const auto & box_squared_distance = [&p](const Node & b)->Scalar
+  {
+    Scalar d2 = 0;
+    for(int d = 0;d<DIM;d++)
+    {
+      const Scalar lo = b.min[d];
+      const Scalar hi = b.max[d];
+      if(p(d) < lo)
+      {
+        d2 += (lo-p(d))*(lo-p(d));
+      }else if(p(d) > hi)
+      {
+        d2 += (p(d)-hi)*(p(d)-hi);
+      }
+    }
+    return d2;
+  };
+  const int left = node+1;
+  const int right = n.offset;
+  const Scalar left_min_sqr_d = box_squared_distance((*m_nodes)[left]);
+  const Scalar right_min_sqr_d = box_squared_distance((*m_nodes)[right]);
+  // Look at closer child first so that the other is more likely culled
+  if(left_min_sqr_d <= right_min_sqr_d)
+  {
+    if(left_min_sqr_d < sqr_d)
+    {
+      squared_distance_helper(V,Ele,left,p,sqr_d,i,c);
+    }
+    if(right_min_sqr_d < sqr_d)
+    {
+      squared_distance_helper(V,Ele,right,p,sqr_d,i,c);
+    }
+  }else
+  {
+    if(right_min_sqr_d < sqr_d)
+    {
+      squared_distance_helper(V,Ele,right,p,sqr_d,i,c);
+    }
+    if(left_min_sqr_d < sqr_d)
+    {
+      squared_distance_helper(V,Ele,left,p,sqr_d,i,c);
+    }
+  }
+}
+
+template <typename DerivedV, int DIM>
+template <
+  typename DerivedP,
+  typename DerivedsqrD,
+  typename DerivedI,
+  typename DerivedC>
+IGL_INLINE void igl::LinearAABB<DerivedV,DIM>::squared_distance(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::MatrixXi & Ele,
+  const Eigen::PlainObjectBase<DerivedP> & P,
+  Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedC> & C) const
+{
+  assert(P.cols() == V.cols() && "cols in P should match dim of cols in V");
+  const int np = P.rows();
+  sqrD.resize(np,1);
+  I.resize(np,1);
+  C.resizeLike(P);
+  // Same scheme as AABB::squared_distance: Morton-ordered runs in parallel,
+  // each query seeded by its predecessor's closest primitive
+  Eigen::VectorXi order;
+  morton_order(P,order);
+  const int run = 256;
+  const int num_runs = (np+run-1)/run;
+  parallel_for(num_runs,[&](const int r)
+  {
+    int prev = -1;
+    for(int k = r*run;k<std::min(np,(r+1)*run);k++)
+    {
+      const int p = order(k);
+      RowVectorDIMS Pp = P.row(p), c;
+      Scalar sqr_d = std::numeric_limits<Scalar>::infinity();
+      int Ip = -1;
+      if(prev >= 0)
+      {
+        igl::point_simplex_squared_distance<DIM>(Pp,V,Ele,prev,sqr_d,c);
+        Ip = prev;
+      }
+      sqrD(p) = squared_distance(V,Ele,Pp,sqr_d,Ip,c);
+      I(p) = Ip;
+      C.row(p).head(DIM) = c;
+      prev = Ip;
+    }
+  },2);
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE bool igl::LinearAABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::MatrixXi & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  std::vector<igl::Hit> & hits) const
+{
+  hits.clear();
+  if(size() > 0)
+  {
+    intersect_ray_helper(V,Ele,0,origin,dir,hits);
+  }
+  return !hits.empty();
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::LinearAABB<DerivedV,DIM>::intersect_ray_helper(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::MatrixXi & Ele,
+  const int node,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  std::vector<igl::Hit> & hits) const
+{
+  const Scalar t0 = 0;
+  const Scalar t1 = std::numeric_limits<Scalar>::infinity();
+  {
+    Scalar _1,_2;
+    if(!ray_box_intersect(origin,dir,box(node),t0,t1,_1,_2))
+    {
+      return;
+    }
+  }
+  const Node & n = (*m_nodes)[node];
+  if(n.count == 0)
+  {
+    intersect_ray_helper(V,Ele,node+1,origin,dir,hits);
+    intersect_ray_helper(V,Ele,n.offset,origin,dir,hits);
+    return;
+  }
+  assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+  for(int k = 0;k<n.count;k++)
+  {
+    const int e = (*m_primitives)[n.offset+k];
+    std::vector<igl::Hit> leaf_hits;
+    ray_mesh_intersect(origin,dir,V,Ele.row(e),leaf_hits);
+    for(auto & hit : leaf_hits)
+    {
+      hit.id = e;
+      hits.push_back(hit);
+    }
+  }
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE bool igl::LinearAABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::MatrixXi & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  igl::Hit & hit) const
+{
+  Scalar min_t = std::numeric_limits<Scalar>::infinity();
+  return size() > 0 && intersect_ray_helper(V,Ele,0,origin,dir,min_t,hit);
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE bool igl::LinearAABB<DerivedV,DIM>::intersect_ray_helper(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::MatrixXi & Ele,
+  const int node,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  Scalar & min_t,
+  igl::Hit & hit) const
+{
+  const Node & n = (*m_nodes)[node];
+  if(n.count > 0)
+  {
+    assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+    bool ret = false;
+    for(int k = 0;k<n.count;k++)
+    {
+      const int e = (*m_primitives)[n.offset+k];
+      igl::Hit leaf_hit;
+      if(ray_mesh_intersect(origin,dir,V,Ele.row(e),leaf_hit) &&
+        leaf_hit.t < min_t)
+      {
+        leaf_hit.id = e;
+        hit = leaf_hit;
+        min_t = leaf_hit.t;
+        ret = true;
+      }
+    }
+    return ret;
+  }
+  // Visit the child whose box the ray enters first
+  const Scalar t0 = 0;
+  const int left = node+1;
+  const int right = n.offset;
+  Scalar left_t,right_t,_;
+  const bool left_hit = ray_box_intersect(origin,dir,box(left),t0,min_t,left_t,_);
+  const bool right_hit = ray_box_intersect(origin,dir,box(right),t0,min_t,right_t,_);
+  bool ret = false;
+  if(left_hit && right_hit && right_t < left_t)
+  {
+    ret = intersect_ray_helper(V,Ele,right,origin,dir,min_t,hit) || ret;
+    if(left_t < min_t)
+    {
+      ret = intersect_ray_helper(V,Ele,left,origin,dir,min_t,hit) || ret;
+    }
+    return ret;
+  }
+  if(left_hit)
+  {
+    ret = intersect_ray_helper(V,Ele,left,origin,dir,min_t,hit) || ret;
+  }
+  if(right_hit && right_t < min_t)
+  {
+    ret = intersect_ray_helper(V,Ele,right,origin,dir,min_t,hit) || ret;
+  }
+  return ret;
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template class igl::LinearAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>;
+template void igl::LinearAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::init(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, int);
+template void igl::LinearAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::init(igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2> const&);
+template double igl::LinearAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_distance(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, Eigen::Matrix<double, 1, 2, 1, 1, 2> const&, int&, Eigen::Matrix<double, 1, 2, 1, 1, 2>&) const;
+template void igl::LinearAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
+template void igl::LinearAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
+template std::vector<int, std::allocator<int> > igl::LinearAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::find<Eigen::Matrix<double, 1, -1, 1, 1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, -1, 1, 1, -1> > const&, bool) const;
+template std::vector<int, std::allocator<int> > igl::LinearAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::find<Eigen::Matrix<double, 1, -1, 1, 1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, -1, 0, -1, -1> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, -1, 1, 1, -1> > const&, bool) const;
+#endif
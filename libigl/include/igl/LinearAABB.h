@@ -0,0 +1,200 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2015 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_LINEARAABB_H
+#define IGL_LINEARAABB_H
+
+#include "AABB.h"
+#include "Hit.h"
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <memory>
+#include <vector>
+namespace igl
+{
+  // Flattened ("linear") axis-aligned bounding box hierarchy. Answers the same
+  // queries as igl::AABB but stores the tree in two contiguous arrays:
+  //
+  //   nodes  depth-first list of nodes. The left child of an internal node i is
+  //     always node i+1, only the index of the right child is stored.
+  //   primitives  element indices into Ele referenced by the leaves, each leaf
+  //     owning a contiguous range
+  //
+  // Boxes are stored in single precision, rounded outward so that they always
+  // contain the double precision boxes (queries stay exact). In 3D a node is
+  // 32 bytes so that two fit in a cache line.
+  //
+  // The arrays are immutable once built and shared between copies, so copying
+  // a LinearAABB is O(1).
+  //
+  // As with igl::AABB the mesh (V,Ele) is stored and managed by the caller and
+  // each routine here simply takes it as references (it better not change
+  // between calls).
+  template <typename DerivedV, int DIM>
+    class LinearAABB
+    {
+public:
+      typedef typename DerivedV::Scalar Scalar;
+      typedef Eigen::Matrix<Scalar,1,DIM> RowVectorDIMS;
+      typedef Eigen::Matrix<Scalar,DIM,1> VectorDIMS;
+      typedef Eigen::Matrix<Scalar,Eigen::Dynamic,DIM> MatrixXDIMS;
+      struct Node
+      {
+        // Conservative bounding box
+        float min[DIM];
+        float max[DIM];
+        // Internal node: index of right child. Leaf: index of first primitive
+        // in primitives()
+        int offset;
+        // Leaf: number of primitives (>0). Internal node: 0
+        int count;
+      };
+      LinearAABB():m_nodes(),m_primitives(){}
+      // Build a hierarchy for a given mesh by recursively splitting elements
+      // at the median of their barycenters along the longest axis.
+      //
+      // Inputs:
+      //   V  #V by dim list of mesh vertex positions.
+      //   Ele  #Ele by dim+1 list of mesh indices into #V.
+      //   leaf_size  maximum number of elements stored in a leaf {1}
+      IGL_INLINE void init(
+          const Eigen::PlainObjectBase<DerivedV> & V,
+          const Eigen::MatrixXi & Ele,
+          const int leaf_size = 1);
+      // Flatten an existing pointer-based hierarchy (one primitive per leaf).
+      //
+      // Inputs:
+      //   tree  hierarchy built with tree.init(V,Ele)
+      IGL_INLINE void init(const AABB<DerivedV,DIM> & tree);
+      IGL_INLINE void deinit();
+      // Returns number of nodes (0 if empty)
+      IGL_INLINE int size() const;
+      // Returns whether node i is a leaf
+      IGL_INLINE bool is_leaf(const int i) const;
+      // Returns (double precision copy of) box of node i
+      IGL_INLINE Eigen::AlignedBox<Scalar,DIM> box(const int i) const;
+      IGL_INLINE const std::vector<Node> & nodes() const;
+      IGL_INLINE const std::vector<int> & primitives() const;
+      // Find the indices of elements containing given point: this makes sense
+      // when Ele is a co-dimension 0 simplex (tets in 3D, triangles in 2D).
+      //
+      // See AABB::find
+      template <typename Derivedq>
+      IGL_INLINE std::vector<int> find(
+          const Eigen::PlainObjectBase<DerivedV> & V,
+          const Eigen::MatrixXi & Ele,
+          const Eigen::PlainObjectBase<Derivedq> & q,
+          const bool first=false) const;
+      // Compute squared distance to a query point
+      //
+      // Inputs:
+      //   V  #V by dim list of vertex positions
+      //   Ele  #Ele by dim list of simplex indices
+      //   p  dim-long query point
+      // Outputs:
+      //   i  facet index corresponding to smallest distances
+      //   c  closest point
+      // Returns squared distance
+      IGL_INLINE Scalar squared_distance(
+        const Eigen::PlainObjectBase<DerivedV> & V,
+        const Eigen::MatrixXi & Ele,
+        const RowVectorDIMS & p,
+        int & i,
+        RowVectorDIMS & c) const;
+      // Inputs:
+      //   min_sqr_d  only consider distances less than this
+      // Outputs:
+      //   i  facet index corresponding to smallest distances (untouched if
+      //     nothing closer than min_sqr_d)
+      //   c  closest point (untouched if nothing closer than min_sqr_d)
+      // Returns squared distance
+      IGL_INLINE Scalar squared_distance(
+        const Eigen::PlainObjectBase<DerivedV> & V,
+        const Eigen::MatrixXi & Ele,
+        const RowVectorDIMS & p,
+        const Scalar min_sqr_d,
+        int & i,
+        RowVectorDIMS & c) const;
+      // Compute the squared distance from all query points in P to the
+      // _closest_ points on the primitives stored in the hierarchy.
+      //
+      // See AABB::squared_distance
+      template <
+        typename DerivedP,
+        typename DerivedsqrD,
+        typename DerivedI,
+        typename DerivedC>
+      IGL_INLINE void squared_distance(
+        const Eigen::PlainObjectBase<DerivedV> & V,
+        const Eigen::MatrixXi & Ele,
+        const Eigen::PlainObjectBase<DerivedP> & P,
+        Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
+        Eigen::PlainObjectBase<DerivedI> & I,
+        Eigen::PlainObjectBase<DerivedC> & C) const;
+      // All hits
+      IGL_INLINE bool intersect_ray(
+        const Eigen::PlainObjectBase<DerivedV> & V,
+        const Eigen::MatrixXi & Ele,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        std::vector<igl::Hit> & hits) const;
+      // First hit
+      IGL_INLINE bool intersect_ray(
+        const Eigen::PlainObjectBase<DerivedV> & V,
+        const Eigen::MatrixXi & Ele,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        igl::Hit & hit) const;
+private:
+      // Recursive helpers taking node index
+      IGL_INLINE void squared_distance_helper(
+        const Eigen::PlainObjectBase<DerivedV> & V,
+        const Eigen::MatrixXi & Ele,
+        const int node,
+        const RowVectorDIMS & p,
+        Scalar & sqr_d,
+        int & i,
+        RowVectorDIMS & c) const;
+      IGL_INLINE void intersect_ray_helper(
+        const Eigen::PlainObjectBase<DerivedV> & V,
+        const Eigen::MatrixXi & Ele,
+        const int node,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        std::vector<igl::Hit> & hits) const;
+      IGL_INLINE bool intersect_ray_helper(
+        const Eigen::PlainObjectBase<DerivedV> & V,
+        const Eigen::MatrixXi & Ele,
+        const int node,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        Scalar & min_t,
+        igl::Hit & hit) const;
+      template <typename Derivedq>
+      IGL_INLINE void find_helper(
+        const Eigen::PlainObjectBase<DerivedV> & V,
+        const Eigen::MatrixXi & Ele,
+        const int node,
+        const Eigen::PlainObjectBase<Derivedq> & q,
+        const bool first,
+        std::vector<int> & found) const;
+      // Set node's box to (rounded out) box
+      IGL_INLINE static void set_box(
+        const Eigen::AlignedBox<Scalar,DIM> & box,
+        Node & node);
+      std::shared_ptr<const std::vector<Node> > m_nodes;
+      std::shared_ptr<const std::vector<int> > m_primitives;
+    };
+}
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "LinearAABB.cpp"
+#endif
+
+#endif
@@ -0,0 +1,163 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "MassmatrixAssembler.h"
+#include "parallel_for.h"
+#include "sparse_assembly.h"
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+template <typename DerivedF>
+IGL_INLINE void igl::MassmatrixAssembler::init(
+  const int n,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const MassMatrixType type)
+{
+  assert((F.cols() == 3 || F.cols() == 4) && "F should contain triangles or tets");
+  m_F = F.template cast<int>();
+  // Same defaults as massmatrix
+  m_type = type;
+  if(type == MASSMATRIX_TYPE_DEFAULT)
+  {
+    m_type =
+      F.cols() == 3 ? MASSMATRIX_TYPE_VORONOI : MASSMATRIX_TYPE_BARYCENTRIC;
+  }
+  assert(m_type != MASSMATRIX_TYPE_FULL && "Full mass matrix not supported");
+  assert(
+    (F.cols() == 3 || m_type == MASSMATRIX_TYPE_BARYCENTRIC) &&
+    "Only barycentric mass matrix supported for tets");
+  const int m = m_F.rows();
+  m_MV.resize(m*m_F.cols());
+  // Same (diagonal) triplets as massmatrix
+  const auto ij = [&](const int t,int & i,int & j)
+  {
+    i = j = m_F(t%m,t/m);
+  };
+  sparse_assembly_pattern(n,n,m*m_F.cols(),ij,m_pattern,m_slots,m_order);
+}
+
+template <typename DerivedV>
+IGL_INLINE void igl::MassmatrixAssembler::update(
+  const Eigen::MatrixBase<DerivedV> & V,
+  Eigen::SparseMatrix<double> & M)
+{
+  using namespace std;
+  assert(V.rows() == m_pattern.rows() && "V should have n rows");
+  const int m = m_F.rows();
+  // Same computations as massmatrix, one element at a time
+  if(m_F.cols() == 3)
+  {
+    const bool voronoi = m_type == MASSMATRIX_TYPE_VORONOI;
+    parallel_for(m,[&](const int i)
+    {
+      // edge lengths numbered same as opposite vertices
+      const double l[3] = {
+        (V.row(m_F(i,1))-V.row(m_F(i,2))).norm(),
+        (V.row(m_F(i,2))-V.row(m_F(i,0))).norm(),
+        (V.row(m_F(i,0))-V.row(m_F(i,1))).norm()};
+      // Kahan's Heron's formula (see doublearea.h)
+      double s[3] = {l[0],l[1],l[2]};
+      std::sort(s,s+3,std::greater<double>());
+      const double arg =
+        (s[0]+(s[1]+s[2]))*
+        (s[2]-(s[0]-s[1]))*
+        (s[2]+(s[0]-s[1]))*
+        (s[0]+(s[1]-s[2]));
+      double dblA = 2.0*0.25*sqrt(arg);
+      if(dblA != dblA)
+      {
+        dblA = 0;
+      }
+      if(!voronoi)
+      {
+        for(int c = 0;c<3;c++)
+        {
+          m_MV(c*m+i) = dblA/6.0;
+        }
+        return;
+      }
+      // http://www.alecjacobson.com/weblog/?p=874
+      const double cosines[3] = {
+        (l[2]*l[2]+l[1]*l[1]-l[0]*l[0])/(l[1]*l[2]*2.0),
+        (l[0]*l[0]+l[2]*l[2]-l[1]*l[1])/(l[2]*l[0]*2.0),
+        (l[1]*l[1]+l[0]*l[0]-l[2]*l[2])/(l[0]*l[1]*2.0)};
+      double barycentric[3];
+      for(int c = 0;c<3;c++)
+      {
+        barycentric[c] = cosines[c]*l[c];
+      }
+      const double sum = barycentric[0]+(barycentric[1]+barycentric[2]);
+      double partial[3];
+      for(int c = 0;c<3;c++)
+      {
+        partial[c] = barycentric[c]/sum*(dblA*0.5);
+      }
+      double quads[3];
+      for(int c = 0;c<3;c++)
+      {
+        quads[c] = (partial[(c+1)%3]+partial[(c+2)%3])*0.5;
+      }
+      for(int o = 0;o<3;o++)
+      {
+        if(cosines[o]<0)
+        {
+          for(int c = 0;c<3;c++)
+          {
+            quads[c] = (c == o ? 0.25 : 0.125)*dblA;
+          }
+        }
+      }
+      for(int c = 0;c<3;c++)
+      {
+        m_MV(c*m+i) = quads[c];
+      }
+    },1000);
+  }else
+  {
+    parallel_for(m,[&](const int i)
+    {
+      // http://en.wikipedia.org/wiki/Tetrahedron#Volume
+      Eigen::Matrix<double,3,1> v0m3,v1m3,v2m3;
+      v0m3.head(V.cols()) = V.row(m_F(i,0)) - V.row(m_F(i,3));
+      v1m3.head(V.cols()) = V.row(m_F(i,1)) - V.row(m_F(i,3));
+      v2m3.head(V.cols()) = V.row(m_F(i,2)) - V.row(m_F(i,3));
+      const double v = fabs(v0m3.dot(v1m3.cross(v2m3)))/6.0;
+      for(int c = 0;c<4;c++)
+      {
+        m_MV(c*m+i) = v/4.0;
+      }
+    },1000);
+  }
+  if(
+    M.rows() != m_pattern.rows() ||
+    M.cols() != m_pattern.cols() ||
+    M.nonZeros() != m_pattern.nonZeros() ||
+    !M.isCompressed() ||
+    !std::equal(
+      m_pattern.outerIndexPtr(),
+      m_pattern.outerIndexPtr()+m_pattern.cols()+1,
+      M.outerIndexPtr()) ||
+    !std::equal(
+      m_pattern.innerIndexPtr(),
+      m_pattern.innerIndexPtr()+m_pattern.nonZeros(),
+      M.innerIndexPtr()))
+  {
+    M = m_pattern;
+  }
+  sparse_assembly_values(
+    m_slots,m_order,[this](const int t){ return m_MV(t); },M);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::MassmatrixAssembler::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(int, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType);
+template void igl::MassmatrixAssembler::init<Eigen::Matrix<int, -1, 3, 0, -1, 3> >(int, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::MassMatrixType);
+template void igl::MassmatrixAssembler::update<Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::MassmatrixAssembler::update<Eigen::Matrix<double, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::SparseMatrix<double, 0, int>&);
+#endif
@@ -0,0 +1,79 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_MASSMATRIX_ASSEMBLER_H
+#define IGL_MASSMATRIX_ASSEMBLER_H
+#include "igl_inline.h"
+#include "massmatrix.h"
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+namespace igl
+{
+  // Assembler of the mass matrix (see massmatrix.h) of a mesh whose
+  // connectivity stays fixed while its vertices move. It is the counterpart
+  // of igl::CotmatrixAssembler: the sparsity pattern is computed once from F
+  // and each update only recomputes the per-corner masses and overwrites the
+  // values of M in place, without allocating memory.
+  //
+  // The result is bitwise identical to igl::massmatrix(V,F,type,M).
+  class MassmatrixAssembler
+  {
+    public:
+      MassmatrixAssembler(){}
+      template <typename DerivedF>
+      MassmatrixAssembler(
+        const int n,
+        const Eigen::MatrixBase<DerivedF> & F,
+        const MassMatrixType type)
+      {
+        init(n,F,type);
+      }
+      // Precompute the sparsity pattern of the mass matrix of a mesh
+      //
+      // Inputs:
+      //   n  number of vertices
+      //   F  #F by simplex_size list of mesh elements (triangles or
+      //     tetrahedra)
+      //   type  one of the following ints (see massmatrix.h):
+      //     MASSMATRIX_TYPE_BARYCENTRIC  barycentric
+      //     MASSMATRIX_TYPE_VORONOI voronoi-hybrid {default}
+      template <typename DerivedF>
+      IGL_INLINE void init(
+        const int n,
+        const Eigen::MatrixBase<DerivedF> & F,
+        const MassMatrixType type);
+      // Assemble the mass matrix for new vertex positions
+      //
+      // Inputs:
+      //   V  n by dim list of mesh vertex positions
+      //   M  n by n output of a previous update (its values are overwritten),
+      //     otherwise it is first set to the sparsity pattern
+      // Outputs:
+      //   M  n by n mass matrix
+      template <typename DerivedV>
+      IGL_INLINE void update(
+        const Eigen::MatrixBase<DerivedV> & V,
+        Eigen::SparseMatrix<double> & M);
+    private:
+      // #F by simplex_size list of mesh elements
+      Eigen::MatrixXi m_F;
+      // Effective mass matrix type
+      MassMatrixType m_type;
+      // Sparsity pattern and triplets of each entry (see sparse_assembly.h)
+      Eigen::SparseMatrix<double> m_pattern;
+      Eigen::VectorXi m_slots;
+      Eigen::VectorXi m_order;
+      // #F*simplex_size list of masses of element corners (the first #F for
+      // the first corner, and so on)
+      Eigen::VectorXd m_MV;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "MassmatrixAssembler.cpp"
+#endif
+#endif
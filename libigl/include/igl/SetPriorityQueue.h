@@ -0,0 +1,90 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SETPRIORITYQUEUE_H
+#define IGL_SETPRIORITYQUEUE_H
+#include <cassert>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace igl
+{
+  // Adapter giving a std::set<std::pair<double,int> > Q together with its
+  // list of iterators Qit (Qit[id] --> iterator of id in Q, or Q.end()) the
+  // same interface as igl::IndexedPriorityQueue. The adapter either owns its
+  // set or wraps a caller's (Q,Qit), which lets the std::set versions of
+  // decimate and collapse_edge (and their callbacks) run on top of the
+  // versions templated on the queue type.
+  //
+  // See also: IndexedPriorityQueue, decimate, collapse_edge
+  class SetPriorityQueue
+  {
+    public:
+      typedef std::pair<double,int> Entry;
+      typedef std::set<Entry> Set;
+      typedef std::vector<Set::iterator> Iterators;
+      inline SetPriorityQueue():
+        m_own_Q(),m_own_Qit(),m_Q(&m_own_Q),m_Qit(&m_own_Qit){}
+      // Wrap an existing (Q,Qit)
+      inline SetPriorityQueue(Set & Q, Iterators & Qit):
+        m_own_Q(),m_own_Qit(),m_Q(&Q),m_Qit(&Qit){}
+      SetPriorityQueue(const SetPriorityQueue &) = delete;
+      SetPriorityQueue & operator=(const SetPriorityQueue &) = delete;
+      // Clear the queue and prepare for ids in [0,n)
+      inline void resize(const int n)
+      {
+        m_Q->clear();
+        m_Qit->assign(n,m_Q->end());
+      }
+      inline int size() const { return m_Q->size(); }
+      inline bool empty() const { return m_Q->empty(); }
+      inline bool contains(const int id) const
+      {
+        return (*m_Qit)[id] != m_Q->end();
+      }
+      inline double cost(const int id) const
+      {
+        assert(contains(id));
+        return (*m_Qit)[id]->first;
+      }
+      inline const Entry & top() const
+      {
+        assert(!empty());
+        return *m_Q->begin();
+      }
+      inline void pop()
+      {
+        assert(!empty());
+        (*m_Qit)[m_Q->begin()->second] = m_Q->end();
+        m_Q->erase(m_Q->begin());
+      }
+      inline void update(const int id, const double cost)
+      {
+        erase(id);
+        (*m_Qit)[id] = m_Q->insert(Entry(cost,id)).first;
+      }
+      inline void erase(const int id)
+      {
+        if(contains(id))
+        {
+          m_Q->erase((*m_Qit)[id]);
+          (*m_Qit)[id] = m_Q->end();
+        }
+      }
+      // Underlying set and iterators (as passed to std::set callbacks)
+      inline const Set & set() const { return *m_Q; }
+      inline const Iterators & iterators() const { return *m_Qit; }
+    private:
+      Set m_own_Q;
+      Iterators m_own_Qit;
+      Set * m_Q;
+      Iterators * m_Qit;
+  };
+}
+
+#endif
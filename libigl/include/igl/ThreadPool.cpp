@@ -0,0 +1,256 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+IGL_INLINE igl::ThreadPool & igl::ThreadPool::instance()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+IGL_INLINE igl::ThreadPool::ThreadPool():
+  m_workers(),
+  m_jobs(),
+  m_mutex(),
+  m_cv(),
+  m_stop(false),
+  m_started(false),
+  m_num_threads(0),
+  m_grain_size(0)
+{
+  set_num_threads(0);
+}
+
+IGL_INLINE igl::ThreadPool::~ThreadPool()
+{
+  stop_workers();
+}
+
+IGL_INLINE size_t igl::ThreadPool::num_threads() const
+{
+  return m_num_threads;
+}
+
+IGL_INLINE void igl::ThreadPool::set_num_threads(const size_t n)
+{
+  size_t nthreads = n;
+  if(nthreads == 0)
+  {
+    // http://ideone.com/Z7zldb
+    const char * env = std::getenv("IGL_NUM_THREADS");
+    const int env_n = env ? std::atoi(env) : 0;
+    if(env_n > 0)
+    {
+      nthreads = env_n;
+    }else
+    {
+      const size_t sthc = std::thread::hardware_concurrency();
+      nthreads = sthc==0?8:sthc;
+    }
+  }
+  if(nthreads == m_num_threads)
+  {
+    return;
+  }
+  // Workers are respawned lazily by the next loop
+  stop_workers();
+  m_num_threads = nthreads;
+}
+
+IGL_INLINE size_t igl::ThreadPool::grain_size() const
+{
+  return m_grain_size;
+}
+
+IGL_INLINE void igl::ThreadPool::set_grain_size(const size_t g)
+{
+  m_grain_size = g;
+}
+
+IGL_INLINE void igl::ThreadPool::start_workers()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(m_started)
+  {
+    return;
+  }
+  m_stop = false;
+  m_workers.reserve(m_num_threads-1);
+  for(size_t w = 0;w+1<m_num_threads;w++)
+  {
+    m_workers.emplace_back(&ThreadPool::worker_loop,this);
+  }
+  m_started = true;
+}
+
+IGL_INLINE void igl::ThreadPool::stop_workers()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(!m_started)
+    {
+      return;
+    }
+    assert(m_jobs.empty() && "Cannot resize pool while loops are running");
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for(std::thread & t : m_workers) if(t.joinable()) t.join();
+  m_workers.clear();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_started = false;
+}
+
+IGL_INLINE void igl::ThreadPool::worker_loop()
+{
+  for(;;)
+  {
+    std::shared_ptr<Job> job;
+    size_t slot;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock,[this]{ return m_stop || !m_jobs.empty(); });
+      if(m_stop)
+      {
+        return;
+      }
+      job = m_jobs.front();
+      slot = job->next_slot++;
+      // Once the last slot is taken nobody else may join
+      if(slot+1 >= job->nslots)
+      {
+        m_jobs.pop_front();
+      }
+      // Registered under the lock so the caller cannot miss us
+      job->active++;
+    }
+    participate(*job,slot);
+    if(--job->active == 0)
+    {
+      std::lock_guard<std::mutex> lock(job->done_mutex);
+      job->done_cv.notify_all();
+    }
+  }
+}
+
+IGL_INLINE void igl::ThreadPool::participate(Job & job, const size_t slot)
+{
+  Slice & own = job.slices[slot];
+  for(;;)
+  {
+    long long b = 0, e = 0;
+    {
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if(own.begin < own.end)
+      {
+        b = own.begin;
+        e = std::min(own.begin+job.grain,own.end);
+        own.begin = e;
+      }
+    }
+    if(b < e)
+    {
+      (*job.chunk)(b,e,slot);
+      if(job.remaining.fetch_sub(e-b) == e-b)
+      {
+        std::lock_guard<std::mutex> lock(job.done_mutex);
+        job.done_cv.notify_all();
+      }
+      continue;
+    }
+    // Own slice is empty: steal the back half of the largest other slice
+    size_t victim = job.nslots;
+    long long most = 0;
+    for(size_t s = 0;s<job.nslots;s++)
+    {
+      if(s == slot) continue;
+      std::lock_guard<std::mutex> lock(job.slices[s].mutex);
+      const long long left = job.slices[s].end - job.slices[s].begin;
+      if(left > most)
+      {
+        most = left;
+        victim = s;
+      }
+    }
+    if(victim == job.nslots)
+    {
+      return;
+    }
+    {
+      Slice & other = job.slices[victim];
+      std::lock_guard<std::mutex> lock(other.mutex);
+      const long long left = other.end - other.begin;
+      if(left <= 0)
+      {
+        // Emptied since we looked, try again
+        continue;
+      }
+      const long long mid = left <= job.grain ? other.begin : other.begin + left/2;
+      b = mid;
+      e = other.end;
+      other.end = mid;
+    }
+    std::lock_guard<std::mutex> lock(own.mutex);
+    own.begin = b;
+    own.end = e;
+  }
+}
+
+IGL_INLINE void igl::ThreadPool::run(
+  const long long loop_size,
+  const ChunkFunction & chunk)
+{
+  assert(loop_size >= 0);
+  if(loop_size == 0)
+  {
+    return;
+  }
+  const size_t nslots = m_num_threads;
+  if(nslots <= 1)
+  {
+    chunk(0,loop_size,0);
+    return;
+  }
+  start_workers();
+  std::shared_ptr<Job> job = std::make_shared<Job>();
+  job->chunk = &chunk;
+  job->nslots = nslots;
+  job->slices.reset(new Slice[nslots]);
+  job->next_slot = 1;
+  job->remaining = loop_size;
+  job->active = 0;
+  const long long slice_size = (loop_size + nslots - 1)/nslots;
+  for(size_t s = 0;s<nslots;s++)
+  {
+    job->slices[s].begin = std::min(loop_size,(long long)s*slice_size);
+    job->slices[s].end = std::min(loop_size,(long long)(s+1)*slice_size);
+  }
+  const size_t g = m_grain_size;
+  job->grain = g>0 ? (long long)g : std::max(slice_size/8,1ll);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.push_back(job);
+  }
+  m_cv.notify_all();
+  participate(*job,0);
+  {
+    // Late workers must not join a finished loop
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = std::find(m_jobs.begin(),m_jobs.end(),job);
+    if(it != m_jobs.end())
+    {
+      m_jobs.erase(it);
+    }
+  }
+  std::unique_lock<std::mutex> lock(job->done_mutex);
+  job->done_cv.wait(lock,[&job]
+    { return job->remaining == 0 && job->active == 0; });
+}
@@ -0,0 +1,112 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_THREADPOOL_H
+#define IGL_THREADPOOL_H
+#include "igl_inline.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace igl
+{
+  // Process-wide pool of persistent worker threads backing igl::parallel_for.
+  // Workers are spawned once (on first use) and sleep between loops, so
+  // calling parallel_for in a tight loop does not pay thread creation costs.
+  //
+  // Each loop is split into one contiguous slice per thread "slot". A thread
+  // consumes its own slice from the front in chunks of `grain_size()`
+  // iterations; once it runs dry it steals the back half of the largest
+  // remaining slice (work-stealing with dynamic chunking). The calling thread
+  // always takes part in its own loop, so nested parallel_for calls make
+  // progress even if every worker is busy.
+  //
+  // Example:
+  //   // use 4 threads (including the caller) and chunks of 256 iterations
+  //   igl::ThreadPool::instance().set_num_threads(4);
+  //   igl::ThreadPool::instance().set_grain_size(256);
+  class ThreadPool
+  {
+    public:
+      // Kernel running iterations [begin,end) as thread slot t
+      typedef std::function<void(long long,long long,size_t)> ChunkFunction;
+      // Returns the process-wide pool
+      IGL_INLINE static ThreadPool & instance();
+      IGL_INLINE ~ThreadPool();
+      // Returns number of threads taking part in a loop (workers + caller)
+      IGL_INLINE size_t num_threads() const;
+      // Resize the pool. Must not be called while a loop is running.
+      //
+      // Inputs:
+      //   n  number of threads including the caller, 0 restores the default:
+      //     the IGL_NUM_THREADS environment variable if set, otherwise
+      //     std::thread::hardware_concurrency() (or 8 if that is unknown)
+      IGL_INLINE void set_num_threads(const size_t n);
+      // Returns number of iterations claimed at a time (0 means automatic)
+      IGL_INLINE size_t grain_size() const;
+      // Inputs:
+      //   g  number of iterations claimed at a time, 0 chooses so that each
+      //     slot's slice is consumed in about 8 chunks
+      IGL_INLINE void set_grain_size(const size_t g);
+      // Run chunk over [0,loop_size) on up to num_threads() threads and block
+      // until all iterations have finished.
+      //
+      // Inputs:
+      //   loop_size  number of iterations
+      //   chunk  kernel to run, the slot passed is in [0,num_threads())
+      IGL_INLINE void run(const long long loop_size, const ChunkFunction & chunk);
+    private:
+      struct Slice
+      {
+        std::mutex mutex;
+        long long begin, end;
+      };
+      struct Job
+      {
+        const ChunkFunction * chunk;
+        long long grain;
+        size_t nslots;
+        std::unique_ptr<Slice[]> slices;
+        // Next unclaimed slot (slot 0 belongs to the caller)
+        std::atomic<size_t> next_slot;
+        // Iterations not yet finished
+        std::atomic<long long> remaining;
+        // Workers currently inside this job
+        std::atomic<size_t> active;
+        std::mutex done_mutex;
+        std::condition_variable done_cv;
+      };
+      IGL_INLINE ThreadPool();
+      ThreadPool(const ThreadPool &) = delete;
+      ThreadPool & operator=(const ThreadPool &) = delete;
+      IGL_INLINE void start_workers();
+      IGL_INLINE void stop_workers();
+      IGL_INLINE void worker_loop();
+      // Work on job as slot until no slice has iterations left
+      IGL_INLINE static void participate(Job & job, const size_t slot);
+      std::vector<std::thread> m_workers;
+      std::deque<std::shared_ptr<Job> > m_jobs;
+      std::mutex m_mutex;
+      std::condition_variable m_cv;
+      bool m_stop;
+      bool m_started;
+      std::atomic<size_t> m_num_threads;
+      std::atomic<size_t> m_grain_size;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "ThreadPool.cpp"
+#endif
+
+#endif
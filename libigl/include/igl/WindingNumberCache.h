@@ -0,0 +1,115 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2014 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_WINDINGNUMBERCACHE_H
+#define IGL_WINDINGNUMBERCACHE_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace igl
+{
+  // Thread-safe, size-bounded cache of winding numbers of one node of a
+  // WindingNumberTree with respect to another node's boundary. One cache is
+  // shared by all nodes of a hierarchy and dies with it.
+  //
+  // Entries are spread over independently locked shards so that concurrent
+  // queries rarely contend. Each shard evicts its oldest entries once it holds
+  // more than capacity/#shards entries.
+  class WindingNumberCache
+  {
+    public:
+      typedef std::pair<const void *,const void *> Key;
+      // Inputs:
+      //   capacity  maximum number of cached values {2^20}
+      inline WindingNumberCache(const size_t capacity = (size_t(1)<<20)):
+        m_capacity_per_shard(std::max(capacity/NUM_SHARDS,size_t(1))),
+        m_hits(0),
+        m_misses(0)
+      {}
+      // Look up the value cached for key, or compute, store and return it.
+      // compute is called outside of any lock.
+      //
+      // Inputs:
+      //   key  pair of nodes (this,that)
+      //   compute  function computing value on a miss
+      // Returns cached or computed value
+      template <typename ComputeFunction>
+      inline double get(const Key & key, const ComputeFunction & compute)
+      {
+        Shard & shard = m_shards[shard_index(key)];
+        {
+          std::lock_guard<std::mutex> lock(shard.mutex);
+          const auto it = shard.values.find(key);
+          if(it != shard.values.end())
+          {
+            m_hits++;
+            return it->second;
+          }
+        }
+        m_misses++;
+        const double value = compute();
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if(shard.values.emplace(key,value).second)
+        {
+          shard.order.push_back(key);
+          while(shard.order.size() > m_capacity_per_shard)
+          {
+            shard.values.erase(shard.order.front());
+            shard.order.pop_front();
+          }
+        }
+        return value;
+      }
+      // Remove all entries (e.g., when nodes are deleted)
+      inline void clear()
+      {
+        for(Shard & shard : m_shards)
+        {
+          std::lock_guard<std::mutex> lock(shard.mutex);
+          shard.values.clear();
+          shard.order.clear();
+        }
+      }
+      // Returns number of lookups answered from the cache
+      inline size_t hits() const { return m_hits; }
+      // Returns number of lookups that had to be computed
+      inline size_t misses() const { return m_misses; }
+    private:
+      enum { NUM_SHARDS = 64 };
+      struct KeyHash
+      {
+        inline size_t operator()(const Key & key) const
+        {
+          const size_t a = std::hash<const void*>()(key.first);
+          const size_t b = std::hash<const void*>()(key.second);
+          return a ^ (b + 0x9e3779b97f4a7c15ull + (a<<6) + (a>>2));
+        }
+      };
+      struct Shard
+      {
+        std::mutex mutex;
+        std::unordered_map<Key,double,KeyHash> values;
+        // Insertion order for eviction
+        std::deque<Key> order;
+      };
+      inline static size_t shard_index(const Key & key)
+      {
+        return (KeyHash()(key) >> 4) % NUM_SHARDS;
+      }
+      const size_t m_capacity_per_shard;
+      std::atomic<size_t> m_hits;
+      std::atomic<size_t> m_misses;
+      Shard m_shards[NUM_SHARDS];
+  };
+}
+#endif
@@ -8,8 +8,10 @@
 #ifndef IGL_WINDINGNUMBERTREE_H
 #define IGL_WINDINGNUMBERTREE_H
 #include <list>
-#include <map>
+#include <memory>
+#include <vector>
 #include <Eigen/Dense>
+#include "WindingNumberCache.h"
 #include "WindingNumberMethod.h"
 
 namespace igl
@@ -24,13 +26,9 @@ namespace igl
   template <typename Point>
   class WindingNumberTree
   {
-    public:
+    protected:
       // Method to use (see enum above)
       //static double min_max_w;
-      static std::map< 
-        std::pair<const WindingNumberTree*,const WindingNumberTree*>, double>
-          cached;
-    protected:
       WindingNumberMethod method;
       const WindingNumberTree * parent;
       std::list<WindingNumberTree * > children;
@@ -48,6 +46,12 @@ namespace igl
       double radius;
       // (Approximate) center (of mass)
       Point center;
+      // Cache used by APPROX_CACHE_WINDING_NUMBER_METHOD, shared by all nodes
+      // of this hierarchy
+      std::shared_ptr<WindingNumberCache> cache;
+      // Corners of F packed for vectorized evaluation (see
+      // winding_number_soa.h), built on first call to winding_number_all
+      mutable std::shared_ptr<const std::vector<double> > soa;
     public:
       inline WindingNumberTree();
       // For root
@@ -65,6 +69,10 @@ namespace igl
         const Eigen::MatrixXi & F);
       // Set method
       inline void set_method( const WindingNumberMethod & m);
+      // Number of cache lookups answered from/missing in the cache of this
+      // hierarchy (APPROX_CACHE_WINDING_NUMBER_METHOD)
+      inline size_t cache_hits() const;
+      inline size_t cache_misses() const;
     public:
       inline const Eigen::MatrixXd & getV() const;
       inline const Eigen::MatrixXi & getF() const;
@@ -132,6 +140,7 @@ namespace igl
 #include "winding_number.h"
 #include "triangle_fan.h"
 #include "exterior_edges.h"
+#include "winding_number_soa.h"
 
 #include <igl/PI.h>
 #include <igl/remove_duplicate_vertices.h>
@@ -143,9 +152,6 @@ namespace igl
 //WindingNumberMethod WindingNumberTree<Point>::method = EXACT_WINDING_NUMBER_METHOD;
 //template <typename Point>
 //double WindingNumberTree<Point>::min_max_w = 0;
-template <typename Point>
-std::map< std::pair<const igl::WindingNumberTree<Point>*,const igl::WindingNumberTree<Point>*>, double>
-  igl::WindingNumberTree<Point>::cached;
 
 template <typename Point>
 inline igl::WindingNumberTree<Point>::WindingNumberTree():
@@ -157,7 +163,8 @@ inline igl::WindingNumberTree<Point>::WindingNumberTree():
   //boundary(igl::boundary_facets<Eigen::MatrixXi,Eigen::MatrixXi>(F))
   cap(),
   radius(std::numeric_limits<double>::infinity()),
-  center(0,0,0)
+  center(0,0,0),
+  cache(std::make_shared<WindingNumberCache>())
 {
 }
 
@@ -173,7 +180,8 @@ inline igl::WindingNumberTree<Point>::WindingNumberTree(
   //boundary(igl::boundary_facets<Eigen::MatrixXi,Eigen::MatrixXi>(F))
   cap(),
   radius(std::numeric_limits<double>::infinity()),
-  center(0,0,0)
+  center(0,0,0),
+  cache(std::make_shared<WindingNumberCache>())
 {
   set_mesh(_V,_F);
 }
@@ -191,6 +199,8 @@ inline void igl::WindingNumberTree<Point>::set_mesh(
   igl::remove_duplicate_vertices(_V,_F,0.0,SV,SVI,SVJ,F);
   triangle_fan(igl::exterior_edges(F),cap);
   V = SV;
+  cache->clear();
+  soa.reset();
 }
 
 template <typename Point>
@@ -202,7 +212,8 @@ inline igl::WindingNumberTree<Point>::WindingNumberTree(
   V(parent.V),
   SV(),
   F(_F),
-  cap(triangle_fan(igl::exterior_edges(_F)))
+  cap(triangle_fan(igl::exterior_edges(_F))),
+  cache(parent.cache)
 {
 }
 
@@ -216,6 +227,11 @@ template <typename Point>
 inline void igl::WindingNumberTree<Point>::delete_children()
 {
   using namespace std;
+  // Cached values are keyed by node addresses, which may be reused
+  if(!children.empty())
+  {
+    cache->clear();
+  }
   // Delete children
   typename list<WindingNumberTree<Point>* >::iterator cit = children.begin();
   while(cit != children.end())
@@ -237,6 +253,18 @@ inline void igl::WindingNumberTree<Point>::set_method(const WindingNumberMethod
   }
 }
 
+template <typename Point>
+inline size_t igl::WindingNumberTree<Point>::cache_hits() const
+{
+  return cache->hits();
+}
+
+template <typename Point>
+inline size_t igl::WindingNumberTree<Point>::cache_misses() const
+{
+  return cache->misses();
+}
+
 template <typename Point>
 inline const Eigen::MatrixXd & igl::WindingNumberTree<Point>::getV() const
 {
@@ -332,7 +360,10 @@ inline double igl::WindingNumberTree<Point>::winding_number(const Point & p) con
         }
         case APPROX_CACHE_WINDING_NUMBER_METHOD:
         {
-          return parent->cached_winding_number(*this,p);
+          // Root has no parent to cache against
+          return parent == NULL ?
+            winding_number_boundary(p) :
+            parent->cached_winding_number(*this,p);
         }
         default: assert(false);break;
       }
@@ -348,16 +379,16 @@ inline double igl::WindingNumberTree<Point>::winding_number(const Point & p) con
 template <typename Point>
 inline double igl::WindingNumberTree<Point>::winding_number_all(const Point & p) const
 {
-  double w = 0;
-  igl::winding_number_3(
-    V.data(),
-    V.rows(),
-    F.data(),
-    F.rows(),
-    p.data(),
-    1,
-    &w);
-  return w;
+  // Concurrent first calls may both pack; either result is fine
+  std::shared_ptr<const std::vector<double> > S = std::atomic_load(&soa);
+  if(!S)
+  {
+    const auto packed = std::make_shared<std::vector<double> >();
+    igl::winding_number_soa_precompute(V,F,*packed);
+    S = packed;
+    std::atomic_store(&soa,S);
+  }
+  return igl::winding_number_soa(*S,p.data());
 }
 
 template <typename Point>
@@ -463,15 +494,13 @@ inline double igl::WindingNumberTree<Point>::cached_winding_number(
 
   if(is_far)
   {
-    // Not implemented yet
-    pair<const WindingNumberTree*,const WindingNumberTree*> this_that(this,&that);
-    // Need to compute it for first time?
-    if(cached.count(this_that)==0)
-    {
-      cached[this_that] = 
-        that.winding_number_boundary(this->center);
-    }
-    return cached[this_that];
+    // Computed on first request, safe to call from concurrent queries
+    return cache->get(
+      WindingNumberCache::Key(this,&that),
+      [this,&that]()->double
+      {
+        return that.winding_number_boundary(this->center);
+      });
   }else if(children.size() == 0)
   {
     // not far and hierarchy ended too soon: can't use cache
@@ -19,8 +19,11 @@
 #include "repdiag.h"
 #include "columnize.h"
 #include "fit_rotations.h"
+#include "AndersonAcceleration.h"
+#include "parallel_for.h"
 #include <cassert>
 #include <iostream>
+#include <limits>
 
 template <
   typename DerivedV,
@@ -136,6 +139,19 @@ IGL_INLINE bool igl::arap_precomputation(
   repdiag(G_sum,data.dim,G_sum_dim);
   assert(G_sum_dim.cols() == data.CSM.rows());
   data.CSM = (G_sum_dim * data.CSM).eval();
+  if(data.parallel_local_step)
+  {
+    // CSM * U.replicate(dim,1) = sum of the dim column blocks of CSM times U
+    SparseMatrix<double> CSM_sum = data.CSM.middleCols(0,n);
+    for(int d = 1;d<data.dim;d++)
+    {
+      CSM_sum += data.CSM.middleCols(d*n,n);
+    }
+    data.CSM_row = CSM_sum;
+  }else
+  {
+    data.CSM_row.resize(0,0);
+  }
 
 
   arap_rhs(ref_V,ref_F,data.dim,eff_energy,data.K);
@@ -161,6 +177,7 @@ IGL_INLINE bool igl::arap_precomputation(
     data.vel = MatrixXd::Zero(n,data.dim);
   }
 
+  data.Q = Q;
   return min_quad_with_fixed_precompute(
     Q,b,SparseMatrix<double>(),true,data.solver_data);
 }
@@ -201,26 +218,66 @@ IGL_INLINE bool igl::arap_solve(
   {
     U0 = U_prev;
   }
-  while(iter < data.max_iter)
+  // doesn't change during the iterations
+  MatrixXd Dl;
+  if(data.with_dynamics)
   {
-    U_prev = U;
-    // enforce boundary conditions exactly
-    for(int bi = 0;bi<bc.rows();bi++)
-    {
-      U.row(data.b(bi)) = bc.row(bi);
-    }
+    assert(data.M.rows() == n &&
+      "No mass matrix. Call arap_precomputation if changing with_dynamics");
+    const double h = data.h;
+    assert(h != 0);
+    //Dl = 1./(h*h*h)*M*(-2.*V0 + Vm1) - fext;
+    // data.vel = (V0-Vm1)/h
+    // h*data.vel = (V0-Vm1)
+    // -h*data.vel = -V0+Vm1)
+    // -V0-h*data.vel = -2V0+Vm1
+    const double dw = (1./data.ym)*(h*h);
+    Dl = dw * (1./(h*h)*data.M*(-U0 - h*data.vel) - data.f_ext);
+  }
 
-    const auto & Udim = U.replicate(data.dim,1);
+  // Local step: fit rotations to U and collect the linear coefficients B of
+  // the global step
+  const auto local_step = [&](MatrixXd & B)
+  {
     assert(U.cols() == data.dim);
-    // As if U.col(2) was 0
-    MatrixXd S = data.CSM * Udim;
+    MatrixXd S;
+    if(data.parallel_local_step)
+    {
+      assert(data.CSM_row.rows() == data.CSM.rows() &&
+        "Call arap_precomputation if changing parallel_local_step");
+      typedef SparseMatrix<double,RowMajor>::InnerIterator RowIterator;
+      S.resize(data.CSM_row.rows(),data.dim);
+      parallel_for(S.rows(),[&](const int i)
+      {
+        double si[3] = {0,0,0};
+        for(RowIterator it(data.CSM_row,i);it;++it)
+        {
+          for(int c = 0;c<data.dim;c++)
+          {
+            si[c] += it.value()*U(it.col(),c);
+          }
+        }
+        for(int c = 0;c<data.dim;c++)
+        {
+          S(i,c) = si[c];
+        }
+      },1000);
+    }else
+    {
+      const auto & Udim = U.replicate(data.dim,1);
+      // As if U.col(2) was 0
+      S = data.CSM * Udim;
+    }
     // THIS NORMALIZATION IS IMPORTANT TO GET SINGLE PRECISION SVD CODE TO WORK
     // CORRECTLY.
     S /= S.array().abs().maxCoeff();
 
     const int Rdim = data.dim;
     MatrixXd R(Rdim,data.CSM.rows());
-    if(R.rows() == 2)
+    if(data.parallel_local_step)
+    {
+      fit_rotations_SIMD(S,R);
+    }else if(R.rows() == 2)
     {
       fit_rotations_planar(S,R);
     }else
@@ -256,34 +313,63 @@ IGL_INLINE bool igl::arap_solve(
       }
     }
 
-    MatrixXd Dl;
-    if(data.with_dynamics)
-    {
-      assert(data.M.rows() == n &&
-        "No mass matrix. Call arap_precomputation if changing with_dynamics");
-      const double h = data.h;
-      assert(h != 0);
-      //Dl = 1./(h*h*h)*M*(-2.*V0 + Vm1) - fext;
-      // data.vel = (V0-Vm1)/h
-      // h*data.vel = (V0-Vm1)
-      // -h*data.vel = -V0+Vm1)
-      // -V0-h*data.vel = -2V0+Vm1
-      const double dw = (1./data.ym)*(h*h);
-      Dl = dw * (1./(h*h)*data.M*(-U0 - h*data.vel) - data.f_ext);
-    }
-
     VectorXd Rcol;
     columnize(eff_R,num_rots,2,Rcol);
     VectorXd Bcol = -data.K * Rcol;
     assert(Bcol.size() == data.n*data.dim);
+    B = Map<MatrixXd>(Bcol.data(),n,data.dim);
+    if(data.with_dynamics)
+    {
+      B += Dl;
+    }
+  };
+  // Energy minimized by the global step (up to a constant), which after the
+  // local step is the ARAP energy of U
+  const auto energy = [&](const MatrixXd & B)->double
+  {
+    return (U.cwiseProduct(0.5*(data.Q*U) + B)).sum();
+  };
+
+  const bool accelerate = data.anderson_window > 0;
+  AndersonAcceleration aa;
+  // Result of the last global step
+  MatrixXd U_global;
+  double E_prev = std::numeric_limits<double>::infinity();
+  data.energies.resize(data.max_iter);
+  while(iter < data.max_iter)
+  {
+    U_prev = U;
+    // enforce boundary conditions exactly
+    for(int bi = 0;bi<bc.rows();bi++)
+    {
+      U.row(data.b(bi)) = bc.row(bi);
+    }
+    if(accelerate && iter == 0)
+    {
+      U_global = U;
+      aa.init(
+        data.anderson_window,Map<const VectorXd>(U_global.data(),U.size()));
+    }
+
+    MatrixXd B;
+    local_step(B);
+    double E = energy(B);
+    if(accelerate && iter > 0 && !(E < E_prev))
+    {
+      // Accelerated iterate did not decrease the energy: fall back to the
+      // result of the global step and continue the acceleration from there
+      U = U_global;
+      local_step(B);
+      E = energy(B);
+      aa.replace(Map<const VectorXd>(U_global.data(),U.size()));
+    }
+    data.energies(iter) = E;
+    E_prev = E;
+
     for(int c = 0;c<data.dim;c++)
     {
       VectorXd Uc,Bc,bcc,Beq;
-      Bc = Bcol.block(c*n,0,n,1);
-      if(data.with_dynamics)
-      {
-        Bc += Dl.col(c);
-      }
+      Bc = B.col(c);
       if(bc.size()>0)
       {
         bcc = bc.col(c);
@@ -295,8 +381,20 @@ IGL_INLINE bool igl::arap_solve(
       U.col(c) = Uc;
     }
 
+    if(accelerate)
+    {
+      U_global = U;
+      const VectorXd & x =
+        aa.compute(Map<const VectorXd>(U_global.data(),U.size()));
+      U = Map<const MatrixXd>(x.data(),n,data.dim);
+    }
     iter++;
   }
+  if(accelerate)
+  {
+    U = U_global;
+  }
+  data.iter = iter;
   if(data.with_dynamics)
   {
     // Keep track of velocity for next time
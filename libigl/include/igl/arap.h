@@ -33,6 +33,17 @@ namespace igl
     // solver_data  quadratic solver data
     // b  list of boundary indices into V
     // dim  dimension being used for solving
+    // anderson_window  number of previous iterates combined by Anderson
+    //   acceleration of the local/global iterations, 0 disables it {0}
+    // parallel_local_step  whether to gather the covariance matrices in
+    //   parallel and fit rotations in double precision with
+    //   fit_rotations_SIMD (need to call arap_precomputation after changing)
+    // CSM_row  row major covariance scatter matrix acting on U rather than on
+    //   U.replicate(dim,1), only used if parallel_local_step
+    // Q  quadratic coefficients of the global step
+    // iter  number of iterations performed by the last arap_solve
+    // energies  iter list of energies (up to a constant) at the start of each
+    //   iteration of the last arap_solve, after its local step
     int n;
     Eigen::VectorXi G;
     ARAPEnergyType energy;
@@ -46,6 +57,12 @@ namespace igl
     min_quad_with_fixed_data<double> solver_data;
     Eigen::VectorXi b;
     int dim;
+    int anderson_window;
+    bool parallel_local_step;
+    Eigen::SparseMatrix<double,Eigen::RowMajor> CSM_row;
+    Eigen::SparseMatrix<double> Q;
+    int iter;
+    Eigen::VectorXd energies;
       ARAPData():
         n(0),
         G(),
@@ -59,7 +76,13 @@ namespace igl
         CSM(),
         solver_data(),
         b(),
-        dim(-1) // force this to be set by _precomputation
+        dim(-1), // force this to be set by _precomputation
+        anderson_window(0),
+        parallel_local_step(false),
+        CSM_row(),
+        Q(),
+        iter(0),
+        energies()
     {
     };
   };
@@ -84,10 +107,18 @@ namespace igl
     const int dim,
     const Eigen::PlainObjectBase<Derivedb> & b,
     ARAPData & data);
+  // Run data.max_iter local/global iterations. If data.anderson_window > 0
+  // the iterations are accelerated with igl::AndersonAcceleration, falling
+  // back to the plain iteration whenever an accelerated iterate does not
+  // decrease the energy.
+  //
   // Inputs:
   //   bc  #b by dim list of boundary conditions
   //   data  struct containing necessary precomputation and parameters
   //   U  #V by dim initial guess
+  // Outputs:
+  //   data  iter and energies are set
+  //   U  #V by dim solution
   template <
     typename Derivedbc,
     typename DerivedU>
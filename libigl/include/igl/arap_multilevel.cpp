@@ -0,0 +1,219 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "arap_multilevel.h"
+#include "arap.h"
+#include "qslim.h"
+#include "point_mesh_squared_distance.h"
+#include "barycentric_coordinates.h"
+#include "slice.h"
+#include <cassert>
+#include <vector>
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename Derivedb>
+IGL_INLINE bool igl::arap_multilevel_precomputation(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::PlainObjectBase<DerivedF> & F,
+  const int dim,
+  const Eigen::PlainObjectBase<Derivedb> & b,
+  ARAPMultilevelData & data)
+{
+  using namespace std;
+  using namespace Eigen;
+  assert(F.cols() == 3 && "F should contain triangles");
+  assert(data.ratio > 0 && data.ratio < 1 && "ratio should be in (0,1)");
+  data.dim = dim;
+  data.V.assign(1,V.template cast<double>());
+  data.F.assign(1,F.template cast<int>());
+  data.b.assign(1,b.template cast<int>());
+  data.P.clear();
+  data.Pb.clear();
+  data.I.clear();
+  while((int)data.V.size() < data.max_levels)
+  {
+    const int l = data.V.size()-1;
+    const int m = data.ratio*data.F[l].rows();
+    if(m < data.min_faces)
+    {
+      break;
+    }
+    MatrixXd Vc;
+    MatrixXi Fc;
+    VectorXi J,Ic;
+    qslim(data.V[l],data.F[l],m,Vc,Fc,J,Ic);
+    if(Fc.rows() == 0 || Fc.rows() >= data.F[l].rows())
+    {
+      break;
+    }
+
+    // Prolongation: barycentric coordinates of the closest point on the
+    // coarse mesh of each fine vertex
+    const int nf = data.V[l].rows();
+    VectorXd sqrD;
+    VectorXi K;
+    MatrixXd C;
+    point_mesh_squared_distance(data.V[l],Vc,Fc,sqrD,K,C);
+    MatrixXd A(nf,Vc.cols()),B(nf,Vc.cols()),D(nf,Vc.cols()),L;
+    for(int i = 0;i<nf;i++)
+    {
+      A.row(i) = Vc.row(Fc(K(i),0));
+      B.row(i) = Vc.row(Fc(K(i),1));
+      D.row(i) = Vc.row(Fc(K(i),2));
+    }
+    barycentric_coordinates(C,A,B,D,L);
+    vector<Triplet<double> > PIJV;
+    PIJV.reserve(3*nf);
+    // closest coarse vertex of each fine vertex
+    VectorXi closest(nf);
+    for(int i = 0;i<nf;i++)
+    {
+      Eigen::RowVector3d li = L.row(i);
+      if(!li.allFinite())
+      {
+        // degenerate coarse triangle
+        li << 1,0,0;
+      }
+      int max_c;
+      li.maxCoeff(&max_c);
+      closest(i) = Fc(K(i),max_c);
+      for(int c = 0;c<3;c++)
+      {
+        if(li(c) != 0)
+        {
+          PIJV.emplace_back(i,Fc(K(i),c),li(c));
+        }
+      }
+    }
+    SparseMatrix<double> P(nf,Vc.rows());
+    P.setFromTriplets(PIJV.begin(),PIJV.end());
+
+    // Fixed vertices: closest coarse vertex of each fine fixed vertex
+    const VectorXi & bf = data.b[l];
+    VectorXi b_index = VectorXi::Constant(Vc.rows(),-1);
+    vector<int> bc_vec;
+    vector<Triplet<double> > PbIJV;
+    for(int j = 0;j<bf.size();j++)
+    {
+      const int v = closest(bf(j));
+      if(b_index(v) < 0)
+      {
+        b_index(v) = bc_vec.size();
+        bc_vec.push_back(v);
+      }
+      PbIJV.emplace_back(b_index(v),j,1.);
+    }
+    SparseMatrix<double> Pb(bc_vec.size(),bf.size());
+    Pb.setFromTriplets(PbIJV.begin(),PbIJV.end());
+    // average
+    const VectorXd count = Pb*VectorXd::Ones(bf.size());
+    Pb = (count.cwiseInverse().asDiagonal()*Pb).eval();
+    VectorXi bc(bc_vec.size());
+    for(int j = 0;j<bc.size();j++)
+    {
+      bc(j) = bc_vec[j];
+    }
+
+    data.V.push_back(Vc);
+    data.F.push_back(Fc);
+    data.b.push_back(bc);
+    data.P.push_back(P);
+    data.Pb.push_back(Pb);
+    data.I.push_back(Ic);
+  }
+
+  data.data.clear();
+  for(int l = 0;l<(int)data.V.size();l++)
+  {
+    std::shared_ptr<ARAPData> arap_data = std::make_shared<ARAPData>();
+    arap_data->energy = data.energy;
+    arap_data->max_iter = l == 0 ? data.max_iter : data.coarse_max_iter;
+    arap_data->anderson_window = data.anderson_window;
+    arap_data->parallel_local_step = data.parallel_local_step;
+    if(!arap_precomputation(data.V[l],data.F[l],dim,data.b[l],*arap_data))
+    {
+      return false;
+    }
+    data.data.push_back(arap_data);
+  }
+  return true;
+}
+
+template <
+  typename Derivedbc,
+  typename DerivedU>
+IGL_INLINE bool igl::arap_multilevel_solve(
+  const Eigen::PlainObjectBase<Derivedbc> & bc,
+  ARAPMultilevelData & data,
+  Eigen::PlainObjectBase<DerivedU> & U)
+{
+  using namespace std;
+  using namespace Eigen;
+  const int nl = data.V.size();
+  assert(nl > 0 && "Call arap_multilevel_precomputation first");
+  assert(data.b[0].size() == bc.rows());
+  // Transfer displacements if the solution lives in the space of V
+  const bool displacements = data.dim == data.V[0].cols();
+  // Boundary conditions and initial guesses of each level
+  vector<MatrixXd> bcl(nl),Ul(nl);
+  bcl[0] = bc.template cast<double>();
+  if(U.size() == 0)
+  {
+    Ul[0] = MatrixXd::Zero(data.V[0].rows(),data.dim);
+  }else
+  {
+    assert(U.cols() == data.dim && "U.cols() match data.dim");
+    Ul[0] = U.template cast<double>();
+  }
+  for(int l = 0;l+1<nl;l++)
+  {
+    MatrixXd Ul_I;
+    slice(Ul[l],data.I[l],1,Ul_I);
+    if(displacements)
+    {
+      MatrixXd Vf_b,Vc_b,Vf_I;
+      slice(data.V[l],data.b[l],1,Vf_b);
+      slice(data.V[l+1],data.b[l+1],1,Vc_b);
+      slice(data.V[l],data.I[l],1,Vf_I);
+      bcl[l+1] = Vc_b + data.Pb[l]*(bcl[l]-Vf_b);
+      Ul[l+1] = data.V[l+1] + (Ul_I-Vf_I);
+    }else
+    {
+      bcl[l+1] = data.Pb[l]*bcl[l];
+      Ul[l+1] = Ul_I;
+    }
+  }
+
+  // Coarse to fine
+  for(int l = nl-1;l>=0;l--)
+  {
+    if(l+1 < nl)
+    {
+      if(displacements)
+      {
+        Ul[l] = data.V[l] + data.P[l]*(Ul[l+1]-data.V[l+1]);
+      }else
+      {
+        Ul[l] = data.P[l]*Ul[l+1];
+      }
+    }
+    if(!arap_solve(bcl[l],*data.data[l],Ul[l]))
+    {
+      return false;
+    }
+  }
+  U = Ul[0].template cast<typename DerivedU::Scalar>();
+  return true;
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template bool igl::arap_multilevel_precomputation<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, igl::ARAPMultilevelData&);
+template bool igl::arap_multilevel_solve<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, igl::ARAPMultilevelData&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+#endif
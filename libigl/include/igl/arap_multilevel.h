@@ -0,0 +1,121 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_ARAP_MULTILEVEL_H
+#define IGL_ARAP_MULTILEVEL_H
+#include "igl_inline.h"
+#include "arap.h"
+#include "ARAPEnergyType.h"
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <memory>
+#include <vector>
+
+namespace igl
+{
+  struct ARAPMultilevelData
+  {
+    // Options (need to call arap_multilevel_precomputation after changing)
+    //
+    // max_levels  maximum number of levels, including the input mesh {4}
+    // ratio  ratio between the number of faces of a level and of the next
+    //   finer one {0.25}
+    // min_faces  levels are not coarsened below this number of faces {1000}
+    // energy  type of energy to use
+    // max_iter  iterations on the input mesh {10}
+    // coarse_max_iter  iterations on each coarser level {20}
+    // anderson_window  see ARAPData {0}
+    // parallel_local_step  see ARAPData {false}
+    int max_levels;
+    double ratio;
+    int min_faces;
+    ARAPEnergyType energy;
+    int max_iter;
+    int coarse_max_iter;
+    int anderson_window;
+    bool parallel_local_step;
+    // Hierarchy, finest (input) level first
+    //
+    // V  #levels list of #V[l] by dim' vertex positions
+    // F  #levels list of #F[l] by 3 triangle indices into V[l]
+    // b  #levels list of fixed vertex indices into V[l]
+    // P  #levels-1 list of #V[l] by #V[l+1] prolongation operators: each
+    //   vertex of level l is interpolated at its closest point on level l+1
+    // Pb  #levels-1 list of #b[l+1] by #b[l] matrices averaging the fixed
+    //   vertices of level l closest to each fixed vertex of level l+1
+    // I  #levels-1 list of #V[l+1] indices into V[l] of birth vertices
+    // data  #levels list of per level ARAP data
+    std::vector<Eigen::MatrixXd> V;
+    std::vector<Eigen::MatrixXi> F;
+    std::vector<Eigen::VectorXi> b;
+    std::vector<Eigen::SparseMatrix<double> > P,Pb;
+    std::vector<Eigen::VectorXi> I;
+    std::vector<std::shared_ptr<ARAPData> > data;
+    // dim  dimension being used for solving
+    int dim;
+    ARAPMultilevelData():
+      max_levels(4),
+      ratio(0.25),
+      min_faces(1000),
+      energy(ARAP_ENERGY_TYPE_DEFAULT),
+      max_iter(10),
+      coarse_max_iter(20),
+      anderson_window(0),
+      parallel_local_step(false),
+      dim(-1)
+    {
+    };
+  };
+
+  // Compute a hierarchy of decimated meshes (see qslim) and the necessary
+  // information to start using a multilevel ARAP deformation: low frequency
+  // deformations are solved for on coarse levels, whose solutions are
+  // prolongated to warm start finer levels.
+  //
+  // Inputs:
+  //   V  #V by dim list of mesh positions
+  //   F  #F by 3 list of triangle indices into V (the mesh should be
+  //     edge-manifold, see qslim)
+  //   dim  dimension being used at solve time (see arap_precomputation)
+  //   b  #b list of "boundary" fixed vertex indices into V
+  // Outputs:
+  //   data  struct containing necessary precomputation
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename Derivedb>
+  IGL_INLINE bool arap_multilevel_precomputation(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::PlainObjectBase<DerivedF> & F,
+    const int dim,
+    const Eigen::PlainObjectBase<Derivedb> & b,
+    ARAPMultilevelData & data);
+  // Solve from the coarsest level to the input mesh, each level starting from
+  // the prolongation of the solution of the next coarser one (displacements
+  // if dim = V.cols(), positions otherwise). Per level iteration counts and
+  // energies are found in data.data[l]->iter and data.data[l]->energies.
+  //
+  // Inputs:
+  //   bc  #b by dim list of boundary conditions
+  //   data  struct containing necessary precomputation and parameters
+  //   U  #V by dim initial guess
+  // Outputs:
+  //   U  #V by dim solution
+  template <
+    typename Derivedbc,
+    typename DerivedU>
+  IGL_INLINE bool arap_multilevel_solve(
+    const Eigen::PlainObjectBase<Derivedbc> & bc,
+    ARAPMultilevelData & data,
+    Eigen::PlainObjectBase<DerivedU> & U);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "arap_multilevel.cpp"
+#endif
+
+#endif
@@ -12,6 +12,10 @@
 #include "sort.h"
 
 // STL includes
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
 #include <map>
 #include <iostream>
 
@@ -109,6 +113,61 @@ IGL_INLINE void igl::boundary_facets(
   assert(T.cols() == 0 || T.cols() == 4 || T.cols() == 3);
   using namespace std;
   using namespace Eigen;
+  if(T.cols() == 3)
+  {
+    // Triangles: count occurrences of each edge by sorting (unoriented) edge
+    // keys, without the lists of lists (and map) of the general version. Same
+    // output (and order) as the general version.
+    const int m = T.rows();
+    vector<pair<uint64_t,int> > keys(3*m);
+    for(int f = 0;f<m;f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        const uint64_t i = T(f,(c+1)%3);
+        const uint64_t j = T(f,(c+2)%3);
+        keys[c*m+f] = make_pair(i<j ? (i<<32)|j : (j<<32)|i,c*m+f);
+      }
+    }
+    sort(keys.begin(),keys.end());
+    // Edge c*m+f opposite corner c of face f is a boundary edge if not shared
+    // by exactly two faces
+    vector<char> boundary(3*m,false);
+    int nb = 0;
+    for(int k = 0;k<3*m;)
+    {
+      int l = k+1;
+      while(l<3*m && keys[l].first == keys[k].first)
+      {
+        l++;
+      }
+      if(l-k != 2)
+      {
+        for(;k<l;k++)
+        {
+          boundary[keys[k].second] = true;
+          nb++;
+        }
+      }
+      k = l;
+    }
+    vector<pair<uint64_t,int> >().swap(keys);
+    F.resize(nb,2);
+    int b = 0;
+    for(int f = 0;f<m;f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        if(boundary[c*m+f])
+        {
+          F(b,0) = T(f,(c+1)%3);
+          F(b,1) = T(f,(c+2)%3);
+          b++;
+        }
+      }
+    }
+    return;
+  }
   // Cop out: use vector of vectors version
   vector<vector<typename DerivedT::Scalar> > vT;
   matrix_to_list(T,vT);
@@ -8,6 +8,9 @@
 #include "collapse_edge.h"
 #include "circulation.h"
 #include "edge_collapse_is_valid.h"
+#include "IndexedPriorityQueue.h"
+#include "SetPriorityQueue.h"
+#include <limits>
 #include <vector>
 
 IGL_INLINE bool igl::collapse_edge(
@@ -323,42 +326,114 @@ IGL_INLINE bool igl::collapse_edge(
   int & e2,
   int & f1,
   int & f2)
+{
+  // Run the queue-templated version on a view of (Q,Qit)
+  typedef SetPriorityQueue PQ;
+  PQ SQ(Q,Qit);
+  return collapse_edge<PQ>(
+    cost_and_placement,
+    [&pre_collapse](
+      const Eigen::MatrixXd & V,
+      const Eigen::MatrixXi & F,
+      const Eigen::MatrixXi & E,
+      const Eigen::VectorXi & EMAP,
+      const Eigen::MatrixXi & EF,
+      const Eigen::MatrixXi & EI,
+      const PQ & Q,
+      const Eigen::MatrixXd & C,
+      const int e)->bool
+    {
+      return pre_collapse(V,F,E,EMAP,EF,EI,Q.set(),Q.iterators(),C,e);
+    },
+    [&post_collapse](
+      const Eigen::MatrixXd & V,
+      const Eigen::MatrixXi & F,
+      const Eigen::MatrixXi & E,
+      const Eigen::VectorXi & EMAP,
+      const Eigen::MatrixXi & EF,
+      const Eigen::MatrixXi & EI,
+      const PQ & Q,
+      const Eigen::MatrixXd & C,
+      const int e,
+      const int e1,
+      const int e2,
+      const int f1,
+      const int f2,
+      const bool collapsed)->void
+    {
+      post_collapse(
+        V,F,E,EMAP,EF,EI,Q.set(),Q.iterators(),C,e,e1,e2,f1,f2,collapsed);
+    },
+    V,F,E,EMAP,EF,EI,SQ,C,e,e1,e2,f1,f2);
+}
+
+template <typename PriorityQueue>
+IGL_INLINE bool igl::collapse_edge(
+  const typename igl::decimate_callback_types<PriorityQueue>::cost_and_placement
+    & cost_and_placement,
+  const typename igl::decimate_callback_types<PriorityQueue>::pre_collapse
+    & pre_collapse,
+  const typename igl::decimate_callback_types<PriorityQueue>::post_collapse
+    & post_collapse,
+  Eigen::MatrixXd & V,
+  Eigen::MatrixXi & F,
+  Eigen::MatrixXi & E,
+  Eigen::VectorXi & EMAP,
+  Eigen::MatrixXi & EF,
+  Eigen::MatrixXi & EI,
+  PriorityQueue & Q,
+  Eigen::MatrixXd & C,
+  int & e,
+  int & e1,
+  int & e2,
+  int & f1,
+  int & f2)
 {
   using namespace Eigen;
+  e = -1;
   if(Q.empty())
   {
     // no edges to collapse
     return false;
   }
-  std::pair<double,int> p = *(Q.begin());
+  const std::pair<double,int> p = Q.top();
   if(p.first == std::numeric_limits<double>::infinity())
   {
     // min cost edge is infinite cost
     return false;
   }
-  Q.erase(Q.begin());
+  Q.pop();
   e = p.second;
-  Qit[e] = Q.end();
+  const bool store_placements = C.rows() > 0;
+  double cost;
+  RowVectorXd place;
+  if(store_placements)
+  {
+    place = C.row(e);
+  }else
+  {
+    // Placement is not stored: e's neighborhood (hence its placement) has not
+    // changed since its cost was last computed
+    cost_and_placement(e,V,F,E,EMAP,EF,EI,cost,place);
+  }
   std::vector<int> N  = circulation(e, true,F,E,EMAP,EF,EI);
   std::vector<int> Nd = circulation(e,false,F,E,EMAP,EF,EI);
   N.insert(N.begin(),Nd.begin(),Nd.end());
   bool collapsed = true;
-  if(pre_collapse(V,F,E,EMAP,EF,EI,Q,Qit,C,e))
+  if(pre_collapse(V,F,E,EMAP,EF,EI,Q,C,e))
   {
-    collapsed = collapse_edge(e,C.row(e),V,F,E,EMAP,EF,EI,e1,e2,f1,f2);
+    collapsed = collapse_edge(e,place,V,F,E,EMAP,EF,EI,e1,e2,f1,f2);
   }else
   {
     // Aborted by pre collapse callback
     collapsed = false;
   }
-  post_collapse(V,F,E,EMAP,EF,EI,Q,Qit,C,e,e1,e2,f1,f2,collapsed);
+  post_collapse(V,F,E,EMAP,EF,EI,Q,C,e,e1,e2,f1,f2,collapsed);
   if(collapsed)
   {
     // Erase the two, other collapsed edges
-    Q.erase(Qit[e1]);
-    Qit[e1] = Q.end();
-    Q.erase(Qit[e2]);
-    Qit[e2] = Q.end();
+    Q.erase(e1);
+    Q.erase(e2);
     // update local neighbors
     // loop over original face neighbors
     for(auto n : N)
@@ -371,15 +446,14 @@ IGL_INLINE bool igl::collapse_edge(
         {
           // get edge id
           const int ei = EMAP(v*F.rows()+n);
-          // erase old entry
-          Q.erase(Qit[ei]);
           // compute cost and potential placement
-          double cost;
-          RowVectorXd place;
           cost_and_placement(ei,V,F,E,EMAP,EF,EI,cost,place);
           // Replace in queue
-          Qit[ei] = Q.insert(std::pair<double,int>(cost,ei)).first;
-          C.row(ei) = place;
+          Q.update(ei,cost);
+          if(store_placements)
+          {
+            C.row(ei) = place;
+          }
         }
       }
     }
@@ -387,8 +461,86 @@ IGL_INLINE bool igl::collapse_edge(
   {
     // reinsert with infinite weight (the provided cost function must **not**
     // have given this un-collapsable edge inf cost already)
-    p.first = std::numeric_limits<double>::infinity();
-    Qit[e] = Q.insert(p).first;
+    Q.update(e,std::numeric_limits<double>::infinity());
   }
   return collapsed;
 }
+
+template <typename PriorityQueue>
+IGL_INLINE bool igl::collapse_edge(
+  const typename igl::decimate_callback_types<PriorityQueue>::cost_and_placement
+    & cost_and_placement,
+  const typename igl::decimate_callback_types<PriorityQueue>::pre_collapse
+    & pre_collapse,
+  const typename igl::decimate_callback_types<PriorityQueue>::post_collapse
+    & post_collapse,
+  Eigen::MatrixXd & V,
+  Eigen::MatrixXi & F,
+  Eigen::MatrixXi & E,
+  Eigen::VectorXi & EMAP,
+  Eigen::MatrixXi & EF,
+  Eigen::MatrixXi & EI,
+  PriorityQueue & Q,
+  Eigen::MatrixXd & C)
+{
+  int e,e1,e2,f1,f2;
+  return 
+    collapse_edge<PriorityQueue>(
+      cost_and_placement,pre_collapse,post_collapse,
+      V,F,E,EMAP,EF,EI,Q,C,e,e1,e2,f1,f2);
+}
+
+template <typename PriorityQueue>
+IGL_INLINE bool igl::collapse_edge(
+  const typename igl::decimate_callback_types<PriorityQueue>::cost_and_placement
+    & cost_and_placement,
+  Eigen::MatrixXd & V,
+  Eigen::MatrixXi & F,
+  Eigen::MatrixXi & E,
+  Eigen::VectorXi & EMAP,
+  Eigen::MatrixXi & EF,
+  Eigen::MatrixXi & EI,
+  PriorityQueue & Q,
+  Eigen::MatrixXd & C)
+{
+  const auto always_try = [](
+    const Eigen::MatrixXd &                                         ,/*V*/
+    const Eigen::MatrixXi &                                         ,/*F*/
+    const Eigen::MatrixXi &                                         ,/*E*/
+    const Eigen::VectorXi &                                         ,/*EMAP*/
+    const Eigen::MatrixXi &                                         ,/*EF*/
+    const Eigen::MatrixXi &                                         ,/*EI*/
+    const PriorityQueue &                                           ,/*Q*/
+    const Eigen::MatrixXd &                                         ,/*C*/
+    const int                                                        /*e*/
+    ) -> bool { return true;};
+  const auto never_care = [](
+    const Eigen::MatrixXd &                                         ,   /*V*/
+    const Eigen::MatrixXi &                                         ,   /*F*/
+    const Eigen::MatrixXi &                                         ,   /*E*/
+    const Eigen::VectorXi &                                         ,/*EMAP*/
+    const Eigen::MatrixXi &                                         ,  /*EF*/
+    const Eigen::MatrixXi &                                         ,  /*EI*/
+    const PriorityQueue &                                           ,   /*Q*/
+    const Eigen::MatrixXd &                                         ,   /*C*/
+    const int                                                       ,   /*e*/
+    const int                                                       ,  /*e1*/
+    const int                                                       ,  /*e2*/
+    const int                                                       ,  /*f1*/
+    const int                                                       ,  /*f2*/
+    const bool                                                  /*collapsed*/
+    )-> void { };
+  return 
+    collapse_edge<PriorityQueue>(
+      cost_and_placement,always_try,never_care,V,F,E,EMAP,EF,EI,Q,C);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template bool igl::collapse_edge<igl::IndexedPriorityQueue<4> >(igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::cost_and_placement const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::pre_collapse const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::post_collapse const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::MatrixXi&, Eigen::MatrixXi&, igl::IndexedPriorityQueue<4>&, Eigen::MatrixXd&, int&, int&, int&, int&, int&);
+template bool igl::collapse_edge<igl::IndexedPriorityQueue<4> >(igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::cost_and_placement const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::pre_collapse const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::post_collapse const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::MatrixXi&, Eigen::MatrixXi&, igl::IndexedPriorityQueue<4>&, Eigen::MatrixXd&);
+template bool igl::collapse_edge<igl::IndexedPriorityQueue<4> >(igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::cost_and_placement const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::MatrixXi&, Eigen::MatrixXi&, igl::IndexedPriorityQueue<4>&, Eigen::MatrixXd&);
+template bool igl::collapse_edge<igl::SetPriorityQueue>(igl::decimate_callback_types<igl::SetPriorityQueue>::cost_and_placement const&, igl::decimate_callback_types<igl::SetPriorityQueue>::pre_collapse const&, igl::decimate_callback_types<igl::SetPriorityQueue>::post_collapse const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::MatrixXi&, Eigen::MatrixXi&, igl::SetPriorityQueue&, Eigen::MatrixXd&, int&, int&, int&, int&, int&);
+template bool igl::collapse_edge<igl::SetPriorityQueue>(igl::decimate_callback_types<igl::SetPriorityQueue>::cost_and_placement const&, igl::decimate_callback_types<igl::SetPriorityQueue>::pre_collapse const&, igl::decimate_callback_types<igl::SetPriorityQueue>::post_collapse const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::MatrixXi&, Eigen::MatrixXi&, igl::SetPriorityQueue&, Eigen::MatrixXd&);
+template bool igl::collapse_edge<igl::SetPriorityQueue>(igl::decimate_callback_types<igl::SetPriorityQueue>::cost_and_placement const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::MatrixXi&, Eigen::MatrixXi&, igl::SetPriorityQueue&, Eigen::MatrixXd&);
+#endif
@@ -8,6 +8,7 @@
 #ifndef IGL_COLLAPSE_EDGE_H
 #define IGL_COLLAPSE_EDGE_H
 #include "igl_inline.h"
+#include "decimate_callback_types.h"
 #include <Eigen/Core>
 #include <vector>
 #include <set>
@@ -208,6 +209,82 @@ namespace igl
     int & e2,
     int & f1,
     int & f2);
+  // Collapse least-cost edge from a priority queue of any type providing
+  // the interface of igl::IndexedPriorityQueue (empty, top, pop, update,
+  // erase). IndexedPriorityQueue<> keeps the queue in a contiguous heap and
+  // is considerably faster than a std::set; SetPriorityQueue adapts a
+  // std::set (this is how the std::set versions above are implemented).
+  //
+  // Templates:
+  //   PriorityQueue  type of queue of (cost,edge) pairs
+  // Inputs:
+  //   cost_and_placement  see above
+  //   pre_collapse  see above
+  //   post_collapse  see above
+  // Inputs/Outputs:
+  //   V,F,E,EMAP,EF,EI  see above
+  //   Q  queue containing costs of edges (by edge index)
+  //   C  #E by dim list of stored placements, or empty (0 rows) to not store
+  //     placements: the placement of e is then recomputed with
+  //     cost_and_placement when e is popped (and callbacks receive the empty
+  //     C)
+  // Outputs:
+  //   e  index into E of attempted collapsed edge. Set to -1 if Q is empty or
+  //     contains only infinite cost edges.
+  //   e1  index into E of edge collpased on left.
+  //   e2  index into E of edge collpased on right.
+  //   f1  index into F of face collpased on left.
+  //   f2  index into F of face collpased on right.
+  // Returns true if edge was collapsed
+  template <typename PriorityQueue>
+  IGL_INLINE bool collapse_edge(
+    const typename decimate_callback_types<PriorityQueue>::cost_and_placement
+      & cost_and_placement,
+    const typename decimate_callback_types<PriorityQueue>::pre_collapse
+      & pre_collapse,
+    const typename decimate_callback_types<PriorityQueue>::post_collapse
+      & post_collapse,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F,
+    Eigen::MatrixXi & E,
+    Eigen::VectorXi & EMAP,
+    Eigen::MatrixXi & EF,
+    Eigen::MatrixXi & EI,
+    PriorityQueue & Q,
+    Eigen::MatrixXd & C,
+    int & e,
+    int & e1,
+    int & e2,
+    int & f1,
+    int & f2);
+  template <typename PriorityQueue>
+  IGL_INLINE bool collapse_edge(
+    const typename decimate_callback_types<PriorityQueue>::cost_and_placement
+      & cost_and_placement,
+    const typename decimate_callback_types<PriorityQueue>::pre_collapse
+      & pre_collapse,
+    const typename decimate_callback_types<PriorityQueue>::post_collapse
+      & post_collapse,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F,
+    Eigen::MatrixXi & E,
+    Eigen::VectorXi & EMAP,
+    Eigen::MatrixXi & EF,
+    Eigen::MatrixXi & EI,
+    PriorityQueue & Q,
+    Eigen::MatrixXd & C);
+  template <typename PriorityQueue>
+  IGL_INLINE bool collapse_edge(
+    const typename decimate_callback_types<PriorityQueue>::cost_and_placement
+      & cost_and_placement,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F,
+    Eigen::MatrixXi & E,
+    Eigen::VectorXi & EMAP,
+    Eigen::MatrixXi & EF,
+    Eigen::MatrixXi & EI,
+    PriorityQueue & Q,
+    Eigen::MatrixXd & C);
 }
 
 #ifndef IGL_STATIC_LIBRARY
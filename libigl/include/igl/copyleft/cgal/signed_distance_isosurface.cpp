@@ -59,6 +59,7 @@ IGL_INLINE bool igl::copyleft::cgal::signed_distance_isosurface(
   Eigen::MatrixXi E;
   Eigen::VectorXi EMAP;
   WindingNumberAABB<Eigen::Vector3d> hier;
+  FastWindingNumberData fwn;
   switch(sign_type)
   {
     default:
@@ -71,6 +72,9 @@ IGL_INLINE bool igl::copyleft::cgal::signed_distance_isosurface(
       hier.set_mesh(IV,IF);
       hier.grow();
       break;
+    case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
+      fast_winding_number_precompute(IV,IF,fwn);
+      break;
     case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
       // "Signed Distance Computation Using the Angle Weighted Pseudonormal"
       // [Bærentzen & Aanæs 2005]
@@ -117,6 +121,15 @@ IGL_INLINE bool igl::copyleft::cgal::signed_distance_isosurface(
           return sd-level;
         };
       break;
+    case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
+      fun = 
+        [&tree,&IV,&IF,&fwn,&level](const Point_3 & q) -> FT
+        {
+          const double sd = signed_distance_fast_winding_number(
+            tree,IV,IF,fwn,RowVector3d(q.x(),q.y(),q.z()));
+          return sd-level;
+        };
+      break;
     case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
       fun = [&tree,&IV,&IF,&FN,&VN,&EN,&EMAP,&level](const Point_3 & q) -> FT
         {
@@ -25,218 +25,219 @@
 
 #include "marching_cubes.h"
 #include "marching_cubes_tables.h"
-#include <map>
+#include "../parallel_for.h"
+#include "../ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
 
 extern const int edgeTable[256];
 extern const int triTable[256][2][17];
 extern const int polyTable[8][16];
 
-class EdgeKey
+template <typename DerivedV1, typename DerivedV2, typename DerivedF>
+IGL_INLINE void igl::copyleft::marching_cubes(
+  const Eigen::PlainObjectBase<DerivedV1> &values,
+  const Eigen::PlainObjectBase<DerivedV2> &points,
+  const unsigned x_res,
+  const unsigned y_res,
+  const unsigned z_res,
+  Eigen::PlainObjectBase<DerivedV2> &vertices,
+  Eigen::PlainObjectBase<DerivedF> &faces)
 {
-public:
-
-  EdgeKey(unsigned i0, unsigned i1) {
-    if (i0 < i1)  { i0_ = i0;  i1_ = i1; }
-    else            { i0_ = i1;  i1_ = i0; }
-  }
-
-  bool operator<(const EdgeKey& _rhs) const
+  using namespace std;
+  typedef typename DerivedV2::Scalar Scalar;
+  typedef typename DerivedF::Scalar Index;
+  assert(values.cols() == 1);
+  assert(points.cols() == 3);
+
+  if(x_res <2 || y_res<2 ||z_res<2)
+    return;
+  assert(unsigned(points.rows()) == x_res * y_res * z_res);
+
+  unsigned int offsets_[8];
+  offsets_[0] = 0;
+  offsets_[1] = 1;
+  offsets_[2] = 1 + x_res;
+  offsets_[3] =     x_res;
+  offsets_[4] =             x_res*y_res;
+  offsets_[5] = 1         + x_res*y_res;
+  offsets_[6] = 1 + x_res + x_res*y_res;
+  offsets_[7] =     x_res + x_res*y_res;
+  const int corner_xyz[8][3] = {
+    {0,0,0},{1,0,0},{1,1,0},{0,1,0},{0,0,1},{1,0,1},{1,1,1},{0,1,1}};
+  // Corners of the 12 cube edges, lower corner first
+  const int edge_corners[12][2] = {
+    {0,1},{1,2},{3,2},{0,3},{4,5},{5,6},{7,6},{4,7},{0,4},{1,5},{2,6},{3,7}};
+
+  // Grid edges are numbered per layer of grid points: the x-edges of a layer
+  // (x + (x_res-1)*y), then its y-edges (nx + x + x_res*y). The z-edges
+  // rising from a layer are numbered x + x_res*y. For each cube edge store
+  // which of the cube's bottom layer (0), top layer (1) or rising edges (2)
+  // it belongs to, and how its number depends on the cube's (x,y).
+  const unsigned nx = (x_res-1)*y_res;
+  const unsigned ny = x_res*(y_res-1);
+  const unsigned nz = x_res*y_res;
+  int edge_layer[12];
+  unsigned edge_base[12], edge_stride[12];
+  for(int e = 0;e<12;e++)
   {
-    if (i0_ != _rhs.i0_)
-      return (i0_ < _rhs.i0_);
-    else
-      return (i1_ < _rhs.i1_);
+    const int * a = corner_xyz[edge_corners[e][0]];
+    const int * b = corner_xyz[edge_corners[e][1]];
+    if(a[2] != b[2])
+    {
+      edge_layer[e] = 2;
+      edge_stride[e] = x_res;
+      edge_base[e] = a[0] + x_res*a[1];
+    }else if(a[0] != b[0])
+    {
+      edge_layer[e] = a[2];
+      edge_stride[e] = x_res-1;
+      edge_base[e] = a[0] + (x_res-1)*a[1];
+    }else
+    {
+      edge_layer[e] = a[2];
+      edge_stride[e] = x_res;
+      edge_base[e] = nx + a[0] + x_res*a[1];
+    }
   }
 
-private:
-  unsigned i0_, i1_;
-};
-
-
-template <typename DerivedV1, typename DerivedV2, typename DerivedF>
-class MarchingCubes
-{
-  typedef std::map<EdgeKey, unsigned>  MyMap;
-  typedef typename MyMap::const_iterator   MyMapIterator;
-
-public:
-  MarchingCubes(
-                const Eigen::PlainObjectBase<DerivedV1> &values,
-                const Eigen::PlainObjectBase<DerivedV2> &points,
-                const unsigned x_res,
-                const unsigned y_res,
-                const unsigned z_res,
-                Eigen::PlainObjectBase<DerivedV2> &vertices,
-                Eigen::PlainObjectBase<DerivedF> &faces)
+  // Each slab of cube layers [z0,z1) is triangulated independently. The x-
+  // and y-edges of grid layer z1 are shared with the next slab which creates
+  // their vertices: until stitched, faces refer to them as -1-(edge number).
+  const unsigned n_layers = z_res-1;
+  const size_t nthreads = igl::ThreadPool::instance().num_threads();
+  const unsigned n_slabs =
+    nthreads <= 1 ? 1 : (unsigned)min<size_t>(n_layers,4*nthreads);
+  struct Slab
   {
-    assert(values.cols() == 1);
-    assert(points.cols() == 3);
-
-    if(x_res <2 || y_res<2 ||z_res<2)
-      return;
-    faces.resize(10000,3);
-    int num_faces = 0;
-
-    vertices.resize(10000,3);
-    int num_vertices = 0;
-
-
-    unsigned n_cubes  = (x_res-1) * (y_res-1) * (z_res-1);
-    assert(unsigned(points.rows()) == x_res * y_res * z_res);
-
-    unsigned int         offsets_[8];
-    offsets_[0] = 0;
-    offsets_[1] = 1;
-    offsets_[2] = 1 + x_res;
-    offsets_[3] =     x_res;
-    offsets_[4] =             x_res*y_res;
-    offsets_[5] = 1         + x_res*y_res;
-    offsets_[6] = 1 + x_res + x_res*y_res;
-    offsets_[7] =     x_res + x_res*y_res;
-
-    for (unsigned cube_it =0 ; cube_it < n_cubes; ++cube_it)
+    vector<Scalar> V;
+    vector<Index> F;
+    // (edge number, vertex) of x- and y-edges of bottom grid layer
+    vector<pair<unsigned,Index> > bottom;
+  };
+  vector<Slab> slabs(n_slabs);
+  parallel_for(n_slabs,[&](const unsigned s)
+  {
+    Slab & slab = slabs[s];
+    const unsigned z0 = (unsigned)(((size_t)s*n_layers)/n_slabs);
+    const unsigned z1 = (unsigned)(((size_t)(s+1)*n_layers)/n_slabs);
+    // Vertex on each edge of the current cube layer (or -1)
+    vector<Index> layer_vertex[3] = {
+      vector<Index>(nx+ny,-1),vector<Index>(nx+ny,-1),vector<Index>(nz,-1)};
+    for(unsigned z = z0;z<z1;z++)
     {
-
-      unsigned         corner[8];
-      typename DerivedF::Scalar samples[12];
-      unsigned char    cubetype(0);
-      unsigned int     i;
-
-
-      // get point indices of corner vertices
-      for (i=0; i<8; ++i)
+      const bool defer_top = z+1 == z1 && s+1 < n_slabs;
+      const bool record_bottom = z == z0 && s > 0;
+      for(unsigned y = 0;y<y_res-1;y++)
       {
-        // get cube coordinates
-        unsigned int _idx = cube_it;
-        unsigned int X(x_res-1), Y(y_res-1);
-        unsigned int x = _idx % X;  _idx /= X;
-        unsigned int y = _idx % Y;  _idx /= Y;
-        unsigned int z = _idx;
-
-        // transform to point coordinates
-        _idx = x + y*x_res + z*x_res*y_res;
-
-        // add offset
-        corner[i] = _idx + offsets_[i];
+        for(unsigned x = 0;x<x_res-1;x++)
+        {
+          unsigned corner[8];
+          unsigned char cubetype(0);
+          const unsigned idx = x + y*x_res + z*x_res*y_res;
+          for(int i=0; i<8; ++i)
+          {
+            corner[i] = idx + offsets_[i];
+            // determine cube type
+            if (values[corner[i]] > 0.0)
+              cubetype |= (1<<i);
+          }
+
+          // trivial reject ?
+          if (cubetype == 0 || cubetype == 255)
+            continue;
+
+          // compute samples on cube's edges
+          Index samples[12];
+          for(int e = 0;e<12;e++)
+          {
+            if(!(edgeTable[cubetype] & (1<<e)))
+              continue;
+            const unsigned id = edge_base[e] + x + edge_stride[e]*y;
+            if(edge_layer[e] == 1 && defer_top)
+            {
+              samples[e] = -1-(Index)id;
+              continue;
+            }
+            Index & v = layer_vertex[edge_layer[e]][id];
+            if(v < 0)
+            {
+              const unsigned i0 = corner[edge_corners[e][0]];
+              const unsigned i1 = corner[edge_corners[e][1]];
+              const Eigen::Matrix<Scalar, 1, 3> p0 = points.row(i0);
+              const Eigen::Matrix<Scalar, 1, 3> p1 = points.row(i1);
+              typename DerivedV1::Scalar s0 = fabs(values[i0]);
+              typename DerivedV1::Scalar s1 = fabs(values[i1]);
+              typename DerivedV1::Scalar t  = s0 / (s0+s1);
+              const Eigen::Matrix<Scalar, 1, 3> p = (1.0f-t)*p0 + t*p1;
+              v = slab.V.size()/3;
+              slab.V.insert(slab.V.end(),p.data(),p.data()+3);
+              if(edge_layer[e] == 0 && record_bottom)
+              {
+                slab.bottom.push_back(make_pair(id,v));
+              }
+            }
+            samples[e] = v;
+          }
+
+          // connect samples by triangles
+          for (int i=0; triTable[cubetype][0][i] != -1; i+=3 )
+          {
+            slab.F.push_back(samples[triTable[cubetype][0][i  ]]);
+            slab.F.push_back(samples[triTable[cubetype][0][i+1]]);
+            slab.F.push_back(samples[triTable[cubetype][0][i+2]]);
+          }
+        }
       }
-
-
-      // determine cube type
-      for (i=0; i<8; ++i)
-        if (values[corner[i]] > 0.0)
-          cubetype |= (1<<i);
-
-
-      // trivial reject ?
-      if (cubetype == 0 || cubetype == 255)
-        continue;
-
-
-      // compute samples on cube's edges
-      if (edgeTable[cubetype]&1)
-        samples[0]  = add_vertex(values, points, corner[0], corner[1], vertices, num_vertices, edge2vertex);
-      if (edgeTable[cubetype]&2)
-        samples[1]  = add_vertex(values, points, corner[1], corner[2], vertices, num_vertices, edge2vertex);
-      if (edgeTable[cubetype]&4)
-        samples[2]  = add_vertex(values, points, corner[3], corner[2], vertices, num_vertices, edge2vertex);
-      if (edgeTable[cubetype]&8)
-        samples[3]  = add_vertex(values, points, corner[0], corner[3], vertices, num_vertices, edge2vertex);
-      if (edgeTable[cubetype]&16)
-        samples[4]  = add_vertex(values, points, corner[4], corner[5], vertices, num_vertices, edge2vertex);
-      if (edgeTable[cubetype]&32)
-        samples[5]  = add_vertex(values, points, corner[5], corner[6], vertices, num_vertices, edge2vertex);
-      if (edgeTable[cubetype]&64)
-        samples[6]  = add_vertex(values, points, corner[7], corner[6], vertices, num_vertices, edge2vertex);
-      if (edgeTable[cubetype]&128)
-        samples[7]  = add_vertex(values, points, corner[4], corner[7], vertices, num_vertices, edge2vertex);
-      if (edgeTable[cubetype]&256)
-        samples[8]  = add_vertex(values, points, corner[0], corner[4], vertices, num_vertices, edge2vertex);
-      if (edgeTable[cubetype]&512)
-        samples[9]  = add_vertex(values, points, corner[1], corner[5], vertices, num_vertices, edge2vertex);
-      if (edgeTable[cubetype]&1024)
-        samples[10] = add_vertex(values, points, corner[2], corner[6], vertices, num_vertices, edge2vertex);
-      if (edgeTable[cubetype]&2048)
-        samples[11] = add_vertex(values, points, corner[3], corner[7], vertices, num_vertices, edge2vertex);
-
-
-
-      // connect samples by triangles
-      for (i=0; triTable[cubetype][0][i] != -1; i+=3 )
-      {
-        num_faces++;
-        if (num_faces > faces.rows())
-          faces.conservativeResize(faces.rows()+10000, Eigen::NoChange);
-
-        faces.row(num_faces-1) <<
-        samples[triTable[cubetype][0][i  ]],
-        samples[triTable[cubetype][0][i+1]],
-        samples[triTable[cubetype][0][i+2]];
-
-      }
-
+      // Move up one layer
+      swap(layer_vertex[0],layer_vertex[1]);
+      fill(layer_vertex[1].begin(),layer_vertex[1].end(),-1);
+      fill(layer_vertex[2].begin(),layer_vertex[2].end(),-1);
     }
+    sort(slab.bottom.begin(),slab.bottom.end());
+  },2);
 
-    vertices.conservativeResize(num_vertices, Eigen::NoChange);
-    faces.conservativeResize(num_faces, Eigen::NoChange);
-
-  };
-
-  static typename DerivedF::Scalar  add_vertex(const Eigen::PlainObjectBase<DerivedV1> &values,
-                                               const Eigen::PlainObjectBase<DerivedV2> &points,
-                                               unsigned int i0,
-                                               unsigned int i1,
-                                               Eigen::PlainObjectBase<DerivedV2> &vertices,
-                                               int &num_vertices,
-                                               MyMap &edge2vertex)
+  // Stitch slabs
+  vector<Index> V_offset(n_slabs+1,0), F_offset(n_slabs+1,0);
+  for(unsigned s = 0;s<n_slabs;s++)
   {
-    // find vertex if it has been computed already
-    MyMapIterator it = edge2vertex.find(EdgeKey(i0, i1));
-    if (it != edge2vertex.end())
-      return it->second;
-    ;
-
-    // generate new vertex
-    const Eigen::Matrix<typename DerivedV2::Scalar, 1, 3> & p0 = points.row(i0);
-    const Eigen::Matrix<typename DerivedV2::Scalar, 1, 3> & p1 = points.row(i1);
-
-    typename DerivedV1::Scalar s0 = fabs(values[i0]);
-    typename DerivedV1::Scalar s1 = fabs(values[i1]);
-    typename DerivedV1::Scalar t  = s0 / (s0+s1);
-
-
-    num_vertices++;
-    if (num_vertices > vertices.rows())
-      vertices.conservativeResize(vertices.rows()+10000, Eigen::NoChange);
-
-    vertices.row(num_vertices-1)  = (1.0f-t)*p0 + t*p1;
-    edge2vertex[EdgeKey(i0, i1)] = num_vertices-1;
-
-    return num_vertices-1;
+    V_offset[s+1] = V_offset[s] + slabs[s].V.size()/3;
+    F_offset[s+1] = F_offset[s] + slabs[s].F.size()/3;
   }
-  ;
-
-  // maps an edge to the sample vertex generated on it
-  MyMap  edge2vertex;
-};
-
-
-template <typename DerivedV1, typename DerivedV2, typename DerivedF>
-IGL_INLINE void igl::copyleft::marching_cubes(
-  const Eigen::PlainObjectBase<DerivedV1> &values,
-  const Eigen::PlainObjectBase<DerivedV2> &points,
-  const unsigned x_res,
-  const unsigned y_res,
-  const unsigned z_res,
-  Eigen::PlainObjectBase<DerivedV2> &vertices,
-  Eigen::PlainObjectBase<DerivedF> &faces)
-{
-  MarchingCubes<DerivedV1, DerivedV2, DerivedF> mc(values,
-                                       points,
-                                       x_res,
-                                       y_res,
-                                       z_res,
-                                       vertices,
-                                       faces);
+  vertices.resize(V_offset[n_slabs],3);
+  faces.resize(F_offset[n_slabs],3);
+  parallel_for(n_slabs,[&](const unsigned s)
+  {
+    const Slab & slab = slabs[s];
+    for(size_t v = 0;v<slab.V.size()/3;v++)
+    {
+      for(int d = 0;d<3;d++)
+      {
+        vertices(V_offset[s]+v,d) = slab.V[3*v+d];
+      }
+    }
+    for(size_t f = 0;f<slab.F.size()/3;f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        Index v = slab.F[3*f+c];
+        if(v >= 0)
+        {
+          v += V_offset[s];
+        }else
+        {
+          const vector<pair<unsigned,Index> > & next = slabs[s+1].bottom;
+          const auto it = lower_bound(next.begin(),next.end(),
+            make_pair((unsigned)(-1-v),(Index)-1));
+          assert(it != next.end() && it->first == (unsigned)(-1-v));
+          v = V_offset[s+1] + it->second;
+        }
+        faces(F_offset[s]+f,c) = v;
+      }
+    }
+  },2);
 }
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
@@ -19,6 +19,10 @@ namespace igl
     // performs marching cubes reconstruction on the grid defined by values, and
     // points, and generates vertices and faces
     //
+    // Slabs of z-layers are processed in parallel (see igl::parallel_for).
+    // Faces come out in the same order regardless of the number of threads;
+    // only the order of vertices depends on it.
+    //
     // Input:
     //  values  #number_of_grid_points x 1 array -- the scalar values of an
     //    implicit function defined on the grid points (<0 in the inside of the
@@ -0,0 +1,129 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2015 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "sparse_marching_cubes.h"
+#include "marching_cubes_tables.h"
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::copyleft::sparse_marching_cubes(
+  const igl::SparseSignedDistanceGrid & grid,
+  Eigen::PlainObjectBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedF> & F)
+{
+  using namespace std;
+  typedef SparseSignedDistanceGrid Grid;
+  const int B = Grid::BRICK_SIZE;
+  // Corners and edges of a cube in the order of the tables
+  const int corner_offset[8][3] = {
+    {0,0,0},{1,0,0},{1,1,0},{0,1,0},{0,0,1},{1,0,1},{1,1,1},{0,1,1}};
+  const int edge_corners[12][2] = {
+    {0,1},{1,2},{3,2},{0,3},{4,5},{5,6},{7,6},{4,7},{0,4},{1,5},{2,6},{3,7}};
+  // Lattice edges are keyed by 3*(index of lower endpoint)+axis
+  unordered_map<long long,int> edge2vertex;
+  vector<double> vV;
+  vector<int> vF;
+  const auto lattice_index = [&grid](const int i,const int j,const int k)
+  {
+    return (long long)i + (long long)grid.res(0)*(j + (long long)grid.res(1)*k);
+  };
+  for(const long long b : grid.bricks)
+  {
+    const int bi = B*(b%grid.brick_res(0));
+    const int bj = B*((b/grid.brick_res(0))%grid.brick_res(1));
+    const int bk = B*(b/grid.brick_res(0)/grid.brick_res(1));
+    for(int k = bk;k<std::min(bk+B,grid.res(2)-1);k++)
+    {
+      for(int j = bj;j<std::min(bj+B,grid.res(1)-1);j++)
+      {
+        for(int i = bi;i<std::min(bi+B,grid.res(0)-1);i++)
+        {
+          int c[8][3];
+          double values[8];
+          unsigned char cubetype = 0;
+          for(int v = 0;v<8;v++)
+          {
+            c[v][0] = i+corner_offset[v][0];
+            c[v][1] = j+corner_offset[v][1];
+            c[v][2] = k+corner_offset[v][2];
+            values[v] = grid.value(c[v][0],c[v][1],c[v][2]);
+            if(values[v] > 0.0)
+            {
+              cubetype |= (1<<v);
+            }
+          }
+          // trivial reject ?
+          if(cubetype == 0 || cubetype == 255)
+          {
+            continue;
+          }
+          int samples[12];
+          for(int e = 0;e<12;e++)
+          {
+            if(!(edgeTable[cubetype] & (1<<e)))
+            {
+              continue;
+            }
+            const int a = edge_corners[e][0];
+            const int d = edge_corners[e][1];
+            const int axis =
+              c[a][0]!=c[d][0] ? 0 : (c[a][1]!=c[d][1] ? 1 : 2);
+            const int lo = c[a][axis] < c[d][axis] ? a : d;
+            const long long key =
+              3*lattice_index(c[lo][0],c[lo][1],c[lo][2]) + axis;
+            const auto it = edge2vertex.find(key);
+            if(it != edge2vertex.end())
+            {
+              samples[e] = it->second;
+              continue;
+            }
+            const double s0 = fabs(values[a]);
+            const double s1 = fabs(values[d]);
+            const double t = s0/(s0+s1);
+            const Eigen::RowVector3d p =
+              (1.0-t)*grid.point(c[a][0],c[a][1],c[a][2]) +
+              t*grid.point(c[d][0],c[d][1],c[d][2]);
+            samples[e] = vV.size()/3;
+            vV.insert(vV.end(),p.data(),p.data()+3);
+            edge2vertex[key] = samples[e];
+          }
+          // connect samples by triangles
+          for(int t = 0;triTable[cubetype][0][t] != -1;t+=3)
+          {
+            for(int v = 0;v<3;v++)
+            {
+              vF.push_back(samples[triTable[cubetype][0][t+v]]);
+            }
+          }
+        }
+      }
+    }
+  }
+  V.resize(vV.size()/3,3);
+  for(int v = 0;v<V.rows();v++)
+  {
+    for(int d = 0;d<3;d++)
+    {
+      V(v,d) = vV[3*v+d];
+    }
+  }
+  F.resize(vF.size()/3,3);
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int d = 0;d<3;d++)
+    {
+      F(f,d) = vF[3*f+d];
+    }
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::copyleft::sparse_marching_cubes<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(igl::SparseSignedDistanceGrid const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+#endif
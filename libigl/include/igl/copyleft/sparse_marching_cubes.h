@@ -0,0 +1,41 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2015 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_COPYLEFT_SPARSE_MARCHING_CUBES_H
+#define IGL_COPYLEFT_SPARSE_MARCHING_CUBES_H
+#include "../igl_inline.h"
+#include "../sparse_signed_distance.h"
+#include <Eigen/Core>
+namespace igl
+{
+  namespace copyleft
+  {
+    // Extract the zero level set of a sparse signed distance field by
+    // marching cubes, visiting only cubes whose lowest corner lies in an
+    // allocated brick. Produces the same triangles (with the same
+    // orientation) as igl::copyleft::marching_cubes on the dense grid,
+    // possibly in a different order.
+    //
+    // Inputs:
+    //   grid  sparse signed distance field (<0 inside, see
+    //     sparse_signed_distance.h)
+    // Outputs:
+    //   V  #V by 3 list of mesh vertex positions
+    //   F  #F by 3 list of mesh triangle indices
+    template <typename DerivedV, typename DerivedF>
+      IGL_INLINE void sparse_marching_cubes(
+        const igl::SparseSignedDistanceGrid & grid,
+        Eigen::PlainObjectBase<DerivedV> & V,
+        Eigen::PlainObjectBase<DerivedF> & F);
+  }
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "sparse_marching_cubes.cpp"
+#endif
+
+#endif
@@ -14,6 +14,155 @@
 #include "connect_boundary_to_infinity.h"
 #include "max_faces_stopping_condition.h"
 #include "shortest_edge_and_midpoint.h"
+#include "IndexedPriorityQueue.h"
+#include "SetPriorityQueue.h"
+#include <cassert>
+#include <limits>
+#include <utility>
+
+namespace igl
+{
+  namespace decimate_internal
+  {
+    // Decimate (V,F) in place and move the compacted result into (U,G). The
+    // connectivity (E,EMAP,EF,EI) is consumed: it is released before
+    // compacting. If store_placements is false then no #E by dim list of
+    // placements is kept (see collapse_edge) and callbacks receive an empty
+    // C.
+    template <typename PriorityQueue>
+    IGL_INLINE bool decimate_in_place(
+      Eigen::MatrixXd & V,
+      Eigen::MatrixXi & F,
+      const typename decimate_callback_types<PriorityQueue>::cost_and_placement
+        & cost_and_placement,
+      const typename decimate_callback_types<PriorityQueue>::stopping_condition
+        & stopping_condition,
+      const typename decimate_callback_types<PriorityQueue>::pre_collapse
+        & pre_collapse,
+      const typename decimate_callback_types<PriorityQueue>::post_collapse
+        & post_collapse,
+      Eigen::MatrixXi & E,
+      Eigen::VectorXi & EMAP,
+      Eigen::MatrixXi & EF,
+      Eigen::MatrixXi & EI,
+      const bool store_placements,
+      Eigen::MatrixXd & U,
+      Eigen::MatrixXi & G,
+      Eigen::VectorXi & J,
+      Eigen::VectorXi & I)
+    {
+      using namespace Eigen;
+      using namespace std;
+      bool clean_finish = false;
+      {
+        PriorityQueue Q;
+        Q.resize(E.rows());
+        // If an edge were collapsed, we'd collapse it to these points:
+        MatrixXd C(store_placements ? E.rows() : 0,V.cols());
+        for(int e = 0;e<E.rows();e++)
+        {
+          double cost = e;
+          RowVectorXd p(1,3);
+          cost_and_placement(e,V,F,E,EMAP,EF,EI,cost,p);
+          if(store_placements)
+          {
+            C.row(e) = p;
+          }
+          Q.update(e,cost);
+        }
+        int prev_e = -1;
+        while(true)
+        {
+          if(Q.empty())
+          {
+            break;
+          }
+          if(Q.top().first == std::numeric_limits<double>::infinity())
+          {
+            // min cost edge is infinite cost
+            break;
+          }
+          int e,e1,e2,f1,f2;
+          if(collapse_edge<PriorityQueue>(
+             cost_and_placement, pre_collapse, post_collapse,
+             V,F,E,EMAP,EF,EI,Q,C,e,e1,e2,f1,f2))
+          {
+            if(stopping_condition(V,F,E,EMAP,EF,EI,Q,C,e,e1,e2,f1,f2))
+            {
+              clean_finish = true;
+              break;
+            }
+          }else
+          {
+            if(prev_e == e)
+            {
+              assert(false && "Edge collapse no progress... bad stopping condition?");
+              break;
+            }
+            // Edge was not collapsed... must have been invalid. collapse_edge
+            // should have updated its cost to inf... continue
+          }
+          prev_e = e;
+        }
+      }
+      E.resize(0,2);
+      EMAP.resize(0);
+      EF.resize(0,2);
+      EI.resize(0,2);
+      // Remove all IGL_COLLAPSE_EDGE_NULL faces by moving the remaining faces
+      // down in place
+      J.resize(F.rows());
+      int m = 0;
+      for(int f = 0;f<F.rows();f++)
+      {
+        if(
+          F(f,0) != IGL_COLLAPSE_EDGE_NULL || 
+          F(f,1) != IGL_COLLAPSE_EDGE_NULL || 
+          F(f,2) != IGL_COLLAPSE_EDGE_NULL)
+        {
+          F.row(m) = F.row(f);
+          J(m) = f;
+          m++;
+        }
+      }
+      F.conservativeResize(m,F.cols());
+      J.conservativeResize(m);
+      // Remove unreferenced vertices the same way (see remove_unreferenced)
+      VectorXi IM = VectorXi::Constant(V.rows(),-1);
+      for(int f = 0;f<F.rows();f++)
+      {
+        for(int c = 0;c<F.cols();c++)
+        {
+          IM(F(f,c)) = 0;
+        }
+      }
+      I.resize(V.rows());
+      int n = 0;
+      for(int v = 0;v<V.rows();v++)
+      {
+        if(IM(v) >= 0)
+        {
+          V.row(n) = V.row(v);
+          I(n) = v;
+          IM(v) = n;
+          n++;
+        }
+      }
+      V.conservativeResize(n,V.cols());
+      I.conservativeResize(n);
+      for(int f = 0;f<F.rows();f++)
+      {
+        for(int c = 0;c<F.cols();c++)
+        {
+          F(f,c) = IM(F(f,c));
+        }
+      }
+      U.swap(V);
+      G.swap(F);
+      return clean_finish;
+    }
+  }
+}
 
 IGL_INLINE bool igl::decimate(
   const Eigen::MatrixXd & V,
@@ -23,21 +172,37 @@ IGL_INLINE bool igl::decimate(
   Eigen::MatrixXi & G,
   Eigen::VectorXi & J,
   Eigen::VectorXi & I)
+{
+  return igl::decimate(Eigen::MatrixXd(V),Eigen::MatrixXi(F),max_m,U,G,J,I);
+}
+
+IGL_INLINE bool igl::decimate(
+  Eigen::MatrixXd && V,
+  Eigen::MatrixXi && F,
+  const size_t max_m,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
 {
   // Original number of faces
   const int orig_m = F.rows();
   // Tracking number of faces
   int m = F.rows();
-  typedef Eigen::MatrixXd DerivedV;
-  typedef Eigen::MatrixXi DerivedF;
-  DerivedV VO;
-  DerivedF FO;
-  igl::connect_boundary_to_infinity(V,F,VO,FO);
-  bool ret = decimate(
-    VO,
-    FO,
+  // Connect boundary to infinity in place
+  {
+    Eigen::MatrixXi FO;
+    igl::connect_boundary_to_infinity(F,(int)V.rows(),FO);
+    F.swap(FO);
+  }
+  V.conservativeResize(V.rows()+1,V.cols());
+  V.row(V.rows()-1).setConstant(std::numeric_limits<double>::infinity());
+  typedef IndexedPriorityQueue<> PQ;
+  bool ret = decimate<PQ>(
+    std::move(V),
+    std::move(F),
     shortest_edge_and_midpoint,
-    max_faces_stopping_condition(m,orig_m,max_m),
+    max_faces_stopping_condition<PQ>(m,orig_m,max_m),
     U,
     G,
     J,
@@ -273,10 +438,201 @@ IGL_INLINE bool igl::decimate(
   Eigen::VectorXi & I
   )
 {
+  typedef SetPriorityQueue PQ;
+  return decimate<PQ>(
+    OV,OF,
+    cost_and_placement,
+    [&stopping_condition](
+      const Eigen::MatrixXd & V,
+      const Eigen::MatrixXi & F,
+      const Eigen::MatrixXi & E,
+      const Eigen::VectorXi & EMAP,
+      const Eigen::MatrixXi & EF,
+      const Eigen::MatrixXi & EI,
+      const PQ & Q,
+      const Eigen::MatrixXd & C,
+      const int e,
+      const int e1,
+      const int e2,
+      const int f1,
+      const int f2)->bool
+    {
+      return stopping_condition(
+        V,F,E,EMAP,EF,EI,Q.set(),Q.iterators(),C,e,e1,e2,f1,f2);
+    },
+    [&pre_collapse](
+      const Eigen::MatrixXd & V,
+      const Eigen::MatrixXi & F,
+      const Eigen::MatrixXi & E,
+      const Eigen::VectorXi & EMAP,
+      const Eigen::MatrixXi & EF,
+      const Eigen::MatrixXi & EI,
+      const PQ & Q,
+      const Eigen::MatrixXd & C,
+      const int e)->bool
+    {
+      return pre_collapse(V,F,E,EMAP,EF,EI,Q.set(),Q.iterators(),C,e);
+    },
+    [&post_collapse](
+      const Eigen::MatrixXd & V,
+      const Eigen::MatrixXi & F,
+      const Eigen::MatrixXi & E,
+      const Eigen::VectorXi & EMAP,
+      const Eigen::MatrixXi & EF,
+      const Eigen::MatrixXi & EI,
+      const PQ & Q,
+      const Eigen::MatrixXd & C,
+      const int e,
+      const int e1,
+      const int e2,
+      const int f1,
+      const int f2,
+      const bool collapsed)->void
+    {
+      post_collapse(
+        V,F,E,EMAP,EF,EI,Q.set(),Q.iterators(),C,e,e1,e2,f1,f2,collapsed);
+    },
+    OE,OEMAP,OEF,OEI,
+    U,G,J,I);
+}
 
-  // Decimate 1
-  using namespace Eigen;
-  using namespace std;
+template <typename PriorityQueue>
+IGL_INLINE bool igl::decimate(
+  const Eigen::MatrixXd & OV,
+  const Eigen::MatrixXi & OF,
+  const typename igl::decimate_callback_types<PriorityQueue>::cost_and_placement
+    & cost_and_placement,
+  const typename igl::decimate_callback_types<PriorityQueue>::stopping_condition
+    & stopping_condition,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
+{
+  const auto always_try = [](
+    const Eigen::MatrixXd &                                         ,/*V*/
+    const Eigen::MatrixXi &                                         ,/*F*/
+    const Eigen::MatrixXi &                                         ,/*E*/
+    const Eigen::VectorXi &                                         ,/*EMAP*/
+    const Eigen::MatrixXi &                                         ,/*EF*/
+    const Eigen::MatrixXi &                                         ,/*EI*/
+    const PriorityQueue &                                           ,/*Q*/
+    const Eigen::MatrixXd &                                         ,/*C*/
+    const int                                                        /*e*/
+    ) -> bool { return true;};
+  const auto never_care = [](
+    const Eigen::MatrixXd &                                         ,   /*V*/
+    const Eigen::MatrixXi &                                         ,   /*F*/
+    const Eigen::MatrixXi &                                         ,   /*E*/
+    const Eigen::VectorXi &                                         ,/*EMAP*/
+    const Eigen::MatrixXi &                                         ,  /*EF*/
+    const Eigen::MatrixXi &                                         ,  /*EI*/
+    const PriorityQueue &                                           ,   /*Q*/
+    const Eigen::MatrixXd &                                         ,   /*C*/
+    const int                                                       ,   /*e*/
+    const int                                                       ,  /*e1*/
+    const int                                                       ,  /*e2*/
+    const int                                                       ,  /*f1*/
+    const int                                                       ,  /*f2*/
+    const bool                                                  /*collapsed*/
+    )-> void { };
+  return igl::decimate<PriorityQueue>(
+    OV,OF,cost_and_placement,stopping_condition,always_try,never_care,U,G,J,I);
+}
+
+template <typename PriorityQueue>
+IGL_INLINE bool igl::decimate(
+  Eigen::MatrixXd && V,
+  Eigen::MatrixXi && F,
+  const typename igl::decimate_callback_types<PriorityQueue>::cost_and_placement
+    & cost_and_placement,
+  const typename igl::decimate_callback_types<PriorityQueue>::stopping_condition
+    & stopping_condition,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
+{
+  const auto always_try = [](
+    const Eigen::MatrixXd &                                         ,/*V*/
+    const Eigen::MatrixXi &                                         ,/*F*/
+    const Eigen::MatrixXi &                                         ,/*E*/
+    const Eigen::VectorXi &                                         ,/*EMAP*/
+    const Eigen::MatrixXi &                                         ,/*EF*/
+    const Eigen::MatrixXi &                                         ,/*EI*/
+    const PriorityQueue &                                           ,/*Q*/
+    const Eigen::MatrixXd &                                         ,/*C*/
+    const int                                                        /*e*/
+    ) -> bool { return true;};
+  const auto never_care = [](
+    const Eigen::MatrixXd &                                         ,   /*V*/
+    const Eigen::MatrixXi &                                         ,   /*F*/
+    const Eigen::MatrixXi &                                         ,   /*E*/
+    const Eigen::VectorXi &                                         ,/*EMAP*/
+    const Eigen::MatrixXi &                                         ,  /*EF*/
+    const Eigen::MatrixXi &                                         ,  /*EI*/
+    const PriorityQueue &                                           ,   /*Q*/
+    const Eigen::MatrixXd &                                         ,   /*C*/
+    const int                                                       ,   /*e*/
+    const int                                                       ,  /*e1*/
+    const int                                                       ,  /*e2*/
+    const int                                                       ,  /*f1*/
+    const int                                                       ,  /*f2*/
+    const bool                                                  /*collapsed*/
+    )-> void { };
+  return igl::decimate<PriorityQueue>(
+    std::move(V),std::move(F),
+    cost_and_placement,stopping_condition,always_try,never_care,U,G,J,I);
+}
+
+template <typename PriorityQueue>
+IGL_INLINE bool igl::decimate(
+  const Eigen::MatrixXd & OV,
+  const Eigen::MatrixXi & OF,
+  const typename igl::decimate_callback_types<PriorityQueue>::cost_and_placement
+    & cost_and_placement,
+  const typename igl::decimate_callback_types<PriorityQueue>::stopping_condition
+    & stopping_condition,
+  const typename igl::decimate_callback_types<PriorityQueue>::pre_collapse
+    & pre_collapse,
+  const typename igl::decimate_callback_types<PriorityQueue>::post_collapse
+    & post_collapse,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
+{
+  Eigen::VectorXi EMAP;
+  Eigen::MatrixXi E,EF,EI;
+  edge_flaps(OF,E,EMAP,EF,EI);
+  return igl::decimate<PriorityQueue>(
+    OV,OF,
+    cost_and_placement,stopping_condition,pre_collapse,post_collapse,
+    E,EMAP,EF,EI,
+    U,G,J,I);
+}
+
+template <typename PriorityQueue>
+IGL_INLINE bool igl::decimate(
+  const Eigen::MatrixXd & OV,
+  const Eigen::MatrixXi & OF,
+  const typename igl::decimate_callback_types<PriorityQueue>::cost_and_placement
+    & cost_and_placement,
+  const typename igl::decimate_callback_types<PriorityQueue>::stopping_condition
+    & stopping_condition,
+  const typename igl::decimate_callback_types<PriorityQueue>::pre_collapse
+    & pre_collapse,
+  const typename igl::decimate_callback_types<PriorityQueue>::post_collapse
+    & post_collapse,
+  const Eigen::MatrixXi & OE,
+  const Eigen::VectorXi & OEMAP,
+  const Eigen::MatrixXi & OEF,
+  const Eigen::MatrixXi & OEI,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
+{
   // Working copies
   Eigen::MatrixXd V = OV;
   Eigen::MatrixXi F = OF;
@@ -284,75 +640,71 @@ IGL_INLINE bool igl::decimate(
   Eigen::VectorXi EMAP = OEMAP;
   Eigen::MatrixXi EF = OEF;
   Eigen::MatrixXi EI = OEI;
-  typedef std::set<std::pair<double,int> > PriorityQueue;
-  PriorityQueue Q;
-  std::vector<PriorityQueue::iterator > Qit;
-  Qit.resize(E.rows());
-  // If an edge were collapsed, we'd collapse it to these points:
-  MatrixXd C(E.rows(),V.cols());
-  for(int e = 0;e<E.rows();e++)
-  {
-    double cost = e;
-    RowVectorXd p(1,3);
-    cost_and_placement(e,V,F,E,EMAP,EF,EI,cost,p);
-    C.row(e) = p;
-    Qit[e] = Q.insert(std::pair<double,int>(cost,e)).first;
-  }
-  int prev_e = -1;
-  bool clean_finish = false;
+  return decimate_internal::decimate_in_place<PriorityQueue>(
+    V,F,cost_and_placement,stopping_condition,pre_collapse,post_collapse,
+    E,EMAP,EF,EI,true,U,G,J,I);
+}
 
-  while(true)
-  {
-    if(Q.empty())
-    {
-      break;
-    }
-    if(Q.begin()->first == std::numeric_limits<double>::infinity())
-    {
-      // min cost edge is infinite cost
-      break;
-    }
-    int e,e1,e2,f1,f2;
-    if(collapse_edge(
-       cost_and_placement, pre_collapse, post_collapse,
-       V,F,E,EMAP,EF,EI,Q,Qit,C,e,e1,e2,f1,f2))
-    {
-      if(stopping_condition(V,F,E,EMAP,EF,EI,Q,Qit,C,e,e1,e2,f1,f2))
-      {
-        clean_finish = true;
-        break;
-      }
-    }else
-    {
-      if(prev_e == e)
-      {
-        assert(false && "Edge collapse no progress... bad stopping condition?");
-        break;
-      }
-      // Edge was not collapsed... must have been invalid. collapse_edge should
-      // have updated its cost to inf... continue
-    }
-    prev_e = e;
-  }
-  // remove all IGL_COLLAPSE_EDGE_NULL faces
-  MatrixXi F2(F.rows(),3);
-  J.resize(F.rows());
-  int m = 0;
-  for(int f = 0;f<F.rows();f++)
-  {
-    if(
-      F(f,0) != IGL_COLLAPSE_EDGE_NULL || 
-      F(f,1) != IGL_COLLAPSE_EDGE_NULL || 
-      F(f,2) != IGL_COLLAPSE_EDGE_NULL)
-    {
-      F2.row(m) = F.row(f);
-      J(m) = f;
-      m++;
-    }
-  }
-  F2.conservativeResize(m,F2.cols());
-  J.conservativeResize(m);
-  VectorXi _1;
-  remove_unreferenced(V,F2,U,G,_1,I);
-  return clean_finish;
+template <typename PriorityQueue>
+IGL_INLINE bool igl::decimate(
+  Eigen::MatrixXd && V,
+  Eigen::MatrixXi && F,
+  const typename igl::decimate_callback_types<PriorityQueue>::cost_and_placement
+    & cost_and_placement,
+  const typename igl::decimate_callback_types<PriorityQueue>::stopping_condition
+    & stopping_condition,
+  const typename igl::decimate_callback_types<PriorityQueue>::pre_collapse
+    & pre_collapse,
+  const typename igl::decimate_callback_types<PriorityQueue>::post_collapse
+    & post_collapse,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
+{
+  Eigen::VectorXi EMAP;
+  Eigen::MatrixXi E,EF,EI;
+  edge_flaps(F,E,EMAP,EF,EI);
+  return igl::decimate<PriorityQueue>(
+    std::move(V),std::move(F),
+    cost_and_placement,stopping_condition,pre_collapse,post_collapse,
+    std::move(E),std::move(EMAP),std::move(EF),std::move(EI),
+    U,G,J,I);
+}
+
+template <typename PriorityQueue>
+IGL_INLINE bool igl::decimate(
+  Eigen::MatrixXd && V,
+  Eigen::MatrixXi && F,
+  const typename igl::decimate_callback_types<PriorityQueue>::cost_and_placement
+    & cost_and_placement,
+  const typename igl::decimate_callback_types<PriorityQueue>::stopping_condition
+    & stopping_condition,
+  const typename igl::decimate_callback_types<PriorityQueue>::pre_collapse
+    & pre_collapse,
+  const typename igl::decimate_callback_types<PriorityQueue>::post_collapse
+    & post_collapse,
+  Eigen::MatrixXi && E,
+  Eigen::VectorXi && EMAP,
+  Eigen::MatrixXi && EF,
+  Eigen::MatrixXi && EI,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
+{
+  return decimate_internal::decimate_in_place<PriorityQueue>(
+    V,F,cost_and_placement,stopping_condition,pre_collapse,post_collapse,
+    E,EMAP,EF,EI,false,U,G,J,I);
 }
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template bool igl::decimate<igl::IndexedPriorityQueue<4> >(Eigen::MatrixXd const&, Eigen::MatrixXi const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::cost_and_placement const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::stopping_condition const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::VectorXi&);
+template bool igl::decimate<igl::IndexedPriorityQueue<4> >(Eigen::MatrixXd const&, Eigen::MatrixXi const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::cost_and_placement const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::stopping_condition const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::pre_collapse const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::post_collapse const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::VectorXi&);
+template bool igl::decimate<igl::IndexedPriorityQueue<4> >(Eigen::MatrixXd const&, Eigen::MatrixXi const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::cost_and_placement const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::stopping_condition const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::pre_collapse const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::post_collapse const&, Eigen::MatrixXi const&, Eigen::VectorXi const&, Eigen::MatrixXi const&, Eigen::MatrixXi const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::VectorXi&);
+template bool igl::decimate<igl::SetPriorityQueue>(Eigen::MatrixXd const&, Eigen::MatrixXi const&, igl::decimate_callback_types<igl::SetPriorityQueue>::cost_and_placement const&, igl::decimate_callback_types<igl::SetPriorityQueue>::stopping_condition const&, igl::decimate_callback_types<igl::SetPriorityQueue>::pre_collapse const&, igl::decimate_callback_types<igl::SetPriorityQueue>::post_collapse const&, Eigen::MatrixXi const&, Eigen::VectorXi const&, Eigen::MatrixXi const&, Eigen::MatrixXi const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::VectorXi&);
+template bool igl::decimate<igl::IndexedPriorityQueue<4> >(Eigen::MatrixXd&&, Eigen::MatrixXi&&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::cost_and_placement const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::stopping_condition const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::VectorXi&);
+template bool igl::decimate<igl::IndexedPriorityQueue<4> >(Eigen::MatrixXd&&, Eigen::MatrixXi&&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::cost_and_placement const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::stopping_condition const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::pre_collapse const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::post_collapse const&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::VectorXi&);
+template bool igl::decimate<igl::IndexedPriorityQueue<4> >(Eigen::MatrixXd&&, Eigen::MatrixXi&&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::cost_and_placement const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::stopping_condition const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::pre_collapse const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::post_collapse const&, Eigen::MatrixXi&&, Eigen::VectorXi&&, Eigen::MatrixXi&&, Eigen::MatrixXi&&, Eigen::MatrixXd&, Eigen::MatrixXi&, Eigen::VectorXi&, Eigen::VectorXi&);
+#endif
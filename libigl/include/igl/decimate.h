@@ -8,6 +8,7 @@
 #ifndef IGL_DECIMATE_H
 #define IGL_DECIMATE_H
 #include "igl_inline.h"
+#include "decimate_callback_types.h"
 #include <Eigen/Core>
 #include <vector>
 #include <set>
@@ -35,6 +36,21 @@ namespace igl
     Eigen::MatrixXi & G,
     Eigen::VectorXi & J,
     Eigen::VectorXi & I);
+  // Same as above but consumes the input mesh: (V,F) are used as the working
+  // mesh of the decimation (and left in an unspecified state) instead of
+  // being copied, placements are not stored and the output is compacted in
+  // place. Use this to save memory when the input is no longer needed, e.g.,
+  //
+  //   igl::decimate(std::move(V),std::move(F),max_m,U,G,J,I);
+  //
+  IGL_INLINE bool decimate(
+    Eigen::MatrixXd && V,
+    Eigen::MatrixXi && F,
+    const size_t max_m,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
   // Inputs:
   //   V  #V by dim list of vertex positions
   //   F  #F by 3 list of face indices into V.
@@ -246,6 +262,124 @@ namespace igl
     Eigen::VectorXi & J,
     Eigen::VectorXi & I);
 
+  // Versions templated on the type of the collapse queue. The queue type is
+  // not deduced and must be given explicitly, e.g.,
+  //
+  //   typedef igl::IndexedPriorityQueue<> PQ;
+  //   igl::decimate<PQ>(V,F,cost_and_placement,
+  //     igl::max_faces_stopping_condition<PQ>(m,orig_m,max_m),U,G,J,I);
+  //
+  // Callbacks receive the queue as a single object in place of (Q,Qit) (see
+  // decimate_callback_types.h). The std::set versions above are implemented
+  // by calling these with igl::SetPriorityQueue.
+  //
+  // Templates:
+  //   PriorityQueue  type of queue of (cost,edge) pairs providing the
+  //     interface of igl::IndexedPriorityQueue
+  template <typename PriorityQueue>
+  IGL_INLINE bool decimate(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const typename decimate_callback_types<PriorityQueue>::cost_and_placement
+      & cost_and_placement,
+    const typename decimate_callback_types<PriorityQueue>::stopping_condition
+      & stopping_condition,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
+  template <typename PriorityQueue>
+  IGL_INLINE bool decimate(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const typename decimate_callback_types<PriorityQueue>::cost_and_placement
+      & cost_and_placement,
+    const typename decimate_callback_types<PriorityQueue>::stopping_condition
+      & stopping_condition,
+    const typename decimate_callback_types<PriorityQueue>::pre_collapse
+      & pre_collapse,
+    const typename decimate_callback_types<PriorityQueue>::post_collapse
+      & post_collapse,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
+  template <typename PriorityQueue>
+  IGL_INLINE bool decimate(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const typename decimate_callback_types<PriorityQueue>::cost_and_placement
+      & cost_and_placement,
+    const typename decimate_callback_types<PriorityQueue>::stopping_condition
+      & stopping_condition,
+    const typename decimate_callback_types<PriorityQueue>::pre_collapse
+      & pre_collapse,
+    const typename decimate_callback_types<PriorityQueue>::post_collapse
+      & post_collapse,
+    const Eigen::MatrixXi & E,
+    const Eigen::VectorXi & EMAP,
+    const Eigen::MatrixXi & EF,
+    const Eigen::MatrixXi & EI,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
+  // Move-in versions of the above: the working mesh and connectivity are the
+  // inputs themselves (no copies, inputs are left in an unspecified state).
+  // The #E by dim list of placements C is not stored: the placement of an
+  // edge is recomputed with cost_and_placement when the edge is popped from
+  // the queue (so cost_and_placement must only depend on the edge's
+  // neighborhood and on state updated through post_collapse, as do
+  // shortest_edge_and_midpoint and the qslim callbacks) and callbacks receive
+  // an empty C. Faces and vertices of the output are compacted in place.
+  template <typename PriorityQueue>
+  IGL_INLINE bool decimate(
+    Eigen::MatrixXd && V,
+    Eigen::MatrixXi && F,
+    const typename decimate_callback_types<PriorityQueue>::cost_and_placement
+      & cost_and_placement,
+    const typename decimate_callback_types<PriorityQueue>::stopping_condition
+      & stopping_condition,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
+  template <typename PriorityQueue>
+  IGL_INLINE bool decimate(
+    Eigen::MatrixXd && V,
+    Eigen::MatrixXi && F,
+    const typename decimate_callback_types<PriorityQueue>::cost_and_placement
+      & cost_and_placement,
+    const typename decimate_callback_types<PriorityQueue>::stopping_condition
+      & stopping_condition,
+    const typename decimate_callback_types<PriorityQueue>::pre_collapse
+      & pre_collapse,
+    const typename decimate_callback_types<PriorityQueue>::post_collapse
+      & post_collapse,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
+  template <typename PriorityQueue>
+  IGL_INLINE bool decimate(
+    Eigen::MatrixXd && V,
+    Eigen::MatrixXi && F,
+    const typename decimate_callback_types<PriorityQueue>::cost_and_placement
+      & cost_and_placement,
+    const typename decimate_callback_types<PriorityQueue>::stopping_condition
+      & stopping_condition,
+    const typename decimate_callback_types<PriorityQueue>::pre_collapse
+      & pre_collapse,
+    const typename decimate_callback_types<PriorityQueue>::post_collapse
+      & post_collapse,
+    Eigen::MatrixXi && E,
+    Eigen::VectorXi && EMAP,
+    Eigen::MatrixXi && EF,
+    Eigen::MatrixXi && EI,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
 }
 
 #ifndef IGL_STATIC_LIBRARY
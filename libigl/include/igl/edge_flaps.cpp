@@ -6,7 +6,8 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "edge_flaps.h"
-#include "unique_edge_map.h"
+#include "all_edges.h"
+#include "unique_simplices.h"
 #include <vector>
 #include <cassert>
 
@@ -50,9 +51,13 @@ IGL_INLINE void igl::edge_flaps(
   Eigen::MatrixXi & EF,
   Eigen::MatrixXi & EI)
 {
+  // Same E and EMAP as unique_edge_map, without building its (unused here)
+  // list of lists uE2E
   Eigen::MatrixXi allE;
-  std::vector<std::vector<int> > uE2E;
-  igl::unique_edge_map(F,allE,E,EMAP,uE2E);
+  Eigen::VectorXi _1;
+  igl::all_edges(F,allE);
+  igl::unique_simplices(allE,E,_1,EMAP);
+  allE.resize(0,2);
   // Const-ify to call overload
   const auto & cE = E;
   const auto & cEMAP = EMAP;
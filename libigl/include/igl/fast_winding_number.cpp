@@ -0,0 +1,310 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2015 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "fast_winding_number.h"
+#include "PI.h"
+#include "morton_order.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace igl
+{
+  // Build hierarchy and per-node expansions of data.V, data.F, data.N
+  // (already filled by one of the fast_winding_number_precompute overloads)
+  IGL_INLINE void fast_winding_number_expansions(FastWindingNumberData & data)
+  {
+    using namespace Eigen;
+    using namespace std;
+    typedef FastWindingNumberData::Expansion Expansion;
+    data.tree.init(data.V,data.F,data.leaf_size);
+    const int m = data.F.rows();
+    const int nn = data.tree.size();
+    data.expansions.resize(nn);
+    if(nn == 0)
+    {
+      return;
+    }
+    // Per-primitive centroids and covariances (about centroid, per unit area)
+    MatrixX3d G(m,3);
+    vector<Matrix3d> C(data.triangles ? m : 0);
+    parallel_for(m,[&](const int e)
+    {
+      if(data.triangles)
+      {
+        G.row(e) =
+          (data.V.row(data.F(e,0))+
+           data.V.row(data.F(e,1))+
+           data.V.row(data.F(e,2)))/3.;
+        C[e].setZero();
+        for(int c = 0;c<3;c++)
+        {
+          const RowVector3d u = data.V.row(data.F(e,c))-G.row(e);
+          C[e] += u.transpose()*u;
+        }
+        C[e] /= 12.;
+      }else
+      {
+        G.row(e) = data.V.row(data.F(e,0));
+      }
+    },1000);
+    // Nodes are stored depth first and each subtree's primitives are
+    // contiguous, so ranges can be gathered from the back
+    const vector<LinearAABB<MatrixXd,3>::Node> & nodes = data.tree.nodes();
+    const vector<int> & prims = data.tree.primitives();
+    vector<int> begin(nn),end(nn);
+    for(int i = nn-1;i>=0;i--)
+    {
+      if(data.tree.is_leaf(i))
+      {
+        begin[i] = nodes[i].offset;
+        end[i] = nodes[i].offset+nodes[i].count;
+      }else
+      {
+        begin[i] = begin[i+1];
+        end[i] = end[nodes[i].offset];
+      }
+    }
+    parallel_for(nn,[&](const int i)
+    {
+      Expansion & ex = data.expansions[i];
+      double area = 0;
+      ex.center.setZero();
+      for(int k = begin[i];k<end[i];k++)
+      {
+        const int e = prims[k];
+        const double a = data.N.row(e).norm();
+        area += a;
+        ex.center += a*G.row(e).transpose();
+      }
+      if(area > 0)
+      {
+        ex.center /= area;
+      }else
+      {
+        // Degenerate: fall back to unweighted center
+        for(int k = begin[i];k<end[i];k++)
+        {
+          ex.center += G.row(prims[k]).transpose();
+        }
+        ex.center /= double(end[i]-begin[i]);
+      }
+      ex.radius = 0;
+      ex.zeroth.setZero();
+      ex.first.setZero();
+      for(int j = 0;j<3;j++)
+      {
+        ex.second[j].setZero();
+      }
+      for(int k = begin[i];k<end[i];k++)
+      {
+        const int e = prims[k];
+        for(int c = 0;c<data.F.cols();c++)
+        {
+          ex.radius = max(ex.radius,
+            (data.V.row(data.F(e,c)).transpose()-ex.center).norm());
+        }
+        const Vector3d an = data.N.row(e).transpose();
+        const Vector3d d = G.row(e).transpose()-ex.center;
+        ex.zeroth += an;
+        ex.first += an*d.transpose();
+        // Integral of (x-center)(x-center)' over triangle divided by its area
+        Matrix3d dd = d*d.transpose();
+        if(data.triangles)
+        {
+          dd += C[e];
+        }
+        for(int j = 0;j<3;j++)
+        {
+          ex.second[j] += 0.5*an(j)*dd;
+        }
+      }
+    },100);
+  }
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::fast_winding_number_precompute(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::PlainObjectBase<DerivedF> & F,
+  FastWindingNumberData & data)
+{
+  assert(V.cols() == 3 && "V should be 3D");
+  assert(F.cols() == 3 && "F should contain triangles");
+  data.triangles = true;
+  data.V = V.template cast<double>();
+  data.F = F.template cast<int>();
+  data.N.resize(F.rows(),3);
+  for(int f = 0;f<F.rows();f++)
+  {
+    const Eigen::RowVector3d e1 = data.V.row(data.F(f,1))-data.V.row(data.F(f,0));
+    const Eigen::RowVector3d e2 = data.V.row(data.F(f,2))-data.V.row(data.F(f,0));
+    data.N.row(f) = 0.5*e1.cross(e2);
+  }
+  fast_winding_number_expansions(data);
+}
+
+template <typename DerivedP, typename DerivedN, typename DerivedA>
+IGL_INLINE void igl::fast_winding_number_precompute(
+  const Eigen::PlainObjectBase<DerivedP> & P,
+  const Eigen::PlainObjectBase<DerivedN> & N,
+  const Eigen::PlainObjectBase<DerivedA> & A,
+  FastWindingNumberData & data)
+{
+  assert(P.cols() == 3 && "P should be 3D");
+  assert(N.rows() == P.rows() && N.cols() == 3 && "N should match P");
+  assert(A.size() == P.rows() && "A should match P");
+  data.triangles = false;
+  data.V = P.template cast<double>();
+  data.F.resize(P.rows(),1);
+  data.N.resize(P.rows(),3);
+  for(int p = 0;p<P.rows();p++)
+  {
+    data.F(p,0) = p;
+    data.N.row(p) = double(A(p))*N.row(p).template cast<double>();
+  }
+  fast_winding_number_expansions(data);
+}
+
+IGL_INLINE double igl::fast_winding_number(
+  const FastWindingNumberData & data,
+  const Eigen::RowVector3d & q)
+{
+  using namespace Eigen;
+  using namespace std;
+  typedef FastWindingNumberData::Expansion Expansion;
+  const int nn = data.tree.size();
+  if(nn == 0)
+  {
+    return 0;
+  }
+  const vector<LinearAABB<MatrixXd,3>::Node> & nodes = data.tree.nodes();
+  const vector<int> & prims = data.tree.primitives();
+  const double beta2 = data.beta*data.beta;
+  double w = 0;
+  // Median split keeps the depth logarithmic, so this never overflows
+  int stack[128];
+  int top = 0;
+  stack[top++] = 0;
+  while(top > 0)
+  {
+    const int i = stack[--top];
+    const Expansion & ex = data.expansions[i];
+    const Vector3d x = q.transpose()-ex.center;
+    const double r2 = x.squaredNorm();
+    if(r2 > beta2*ex.radius*ex.radius)
+    {
+      // Far field: Taylor expansion of dipole sum about center
+      const double r = sqrt(r2);
+      const double r3 = r2*r;
+      const double r5 = r3*r2;
+      // Gradient of Green's function G(x) = 1/(4 pi |x|)
+      double v = -ex.zeroth.dot(x)/r3;
+      if(data.expansion_order >= 1)
+      {
+        // - sum_jk H_jk first_jk, H = (3xx'/r^5 - I/r^3)
+        v -= 3.*x.dot(ex.first*x)/r5 - ex.first.trace()/r3;
+      }
+      if(data.expansion_order >= 2)
+      {
+        // sum_jkl T_jkl second_jkl, T = third derivatives of 1/|x|
+        const double r7 = r5*r2;
+        double xSx = 0,Sxj = 0,trS = 0;
+        for(int j = 0;j<3;j++)
+        {
+          const Vector3d Sx = ex.second[j]*x;
+          xSx += x(j)*x.dot(Sx);
+          Sxj += Sx(j);
+          trS += x(j)*ex.second[j].trace();
+        }
+        v += -15.*xSx/r7 + 3.*(2.*Sxj+trS)/r5;
+      }
+      w += v/(4.*PI);
+    }else if(nodes[i].count > 0)
+    {
+      // Near field leaf: exact
+      for(int k = nodes[i].offset;k<nodes[i].offset+nodes[i].count;k++)
+      {
+        const int e = prims[k];
+        if(data.triangles)
+        {
+          const Vector3d a = data.V.row(data.F(e,0))-q;
+          const Vector3d b = data.V.row(data.F(e,1))-q;
+          const Vector3d c = data.V.row(data.F(e,2))-q;
+          const double la = a.norm(), lb = b.norm(), lc = c.norm();
+          // [Van Oosterom & Strackee 1983]
+          w += atan2(
+            a.dot(b.cross(c)),
+            la*lb*lc + a.dot(b)*lc + b.dot(c)*la + c.dot(a)*lb)/(2.*PI);
+        }else
+        {
+          const Vector3d d = data.V.row(e)-q;
+          const double l2 = d.squaredNorm();
+          if(l2 > 0)
+          {
+            w += data.N.row(e).dot(d)/(4.*PI*l2*sqrt(l2));
+          }
+        }
+      }
+    }else
+    {
+      assert(top+2 <= 128 && "Hierarchy too deep");
+      stack[top++] = nodes[i].offset;
+      stack[top++] = i+1;
+    }
+  }
+  return w;
+}
+
+template <typename DerivedQ, typename DerivedW>
+IGL_INLINE void igl::fast_winding_number(
+  const FastWindingNumberData & data,
+  const Eigen::PlainObjectBase<DerivedQ> & Q,
+  Eigen::PlainObjectBase<DerivedW> & W)
+{
+  using namespace Eigen;
+  assert(Q.cols() == 3 && "Q should be 3D");
+  const int nq = Q.rows();
+  W.resize(nq,1);
+  // Visit queries along a space filling curve so that consecutive queries
+  // traverse similar parts of the hierarchy
+  VectorXi I;
+  morton_order(Q,I);
+  parallel_for(nq,[&](const int k)
+  {
+    const int q = I(k);
+    W(q) = fast_winding_number(data,RowVector3d(
+      double(Q(q,0)),double(Q(q,1)),double(Q(q,2))));
+  },1000);
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedQ,
+  typename DerivedW>
+IGL_INLINE void igl::fast_winding_number(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::PlainObjectBase<DerivedF> & F,
+  const Eigen::PlainObjectBase<DerivedQ> & Q,
+  const double beta,
+  Eigen::PlainObjectBase<DerivedW> & W)
+{
+  FastWindingNumberData data;
+  data.beta = beta;
+  fast_winding_number_precompute(V,F,data);
+  fast_winding_number(data,Q,W);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::fast_winding_number_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::FastWindingNumberData&);
+template void igl::fast_winding_number_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, igl::FastWindingNumberData&);
+template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::FastWindingNumberData const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+#endif
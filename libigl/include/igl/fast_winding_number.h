@@ -0,0 +1,140 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2015 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_FAST_WINDING_NUMBER_H
+#define IGL_FAST_WINDING_NUMBER_H
+#include "igl_inline.h"
+#include "LinearAABB.h"
+#include <Eigen/Core>
+#include <vector>
+namespace igl
+{
+  // Precomputed data for approximating generalized winding numbers of a
+  // triangle soup or of an oriented point cloud by far-field (dipole) Taylor
+  // expansions ["Fast Winding Numbers for Soups and Clouds", Barill et al.
+  // 2018].
+  //
+  // Every primitive is treated as a dipole of strength a*n. Each node of a
+  // flattened bounding volume hierarchy stores the 0th, 1st and 2nd order
+  // moments of the dipoles below it about their area-weighted center. A node
+  // whose ball (center,radius) is farther than beta*radius from a query is
+  // evaluated by its expansion, otherwise it is opened. Leaves are summed
+  // exactly (solid angles of triangles) or as point dipoles (clouds).
+  struct FastWindingNumberData
+  {
+    // Far-field expansion of one hierarchy node
+    struct Expansion
+    {
+      // Area-weighted center of dipoles and radius of enclosing ball
+      Eigen::Vector3d center;
+      double radius;
+      // zeroth = sum of a n
+      Eigen::Vector3d zeroth;
+      // first(j,k) = sum of a n_j d_k, d = p - center
+      Eigen::Matrix3d first;
+      // second[j](k,l) = 1/2 sum of a n_j d_k d_l (integrated over triangles)
+      Eigen::Matrix3d second[3];
+    };
+    // Accuracy parameter: nodes are expanded if farther than beta times their
+    // radius from the query. Larger is more accurate and slower {2}
+    double beta;
+    // Highest order of Taylor expansion used (0, 1 or 2) {2}
+    int expansion_order;
+    // Maximum number of primitives per leaf {8}
+    int leaf_size;
+    // Whether primitives are triangles of (V,F) (as opposed to points)
+    bool triangles;
+    // Copy of input. For point clouds V=P and F=[0,...,#P-1]'. N holds
+    // area-weighted normals (half cross products for triangles)
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi F;
+    Eigen::MatrixXd N;
+    // Hierarchy and per-node expansions
+    igl::LinearAABB<Eigen::MatrixXd,3> tree;
+    std::vector<Expansion> expansions;
+    FastWindingNumberData():
+      beta(2),expansion_order(2),leaf_size(8),triangles(true),
+      V(),F(),N(),tree(),expansions()
+    {}
+  };
+  // Precompute hierarchy and expansions for a triangle mesh (soup).
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of triangle indices into V
+  //   data  with leaf_size and expansion_order set (see above)
+  // Outputs:
+  //   data  precomputed data
+  template <typename DerivedV, typename DerivedF>
+  IGL_INLINE void fast_winding_number_precompute(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::PlainObjectBase<DerivedF> & F,
+    FastWindingNumberData & data);
+  // Precompute hierarchy and expansions for an oriented point cloud.
+  //
+  // Inputs:
+  //   P  #P by 3 list of point positions
+  //   N  #P by 3 list of unit point normals
+  //   A  #P list of areas associated with each point (e.g., Voronoi area of
+  //     point in its tangent plane)
+  //   data  with leaf_size and expansion_order set (see above)
+  // Outputs:
+  //   data  precomputed data
+  template <typename DerivedP, typename DerivedN, typename DerivedA>
+  IGL_INLINE void fast_winding_number_precompute(
+    const Eigen::PlainObjectBase<DerivedP> & P,
+    const Eigen::PlainObjectBase<DerivedN> & N,
+    const Eigen::PlainObjectBase<DerivedA> & A,
+    FastWindingNumberData & data);
+  // Approximate the winding number at a single query point.
+  //
+  // Inputs:
+  //   data  precomputed data
+  //   q  3-vector query point
+  // Returns approximate winding number
+  IGL_INLINE double fast_winding_number(
+    const FastWindingNumberData & data,
+    const Eigen::RowVector3d & q);
+  // Approximate winding numbers at many query points (in parallel).
+  //
+  // Inputs:
+  //   data  precomputed data
+  //   Q  #Q by 3 list of query points
+  // Outputs:
+  //   W  #Q list of approximate winding numbers
+  template <typename DerivedQ, typename DerivedW>
+  IGL_INLINE void fast_winding_number(
+    const FastWindingNumberData & data,
+    const Eigen::PlainObjectBase<DerivedQ> & Q,
+    Eigen::PlainObjectBase<DerivedW> & W);
+  // Convenience wrapper: precompute (with default parameters) and evaluate.
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of triangle indices into V
+  //   Q  #Q by 3 list of query points
+  //   beta  accuracy parameter (see above)
+  // Outputs:
+  //   W  #Q list of approximate winding numbers
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedQ,
+    typename DerivedW>
+  IGL_INLINE void fast_winding_number(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::PlainObjectBase<DerivedF> & F,
+    const Eigen::PlainObjectBase<DerivedQ> & Q,
+    const double beta,
+    Eigen::PlainObjectBase<DerivedW> & W);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "fast_winding_number.cpp"
+#endif
+
+#endif
@@ -11,7 +11,17 @@
 #include "verbose.h"
 #include "polar_dec.h"
 #include "polar_svd.h"
+#include "svd2x2.h"
+#include "svd3x3.h"
+#include "refine_svd3x3.h"
+#include "parallel_for.h"
 #include "C_STR.h"
+#ifdef __SSE__
+#  include "svd3x3_sse.h"
+#endif
+#ifdef __AVX__
+#  include "svd3x3_avx.h"
+#endif
 #include <iostream>
 
 template <typename DerivedS, typename DerivedD>
@@ -109,6 +119,83 @@ IGL_INLINE void igl::fit_rotations_planar(
   }
 }
 
+IGL_INLINE void igl::fit_rotations_SIMD(
+  const Eigen::MatrixXd & S,
+  Eigen::MatrixXd & R)
+{
+  const int dim = S.cols();
+  const int nr = S.rows()/dim;
+  assert(nr * dim == S.rows());
+  assert((dim == 2 || dim == 3) && "dim should be 2 or 3");
+
+  // resize output
+  R.resize(dim,dim*nr); // hopefully no op (should be already allocated)
+
+  if(dim == 2)
+  {
+    igl::parallel_for(nr,[&S,&R,nr](const int r)
+    {
+      Eigen::Matrix2d si,ui,vi;
+      Eigen::Vector2d _;
+      si << S(r,0), S(r,1), S(nr+r,0), S(nr+r,1);
+      // ui and vi are rotations so ui*vi' is the closest rotation
+      svd2x2(si,ui,_,vi);
+      R.block<2,2>(0,r*2) = (ui*vi.transpose()).transpose();
+    },1000);
+    return;
+  }
+
+#ifdef __AVX__
+  const int cStep = 8;
+#elif defined(__SSE__)
+  const int cStep = 4;
+#else
+  const int cStep = 1;
+#endif
+  const int num_batches = (nr+cStep-1)/cStep;
+  igl::parallel_for(num_batches,[&S,&R,nr](const int k)
+  {
+    Eigen::Matrix<float, 3*cStep, 3> siBig,U,V;
+    Eigen::Matrix<float, 3*cStep, 1> sigma;
+    Eigen::Matrix3d si[cStep];
+    for(int c = 0;c<cStep;c++)
+    {
+      const int r = k*cStep + c;
+      if(r < nr)
+      {
+        for(int i = 0;i<3;i++)
+        {
+          for(int j = 0;j<3;j++)
+          {
+            si[c](i,j) = S(i*nr+r,j);
+          }
+        }
+      }else
+      {
+        si[c].setIdentity();
+      }
+      // scaled to unit norm for single precision
+      const double scale = si[c].norm();
+      siBig.block(3*c,0,3,3) = (si[c]/(scale > 0 ? scale : 1.)).cast<float>();
+    }
+#ifdef __AVX__
+    svd3x3_avx(siBig,U,sigma,V);
+#elif defined(__SSE__)
+    svd3x3_sse(siBig,U,sigma,V);
+#else
+    svd3x3(siBig,U,sigma,V);
+#endif
+    for(int c = 0;c<cStep && k*cStep+c < nr;c++)
+    {
+      Eigen::Matrix3d ui = U.block(3*c,0,3,3).cast<double>();
+      Eigen::Matrix3d vi = V.block(3*c,0,3,3).cast<double>();
+      Eigen::Vector3d _;
+      refine_svd3x3(si[c],ui,_,vi);
+      // ui and vi are rotations so ui*vi' is the closest rotation
+      R.block<3,3>(0,(k*cStep+c)*3) = (ui*vi.transpose()).transpose();
+    }
+  },1000/cStep);
+}
 
 #ifdef __SSE__
 IGL_INLINE void igl::fit_rotations_SSE(
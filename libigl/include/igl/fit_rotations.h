@@ -44,6 +44,20 @@ namespace igl
   IGL_INLINE void fit_rotations_planar(
     const Eigen::PlainObjectBase<DerivedS> & S,
           Eigen::PlainObjectBase<DerivedD> & R);
+  // FIT_ROTATIONS_SIMD Double precision version of fit_rotations and
+  // fit_rotations_planar for large stacks: 3x3 SVDs are computed 8 (AVX), 4
+  // (SSE) or 1 at a time in single precision with svd3x3_avx, svd3x3_sse or
+  // svd3x3 and refined to double precision with refine_svd3x3, 2x2 SVDs in
+  // closed form with svd2x2, and batches are processed in parallel.
+  //
+  // Inputs:
+  //   S  nr*dim by dim stack of covariance matrices, dim = 2 or 3
+  // Outputs:
+  //   R  dim by dim * nr list of rotations
+  //
+  IGL_INLINE void fit_rotations_SIMD(
+    const Eigen::MatrixXd & S,
+          Eigen::MatrixXd & R);
 #ifdef __SSE__
   IGL_INLINE void fit_rotations_SSE( const Eigen::MatrixXf & S, Eigen::MatrixXf & R);
   IGL_INLINE void fit_rotations_SSE( const Eigen::MatrixXd & S, Eigen::MatrixXd & R);
@@ -12,6 +12,7 @@
 #include "per_face_normals.h"
 #include "volume.h"
 #include "doublearea.h"
+#include "sparse_assembly.h"
 
 template <typename DerivedV, typename DerivedF>
 IGL_INLINE void grad_tet(const Eigen::PlainObjectBase<DerivedV>&V,
@@ -84,33 +85,23 @@ IGL_INLINE void grad_tet(const Eigen::PlainObjectBase<DerivedV>&V,
       repmat([T(:,4);T(:,2);T(:,3);T(:,1)],3,1), ...
       repmat(A./(3*repmat(vol,4,1)),3,1).*N(:), ...
       3*m,n);*/
-  std::vector<Triplet<double> > G_t;
-  for (int i = 0; i < 4*m; i++) {
-    int T_j; // j indexes : repmat([T(:,4);T(:,2);T(:,3);T(:,1)],3,1)
-    switch (i/m) {
-      case 0:
-        T_j = 3;
-        break;
-      case 1:
-        T_j = 1;
-        break;
-      case 2:
-        T_j = 2;
-        break;
-      case 3:
-        T_j = 0;
-        break;
-    }
-    int i_idx = i%m;
-    int j_idx = T(i_idx,T_j);
-
-    double val_before_n = A(i)/(3*vol(i_idx));
-    G_t.push_back(Triplet<double>(0*m+i_idx, j_idx, val_before_n * N(i,0)));
-    G_t.push_back(Triplet<double>(1*m+i_idx, j_idx, val_before_n * N(i,1)));
-    G_t.push_back(Triplet<double>(2*m+i_idx, j_idx, val_before_n * N(i,2)));
-  }
-  G.resize(3*m,n);
-  G.setFromTriplets(G_t.begin(), G_t.end());
+  // Triplet 3*i+c (for i in [0,4*m) and c in [0,3)) is
+  // (c*m+i%m, T(i%m,T_j), A(i)/(3*vol(i%m))*N(i,c)) where T_j indexes
+  // repmat([T(:,4);T(:,2);T(:,3);T(:,1)],3,1)
+  const int T_j[4] = {3,1,2,0};
+  const auto ij = [&](const int t,int & r,int & c)
+  {
+    const int i = t/3;
+    r = (t%3)*m + i%m;
+    c = T(i%m,T_j[i/m]);
+  };
+  const auto value = [&](const int t)->double
+  {
+    const int i = t/3;
+    double val_before_n = A(i)/(3*vol(i%m));
+    return val_before_n * N(i,t%3);
+  };
+  igl::sparse_assembly(3*m,n,4*m*3,ij,value,G);
 }
 
 template <typename DerivedV, typename DerivedF>
@@ -172,53 +163,29 @@ IGL_INLINE void grad_tri(const Eigen::PlainObjectBase<DerivedV>&V,
     eperp13.row(i) *= norm13 / dblA;
   }
 
-  std::vector<int> rs;
-  rs.reserve(F.rows()*4*3);
-  std::vector<int> cs;
-  cs.reserve(F.rows()*4*3);
-  std::vector<double> vs;
-  vs.reserve(F.rows()*4*3);
-
-  // row indices
-  for(int r=0;r<3;r++)
+  // create sparse gradient operator matrix: triplet (r*4+j)*#F+i (for r in
+  // [0,3) and j in [0,4)) is the j-th entry of row r*#F+i
+  const int m = F.rows();
+  const int cs[4] = {1,0,2,0};
+  const auto ij = [&](const int t,int & r,int & c)
+  {
+    const int i = t%m;
+    r = (t/m/4)*m + i;
+    c = F(i,cs[t/m%4]);
+  };
+  const auto value = [&](const int t)->double
   {
-    for(int j=0;j<4;j++)
+    const int i = t%m;
+    const int r = t/m/4;
+    switch(t/m%4)
     {
-      for(int i=r*F.rows();i<(r+1)*F.rows();i++) rs.push_back(i);
+      case 0: return eperp13(i,r);
+      case 1: return -eperp13(i,r);
+      case 2: return eperp21(i,r);
+      default: return -eperp21(i,r);
     }
-  }
-
-  // column indices
-  for(int r=0;r<3;r++)
-  {
-    for(int i=0;i<F.rows();i++) cs.push_back(F(i,1));
-    for(int i=0;i<F.rows();i++) cs.push_back(F(i,0));
-    for(int i=0;i<F.rows();i++) cs.push_back(F(i,2));
-    for(int i=0;i<F.rows();i++) cs.push_back(F(i,0));
-  }
-
-  // values
-  for(int i=0;i<F.rows();i++) vs.push_back(eperp13(i,0));
-  for(int i=0;i<F.rows();i++) vs.push_back(-eperp13(i,0));
-  for(int i=0;i<F.rows();i++) vs.push_back(eperp21(i,0));
-  for(int i=0;i<F.rows();i++) vs.push_back(-eperp21(i,0));
-  for(int i=0;i<F.rows();i++) vs.push_back(eperp13(i,1));
-  for(int i=0;i<F.rows();i++) vs.push_back(-eperp13(i,1));
-  for(int i=0;i<F.rows();i++) vs.push_back(eperp21(i,1));
-  for(int i=0;i<F.rows();i++) vs.push_back(-eperp21(i,1));
-  for(int i=0;i<F.rows();i++) vs.push_back(eperp13(i,2));
-  for(int i=0;i<F.rows();i++) vs.push_back(-eperp13(i,2));
-  for(int i=0;i<F.rows();i++) vs.push_back(eperp21(i,2));
-  for(int i=0;i<F.rows();i++) vs.push_back(-eperp21(i,2));
-
-  // create sparse gradient operator matrix
-  G.resize(3*F.rows(),V.rows());
-  std::vector<Eigen::Triplet<typename DerivedV::Scalar> > triplets;
-  for (int i=0;i<(int)vs.size();++i)
-  {
-    triplets.push_back(Eigen::Triplet<typename DerivedV::Scalar>(rs[i],cs[i],vs[i]));
-  }
-  G.setFromTriplets(triplets.begin(), triplets.end());
+  };
+  igl::sparse_assembly(3*m,V.rows(),m*4*3,ij,value,G);
 }
 
 template <typename DerivedV, typename DerivedF>
@@ -6,7 +6,7 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "hausdorff.h"
-#include "point_mesh_squared_distance.h"
+#include "AABB.h"
 
 template <
   typename DerivedVA, 
@@ -27,10 +27,20 @@ IGL_INLINE void igl::hausdorff(
   assert(VB.cols() == 3 && "VB should contain 3d points");
   assert(FB.cols() == 3 && "FB should contain triangles");
   Matrix<Scalar,Dynamic,1> sqr_DBA,sqr_DAB;
-  Matrix<typename DerivedVA::Index,Dynamic,1> I;
-  Matrix<typename DerivedVA::Scalar,Dynamic,3> C;
-  point_mesh_squared_distance(VB,VA,FA,sqr_DBA,I,C);
-  point_mesh_squared_distance(VA,VB,FB,sqr_DAB,I,C);
+  Matrix<int,Dynamic,1> I;
+  // Only distances are needed: skip closest points
+  {
+    const MatrixXi EleA = FA;
+    AABB<DerivedVA,3> tree;
+    tree.init(VA,EleA);
+    tree.squared_distance(VA,EleA,VB,sqr_DBA,I);
+  }
+  {
+    const MatrixXi EleB = FB;
+    AABB<DerivedVB,3> tree;
+    tree.init(VB,EleB);
+    tree.squared_distance(VB,EleB,VA,sqr_DAB,I);
+  }
   const Scalar dba = sqr_DBA.maxCoeff();
   const Scalar dab = sqr_DAB.maxCoeff();
   d = sqrt(std::max(dba,dab));
@@ -7,7 +7,7 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "massmatrix.h"
 #include "normalize_row_sums.h"
-#include "sparse.h"
+#include "sparse_assembly.h"
 #include "doublearea.h"
 #include "repmat.h"
 #include <Eigen/Geometry>
@@ -80,11 +80,11 @@ IGL_INLINE void igl::massmatrix(
           // Holy shit this needs to be cleaned up and optimized
           Matrix<Scalar,Dynamic,3> cosines(m,3);
           cosines.col(0) = 
-            (l.col(2).array().pow(2)+l.col(1).array().pow(2)-l.col(0).array().pow(2))/(l.col(1).array()*l.col(2).array()*2.0);
+            (l.col(2).array().square()+l.col(1).array().square()-l.col(0).array().square())/(l.col(1).array()*l.col(2).array()*2.0);
           cosines.col(1) = 
-            (l.col(0).array().pow(2)+l.col(2).array().pow(2)-l.col(1).array().pow(2))/(l.col(2).array()*l.col(0).array()*2.0);
+            (l.col(0).array().square()+l.col(2).array().square()-l.col(1).array().square())/(l.col(2).array()*l.col(0).array()*2.0);
           cosines.col(2) = 
-            (l.col(1).array().pow(2)+l.col(0).array().pow(2)-l.col(2).array().pow(2))/(l.col(0).array()*l.col(1).array()*2.0);
+            (l.col(1).array().square()+l.col(0).array().square()-l.col(2).array().square())/(l.col(0).array()*l.col(1).array()*2.0);
           Matrix<Scalar,Dynamic,3> barycentric = cosines.array() * l.array();
           normalize_row_sums(barycentric,barycentric);
           Matrix<Scalar,Dynamic,3> partial = barycentric;
@@ -150,7 +150,13 @@ IGL_INLINE void igl::massmatrix(
     // Unsupported simplex size
     assert(false && "Unsupported simplex size");
   }
-  sparse(MI,MJ,MV,n,n,M);
+  // Same as sparse(MI,MJ,MV,n,n,M) but assembled directly into the
+  // compressed matrix
+  sparse_assembly(
+    n,n,MI.size(),
+    [&](const int t,int & i,int & j){ i = MI(t); j = MJ(t); },
+    [&](const int t){ return MV(t); },
+    M);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -6,6 +6,7 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "max_faces_stopping_condition.h"
+#include "IndexedPriorityQueue.h"
 
 IGL_INLINE void igl::max_faces_stopping_condition(
   int & m,
@@ -91,3 +92,39 @@ IGL_INLINE
       m,orig_m,max_m,stopping_condition);
   return stopping_condition;
 }
+
+template <typename PriorityQueue>
+IGL_INLINE
+  typename igl::decimate_callback_types<PriorityQueue>::stopping_condition
+  igl::max_faces_stopping_condition(
+    int & m,
+    const int orig_m,
+    const int max_m)
+{
+  return
+    [orig_m,max_m,&m](
+    const Eigen::MatrixXd &,
+    const Eigen::MatrixXi &,
+    const Eigen::MatrixXi &,
+    const Eigen::VectorXi &,
+    const Eigen::MatrixXi &,
+    const Eigen::MatrixXi &,
+    const PriorityQueue &,
+    const Eigen::MatrixXd &,
+    const int,
+    const int,
+    const int,
+    const int f1,
+    const int f2)->bool
+    {
+      // Only subtract if we're collapsing a real face
+      if(f1 < orig_m) m-=1;
+      if(f2 < orig_m) m-=1;
+      return m<=(int)max_m;
+    };
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::stopping_condition igl::max_faces_stopping_condition<igl::IndexedPriorityQueue<4> >(int&, int, int);
+#endif
@@ -8,6 +8,7 @@
 #ifndef IGL_MAX_FACES_STOPPING_CONDITION_H
 #define IGL_MAX_FACES_STOPPING_CONDITION_H
 #include "igl_inline.h"
+#include "decimate_callback_types.h"
 #include <Eigen/Core>
 #include <vector>
 #include <set>
@@ -66,6 +67,19 @@ namespace igl
       int & m,
       const int orign_m,
       const int max_m);
+  // Stopping condition compatible with the versions of igl::decimate
+  // templated on the queue type, e.g.,
+  //   max_faces_stopping_condition<IndexedPriorityQueue<> >(m,orig_m,max_m)
+  //
+  // Templates:
+  //   PriorityQueue  type of queue of (cost,edge) pairs
+  template <typename PriorityQueue>
+  IGL_INLINE
+    typename decimate_callback_types<PriorityQueue>::stopping_condition
+    max_faces_stopping_condition(
+      int & m,
+      const int orign_m,
+      const int max_m);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -15,14 +15,95 @@
 #include "matlab_format.h"
 #include "EPS.h"
 #include "cat.h"
+#include "parallel_for.h"
 
 //#include <Eigen/SparseExtra>
 // Bug in unsupported/Eigen/SparseExtra needs iostream first
 #include <iostream>
 #include <unsupported/Eigen/SparseExtra>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdio>
 #include <iostream>
+#include <limits>
+
+namespace igl
+{
+  namespace min_quad_with_fixed_internal
+  {
+    // Copy of (compressed) X whose values are the positions of its entries
+    // in X.valuePtr() plus one (exact in double for any realistic size)
+    template <typename T>
+    IGL_INLINE Eigen::SparseMatrix<double> entry_indices(
+      const Eigen::SparseMatrix<T> & X)
+    {
+      assert(X.isCompressed());
+      Eigen::SparseMatrix<double> I = X.template cast<double>();
+      for(int k = 0;k<I.nonZeros();k++)
+      {
+        I.valuePtr()[k] = k+1;
+      }
+      return I;
+    }
+    // Copy of X whose values are all -1 (entries not coming from A)
+    template <typename T>
+    IGL_INLINE Eigen::SparseMatrix<double> constant_entries(
+      const Eigen::SparseMatrix<T> & X)
+    {
+      Eigen::SparseMatrix<double> I = X.template cast<double>();
+      I.makeCompressed();
+      std::fill(I.valuePtr(),I.valuePtr()+I.nonZeros(),-1.);
+      return I;
+    }
+    // Decode the values of a slice of entry_indices/constant_entries
+    // matrices
+    IGL_INLINE void entry_map(
+      const Eigen::SparseMatrix<double> & I,
+      Eigen::VectorXi & map)
+    {
+      assert(I.isCompressed());
+      map.resize(I.nonZeros());
+      for(int k = 0;k<I.nonZeros();k++)
+      {
+        map(k) = I.valuePtr()[k] > 0 ? int(I.valuePtr()[k])-1 : -1;
+      }
+    }
+    // Decode the values of two slices I and J for each entry of S = I+J
+    template <typename T>
+    IGL_INLINE void entry_map(
+      const Eigen::SparseMatrix<double> & I,
+      const Eigen::SparseMatrix<double> & J,
+      const Eigen::SparseMatrix<T> & S,
+      Eigen::VectorXi & mapI,
+      Eigen::VectorXi & mapJ)
+    {
+      assert(I.isCompressed() && J.isCompressed() && S.isCompressed());
+      const auto decode = [](const double v){ return v > 0 ? int(v)-1 : -1; };
+      mapI.resize(S.nonZeros());
+      mapJ.resize(S.nonZeros());
+      for(int c = 0;c<S.cols();c++)
+      {
+        int i = I.outerIndexPtr()[c];
+        int j = J.outerIndexPtr()[c];
+        for(int k = S.outerIndexPtr()[c];k<S.outerIndexPtr()[c+1];k++)
+        {
+          const int r = S.innerIndexPtr()[k];
+          mapI(k) = -1;
+          mapJ(k) = -1;
+          if(i<I.outerIndexPtr()[c+1] && I.innerIndexPtr()[i] == r)
+          {
+            mapI(k) = decode(I.valuePtr()[i++]);
+          }
+          if(j<J.outerIndexPtr()[c+1] && J.innerIndexPtr()[j] == r)
+          {
+            mapJ(k) = decode(J.valuePtr()[j++]);
+          }
+        }
+      }
+    }
+  }
+}
 
 template <typename T, typename Derivedknown>
 IGL_INLINE bool igl::min_quad_with_fixed_precompute(
@@ -227,6 +308,8 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
           return false;
       }
       data.solver_type = min_quad_with_fixed_data<T>::LLT;
+      // Needed by min_quad_with_fixed_refactor
+      data.Auu = Auu;
     }else
     {
 #ifdef MIN_QUAD_WITH_FIXED_CPP_DEBUG
@@ -375,173 +458,436 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
     assert(data.Aeqk.rows() == neq);
     assert(data.Aeqk.cols() == data.known.size());
   }
+
+  // Maps used by min_quad_with_fixed_refactor: repeat the slicing above on
+  // copies of A and Aeq holding the indices of the entries of A
+  {
+    using namespace min_quad_with_fixed_internal;
+    data.A_nnz = A.nonZeros();
+    data.Auu_map.resize(0);
+    data.NA_map.resize(0);
+    data.preY_map.resize(0);
+    data.preYT_map.resize(0);
+    const SparseMatrix<double> AI = entry_indices(A);
+    if(data.Aeq_li)
+    {
+      const SparseMatrix<double> AeqI = constant_entries(Aeq);
+      const SparseMatrix<double> AeqTI = AeqI.transpose();
+      const SparseMatrix<double> ZI(neq,neq);
+      const SparseMatrix<double> new_AI = cat(1, cat(2,   AI, AeqTI ),
+                                                 cat(2, AeqI,    ZI ));
+      if(kr > 0)
+      {
+        SparseMatrix<double> AulkI;
+        slice(new_AI,data.unknown_lagrange,data.known,AulkI);
+        if(data.Auu_sym)
+        {
+          entry_map(AulkI,data.preY_map);
+        }else
+        {
+          SparseMatrix<double> AkulI;
+          slice(new_AI,data.known,data.unknown_lagrange,AkulI);
+          const SparseMatrix<double> AkulTI = AkulI.transpose();
+          entry_map(AulkI,AkulTI,data.preY,data.preY_map,data.preYT_map);
+        }
+      }
+      if(data.solver_type == min_quad_with_fixed_data<T>::LLT)
+      {
+        SparseMatrix<double> AuuI;
+        slice(AI,data.unknown,data.unknown,AuuI);
+        entry_map(AuuI,data.Auu_map);
+      }else
+      {
+        SparseMatrix<double> NAI;
+        slice(new_AI,data.unknown_lagrange,data.unknown_lagrange,NAI);
+        entry_map(NAI,data.NA_map);
+      }
+    }else
+    {
+      SparseMatrix<double> AuuI,AukI,AkuI;
+      slice(AI,data.unknown,data.unknown,AuuI);
+      entry_map(AuuI,data.Auu_map);
+      slice(AI,data.unknown,data.known,AukI);
+      slice(AI,data.known,data.unknown,AkuI);
+      const SparseMatrix<double> AkuTI = AkuI.transpose();
+      entry_map(AukI,AkuTI,data.preY,data.preY_map,data.preYT_map);
+    }
+  }
   return true;
 }
 
-
-template <
-  typename T,
-  typename DerivedB,
-  typename DerivedY,
-  typename DerivedBeq,
-  typename DerivedZ,
-  typename Derivedsol>
-IGL_INLINE bool igl::min_quad_with_fixed_solve(
-  const min_quad_with_fixed_data<T> & data,
-  const Eigen::MatrixBase<DerivedB> & B,
-  const Eigen::MatrixBase<DerivedY> & Y,
-  const Eigen::MatrixBase<DerivedBeq> & Beq,
-  Eigen::PlainObjectBase<DerivedZ> & Z,
-  Eigen::PlainObjectBase<Derivedsol> & sol)
+template <typename T>
+IGL_INLINE bool igl::min_quad_with_fixed_refactor(
+  const Eigen::SparseMatrix<T>& A2,
+  min_quad_with_fixed_data<T> & data)
 {
-  using namespace std;
   using namespace Eigen;
-  typedef Matrix<T,Dynamic,1> VectorXT;
-  typedef Matrix<T,Dynamic,Dynamic> MatrixXT;
-  // number of known rows
-  int kr = data.known.size();
-  if(kr!=0)
+  using namespace std;
+  assert(A2.rows() == data.n && A2.cols() == data.n && "A should be n by n");
+  // The maps index the compressed values of A
+  SparseMatrix<T> A2c;
+  if(!A2.isCompressed())
   {
-    assert(kr == Y.rows());
+    A2c = A2;
+    A2c.makeCompressed();
   }
-  // number of columns to solve
-  int cols = Y.cols();
-  assert(B.cols() == 1);
-  assert(Beq.size() == 0 || Beq.cols() == 1);
-
-  // resize output
-  Z.resize(data.n,cols);
-  // Set known values
-  for(int i = 0;i < kr;i++)
+  const SparseMatrix<T> & A = A2.isCompressed() ? A2 : A2c;
+  assert(A.nonZeros() == data.A_nnz &&
+    "A should have the same sparsity pattern as during precomputation");
+  const T * a = A.valuePtr();
+  // Same values as in 0.5*A
+  const auto half = [a](const int k)->T{ return a[k]*0.5; };
+  // Overwrite the values of a slice of 0.5*A
+  const auto refresh = [&half](const VectorXi & map,SparseMatrix<T> & X)
   {
-    for(int j = 0;j < cols;j++)
+    assert(map.size() == X.nonZeros());
+    T * x = X.valuePtr();
+    for(int k = 0;k<map.size();k++)
     {
-      Z(data.known(i),j) = Y(i,j);
+      if(map(k) >= 0)
+      {
+        x[k] = half(map(k));
+      }
     }
-  }
+  };
 
-  if(data.Aeq_li)
+  // RHS builder
   {
-    // number of lagrange multipliers aka linear equality constraints
-    int neq = data.lagrange.size();
-    // append lagrange multiplier rhs's
-    VectorXT BBeq(B.size() + Beq.size());
-    // Would like to do:
-    // BBeq << B, (Beq*-2.0);
-    // but Eigen can't handle empty vectors in comma initialization
-    // https://forum.kde.org/viewtopic.php?f=74&t=107974&p=364947#p364947
-    if(B.size() > 0)
-    {
-      BBeq << B;
-    }
-    if(Beq.size() > 0)
+    T * y = data.preY.valuePtr();
+    for(int k = 0;k<data.preY_map.size();k++)
     {
-      BBeq << Beq*-2.;
+      const int i = data.preY_map(k);
+      if(data.preYT_map.size() == 0)
+      {
+        if(i >= 0)
+        {
+          y[k] = half(i)*2;
+        }
+        continue;
+      }
+      const int j = data.preYT_map(k);
+      if(i >= 0 && j >= 0)
+      {
+        y[k] = half(i) + half(j);
+      }else if(i >= 0)
+      {
+        y[k] = half(i);
+      }else if(j >= 0)
+      {
+        y[k] = half(j);
+      }
     }
+  }
 
-    // Build right hand side
-    VectorXT BBequl;
-    igl::slice(BBeq,data.unknown_lagrange,BBequl);
-    MatrixXT BBequlcols;
-    igl::repmat(BBequl,1,cols,BBequlcols);
-    MatrixXT NB;
-    if(kr == 0)
-    {
-      NB = BBequlcols;
-    }else
+  // Numeric factorization only
+  ComputationInfo info;
+  switch(data.solver_type)
+  {
+    case min_quad_with_fixed_data<T>::LLT:
+      refresh(data.Auu_map,data.Auu);
+      data.llt.factorize(data.Auu);
+      info = data.llt.info();
+      break;
+    case min_quad_with_fixed_data<T>::LDLT:
+      refresh(data.NA_map,data.NA);
+      data.ldlt.factorize(data.NA);
+      info = data.ldlt.info();
+      break;
+    case min_quad_with_fixed_data<T>::LU:
+      refresh(data.NA_map,data.NA);
+      data.lu.factorize(data.NA);
+      info = data.lu.info();
+      break;
+    case min_quad_with_fixed_data<T>::QR_LLT:
     {
-      NB = data.preY * Y + BBequlcols;
+      refresh(data.Auu_map,data.Auu);
+      // Projected hessian (same sparsity pattern)
+      SparseMatrix<T> QRAuu = data.AeqTQ2T * data.Auu * data.AeqTQ2;
+      data.llt.factorize(QRAuu);
+      info = data.llt.info();
+      break;
     }
+    default:
+      assert(false && "Unknown solver type");
+      return false;
+  }
+  switch(info)
+  {
+    case Eigen::Success:
+      break;
+    case Eigen::NumericalIssue:
+      cerr<<"Error: Numerical issue."<<endl;
+      return false;
+    case Eigen::InvalidInput:
+      cerr<<"Error: Invalid Input."<<endl;
+      return false;
+    default:
+      cerr<<"Error: Other."<<endl;
+      return false;
+  }
+  return true;
+}
 
-    //std::cout<<"NB=["<<std::endl<<NB<<std::endl<<"];"<<std::endl;
-    //cout<<matlab_format(NB,"NB")<<endl;
-    switch(data.solver_type)
-    {
-      case igl::min_quad_with_fixed_data<T>::LLT:
-        sol = data.llt.solve(NB);
-        break;
-      case igl::min_quad_with_fixed_data<T>::LDLT:
-        sol = data.ldlt.solve(NB);
-        break;
-      case igl::min_quad_with_fixed_data<T>::LU:
-        // Not a bottleneck
-        sol = data.lu.solve(NB);
-        break;
-      default:
-        cerr<<"Error: invalid solver type"<<endl;
-        return false;
-    }
-    //std::cout<<"sol=["<<std::endl<<sol<<std::endl<<"];"<<std::endl;
-    // Now sol contains sol/-0.5
-    sol *= -0.5;
-    // Now sol contains solution
-    // Place solution in Z
-    for(int i = 0;i<(sol.rows()-neq);i++)
+
+namespace igl
+{
+  namespace min_quad_with_fixed_internal
+  {
+    // Solve for columns c to c+w-1 of Y (see min_quad_with_fixed_solve),
+    // where B and Beq are either single columns used for every column of Y
+    // or have as many columns as Y.
+    //
+    // Inputs:
+    //   data  factorization struct
+    //   B  n by 1 or by #Y.cols() list of linear coefficients
+    //   Y  b by #Y.cols() list of fixed values
+    //   Beq  m by 1 or by #Y.cols() list of linear equality constraint
+    //     constant values
+    //   c  first column
+    //   w  number of columns
+    //   Z  n by #Y.cols() solution
+    // Outputs:
+    //   Z  columns c to c+w-1 set
+    //   sol  #unknowns+#lagrange by w solution to linear system
+    // Returns true on success, false on error
+    template <
+      typename T,
+      typename DerivedB,
+      typename DerivedY,
+      typename DerivedBeq,
+      typename DerivedZ>
+    IGL_INLINE bool solve_columns(
+      const min_quad_with_fixed_data<T> & data,
+      const Eigen::MatrixBase<DerivedB> & B,
+      const Eigen::MatrixBase<DerivedY> & Y,
+      const Eigen::MatrixBase<DerivedBeq> & Beq,
+      const int c,
+      const int w,
+      Eigen::PlainObjectBase<DerivedZ> & Z,
+      Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> & sol)
     {
-      for(int j = 0;j<sol.cols();j++)
+      using namespace std;
+      using namespace Eigen;
+      typedef Matrix<T,Dynamic,Dynamic> MatrixXT;
+      // number of known rows
+      const int kr = data.known.size();
+      const int nu = data.unknown.size();
+      // Column of B (resp. Beq) used for column j
+      const auto jB = [&B,c](const int j){ return B.cols() == 1 ? 0 : c+j; };
+      const auto jBeq =
+        [&Beq,c](const int j){ return Beq.cols() == 1 ? 0 : c+j; };
+      // Set known values
+      for(int i = 0;i < kr;i++)
       {
-        Z(data.unknown_lagrange(i),j) = sol(i,j);
+        for(int j = 0;j < w;j++)
+        {
+          Z(data.known(i),c+j) = Y(i,c+j);
+        }
       }
+
+      if(data.Aeq_li)
+      {
+        // number of lagrange multipliers aka linear equality constraints
+        const int neq = data.lagrange.size();
+        // Build right hand side: B(unknown) followed by lagrange multiplier
+        // rhs's -2*Beq
+        MatrixXT NB(nu+neq,w);
+        for(int j = 0;j<w;j++)
+        {
+          for(int i = 0;i<nu;i++)
+          {
+            NB(i,j) = B(data.unknown(i),jB(j));
+          }
+          for(int i = 0;i<neq;i++)
+          {
+            NB(nu+i,j) = Beq(i,jBeq(j))*-2.;
+          }
+        }
+        if(kr > 0)
+        {
+          NB = data.preY * Y.middleCols(c,w) + NB;
+        }
+        switch(data.solver_type)
+        {
+          case igl::min_quad_with_fixed_data<T>::LLT:
+            sol = data.llt.solve(NB);
+            break;
+          case igl::min_quad_with_fixed_data<T>::LDLT:
+            sol = data.ldlt.solve(NB);
+            break;
+          case igl::min_quad_with_fixed_data<T>::LU:
+            // Not a bottleneck
+            sol = data.lu.solve(NB);
+            break;
+          default:
+            cerr<<"Error: invalid solver type"<<endl;
+            return false;
+        }
+        // Now sol contains sol/-0.5
+        sol *= -0.5;
+        // Now sol contains solution
+        // Place solution in Z
+        for(int i = 0;i<nu;i++)
+        {
+          for(int j = 0;j<w;j++)
+          {
+            Z(data.unknown_lagrange(i),c+j) = sol(i,j);
+          }
+        }
+      }else
+      {
+        assert(data.solver_type == min_quad_with_fixed_data<T>::QR_LLT);
+        const int neq = data.neq;
+        MatrixXT Bu(nu,w),Beqw(neq,w);
+        for(int j = 0;j<w;j++)
+        {
+          for(int i = 0;i<nu;i++)
+          {
+            Bu(i,j) = B(data.unknown(i),jB(j));
+          }
+          Beqw.col(j) = Beq.col(jBeq(j));
+        }
+        // Adjust Aeq rhs to include known parts
+        MatrixXT eff_Beq =
+          //data.AeqTQR.colsPermutation().transpose() * (-data.Aeqk * Y + Beq);
+          data.AeqTET * (-data.Aeqk * Y.middleCols(c,w) + Beqw);
+        // Where did this -0.5 come from? Probably the same place as above.
+        MatrixXT NB;
+        NB = -0.5*(Bu + data.preY * Y.middleCols(c,w));
+        // Trim eff_Beq
+        const int nc = data.AeqTQR.rank();
+        eff_Beq = eff_Beq.topRows(nc).eval();
+        data.AeqTR1T.template triangularView<Lower>().solveInPlace(eff_Beq);
+        // Now eff_Beq = (data.AeqTR1T \ (data.AeqTET * (-data.Aeqk * Y + Beq)))
+        MatrixXT lambda_0;
+        lambda_0 = data.AeqTQ1 * eff_Beq;
+        MatrixXT QRB;
+        QRB = -data.AeqTQ2T * (data.Auu * lambda_0) + data.AeqTQ2T * NB;
+        MatrixXT lambda;
+        lambda = data.llt.solve(QRB);
+        // prepare output
+        MatrixXT solu;
+        solu = data.AeqTQ2 * lambda + lambda_0;
+        //  http://www.math.uh.edu/~rohop/fall_06/Chapter3.pdf
+        MatrixXT solLambda;
+        {
+          MatrixXT temp1,temp2;
+          temp1 = (data.AeqTQ1T * NB - data.AeqTQ1T * data.Auu * solu);
+          data.AeqTR1.template triangularView<Upper>().solveInPlace(temp1);
+          temp2 = MatrixXT::Zero(neq,w);
+          temp2.topRows(nc) = temp1;
+          //solLambda = data.AeqTQR.colsPermutation() * temp2;
+          solLambda = data.AeqTE * temp2;
+        }
+        // sol is [Z(unknown);Lambda]
+        assert(nu == solu.rows());
+        assert(w == solu.cols());
+        assert(neq == solLambda.rows());
+        assert(w == solLambda.cols());
+        sol.resize(nu+neq,w);
+        sol.topRows(nu) = solu;
+        sol.bottomRows(neq) = solLambda;
+        for(int u = 0;u<nu;u++)
+        {
+          for(int j = 0;j<w;j++)
+          {
+            Z(data.unknown(u),c+j) = solu(u,j);
+          }
+        }
+      }
+      return true;
     }
-  }else
-  {
-    assert(data.solver_type == min_quad_with_fixed_data<T>::QR_LLT);
-    DerivedBeq eff_Beq;
-    // Adjust Aeq rhs to include known parts
-    eff_Beq =
-      //data.AeqTQR.colsPermutation().transpose() * (-data.Aeqk * Y + Beq);
-      data.AeqTET * (-data.Aeqk * Y + Beq);
-    // Where did this -0.5 come from? Probably the same place as above.
-    DerivedB Bu;
-    slice(B,data.unknown,Bu);
-    DerivedB NB;
-    NB = -0.5*(Bu + data.preY * Y);
-    // Trim eff_Beq
-    const int nc = data.AeqTQR.rank();
-    const int neq = Beq.rows();
-    eff_Beq = eff_Beq.topLeftCorner(nc,1).eval();
-    data.AeqTR1T.template triangularView<Lower>().solveInPlace(eff_Beq);
-    // Now eff_Beq = (data.AeqTR1T \ (data.AeqTET * (-data.Aeqk * Y + Beq)))
-    DerivedB lambda_0;
-    lambda_0 = data.AeqTQ1 * eff_Beq;
-    //cout<<matlab_format(lambda_0,"lambda_0")<<endl;
-    DerivedB QRB;
-    QRB = -data.AeqTQ2T * (data.Auu * lambda_0) + data.AeqTQ2T * NB;
-    Derivedsol lambda;
-    lambda = data.llt.solve(QRB);
-    // prepare output
-    Derivedsol solu;
-    solu = data.AeqTQ2 * lambda + lambda_0;
-    //  http://www.math.uh.edu/~rohop/fall_06/Chapter3.pdf
-    Derivedsol solLambda;
-    {
-      Derivedsol temp1,temp2;
-      temp1 = (data.AeqTQ1T * NB - data.AeqTQ1T * data.Auu * solu);
-      data.AeqTR1.template triangularView<Upper>().solveInPlace(temp1);
-      //cout<<matlab_format(temp1,"temp1")<<endl;
-      temp2 = Derivedsol::Zero(neq,1);
-      temp2.topLeftCorner(nc,1) = temp1;
-      //solLambda = data.AeqTQR.colsPermutation() * temp2;
-      solLambda = data.AeqTE * temp2;
-    }
-    // sol is [Z(unknown);Lambda]
-    assert(data.unknown.size() == solu.rows());
-    assert(cols == solu.cols());
-    assert(data.neq == neq);
-    assert(data.neq == solLambda.rows());
-    assert(cols == solLambda.cols());
-    sol.resize(data.unknown.size()+data.neq,cols);
-    sol.block(0,0,solu.rows(),solu.cols()) = solu;
-    sol.block(solu.rows(),0,solLambda.rows(),solLambda.cols()) = solLambda;
-    for(int u = 0;u<data.unknown.size();u++)
+    // Run solve_columns on blocks of at most max_block columns in parallel
+    template <
+      typename T,
+      typename DerivedB,
+      typename DerivedY,
+      typename DerivedBeq,
+      typename DerivedZ,
+      typename BlockFunctionType>
+    IGL_INLINE bool solve_blocks(
+      const min_quad_with_fixed_data<T> & data,
+      const Eigen::MatrixBase<DerivedB> & B,
+      const Eigen::MatrixBase<DerivedY> & Y,
+      const Eigen::MatrixBase<DerivedBeq> & Beq,
+      const int max_block,
+      Eigen::PlainObjectBase<DerivedZ> & Z,
+      const BlockFunctionType & block_func)
     {
-      for(int j = 0;j<Z.cols();j++)
+      const int cols = Y.cols();
+      assert(data.known.size() == 0 || data.known.size() == Y.rows());
+      assert(B.rows() == data.n && (B.cols() == 1 || B.cols() == cols));
+      assert(
+        Beq.size() == 0 || (Beq.cols() == 1 || Beq.cols() == cols));
+      assert(max_block > 0);
+      // resize output
+      Z.resize(data.n,cols);
+      // Spread the columns over the threads, without exceeding max_block
+      const int nthreads = ThreadPool::instance().num_threads();
+      const int w = std::max(1,std::min(max_block,(cols+nthreads-1)/nthreads));
+      const int nblocks = (cols+w-1)/w;
+      std::atomic<bool> error(false);
+      parallel_for(nblocks,[&](const int b)
       {
-        Z(data.unknown(u),j) = solu(u,j);
-      }
+        if(error)
+        {
+          return;
+        }
+        const int c = b*w;
+        Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> sol;
+        if(!solve_columns(data,B,Y,Beq,c,std::min(w,cols-c),Z,sol))
+        {
+          error = true;
+          return;
+        }
+        block_func(c,sol);
+      },2);
+      return !error;
     }
   }
-  return true;
+}
+
+template <
+  typename T,
+  typename DerivedB,
+  typename DerivedY,
+  typename DerivedBeq,
+  typename DerivedZ,
+  typename Derivedsol>
+IGL_INLINE bool igl::min_quad_with_fixed_solve(
+  const min_quad_with_fixed_data<T> & data,
+  const Eigen::MatrixBase<DerivedB> & B,
+  const Eigen::MatrixBase<DerivedY> & Y,
+  const Eigen::MatrixBase<DerivedBeq> & Beq,
+  Eigen::PlainObjectBase<DerivedZ> & Z,
+  Eigen::PlainObjectBase<Derivedsol> & sol)
+{
+  typedef Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> MatrixXT;
+  sol.resize(
+    data.unknown.size()+(data.Aeq_li ? data.lagrange.size() : data.neq),
+    Y.cols());
+  return min_quad_with_fixed_internal::solve_blocks(
+    data,B,Y,Beq,std::numeric_limits<int>::max(),Z,
+    [&sol](const int c,const MatrixXT & solc)
+    {
+      sol.middleCols(c,solc.cols()) = solc;
+    });
+}
+
+template <
+  typename T,
+  typename DerivedB,
+  typename DerivedY,
+  typename DerivedBeq,
+  typename DerivedZ>
+IGL_INLINE bool igl::min_quad_with_fixed_solve(
+  const min_quad_with_fixed_data<T> & data,
+  const Eigen::MatrixBase<DerivedB> & B,
+  const Eigen::MatrixBase<DerivedY> & Y,
+  const Eigen::MatrixBase<DerivedBeq> & Beq,
+  Eigen::PlainObjectBase<DerivedZ> & Z)
+{
+  return min_quad_with_fixed_solve(data,B,Y,Beq,64,Z);
 }
 
 template <
@@ -555,10 +901,12 @@ IGL_INLINE bool igl::min_quad_with_fixed_solve(
   const Eigen::MatrixBase<DerivedB> & B,
   const Eigen::MatrixBase<DerivedY> & Y,
   const Eigen::MatrixBase<DerivedBeq> & Beq,
+  const int max_block,
   Eigen::PlainObjectBase<DerivedZ> & Z)
 {
-  Eigen::Matrix<typename DerivedZ::Scalar, Eigen::Dynamic, Eigen::Dynamic> sol;
-  return min_quad_with_fixed_solve(data,B,Y,Beq,Z,sol);
+  return min_quad_with_fixed_internal::solve_blocks(
+    data,B,Y,Beq,max_block,Z,
+    [](const int,const Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> &){});
 }
 
 template <
@@ -591,6 +939,7 @@ IGL_INLINE bool igl::min_quad_with_fixed(
 // generated by autoexplicit.sh
 template bool igl::min_quad_with_fixed<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template bool igl::min_quad_with_fixed_solve<double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::min_quad_with_fixed_data<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template bool igl::min_quad_with_fixed_refactor<double>(Eigen::SparseMatrix<double, 0, int> const&, igl::min_quad_with_fixed_data<double>&);
 template bool igl::min_quad_with_fixed_precompute<double, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::SparseMatrix<double, 0, int> const&, bool, igl::min_quad_with_fixed_data<double>&);
 template bool igl::min_quad_with_fixed_solve<double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::min_quad_with_fixed_data<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 template bool igl::min_quad_with_fixed_solve<double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::min_quad_with_fixed_data<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
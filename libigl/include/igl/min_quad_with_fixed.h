@@ -57,18 +57,45 @@ namespace igl
     const bool pd,
     min_quad_with_fixed_data<T> & data
     );
+  // Refactor a system previously factored using
+  // min_quad_with_fixed_precompute for new values of A with the same sparsity
+  // pattern (e.g. a cotangent Laplacian of moving vertices, see
+  // CotmatrixAssembler.h). The known indices, Aeq, pd and the symmetry of
+  // A(unknown,unknown) are assumed unchanged. The slicing done during
+  // precomputation is replaced by maps from the entries of A to the entries
+  // of the sliced matrices and only the numeric factorization is redone,
+  // reusing the fill-reducing ordering and symbolic analysis. Results are
+  // identical to calling min_quad_with_fixed_precompute again.
+  //
+  // Inputs:
+  //   A  n by n matrix of quadratic coefficients with the same sparsity
+  //     pattern as in the precomputation
+  //   data  factorization struct output by min_quad_with_fixed_precompute
+  // Outputs:
+  //   data  factorization struct updated for A
+  // Returns true on success, false on error
+  template <typename T>
+  IGL_INLINE bool min_quad_with_fixed_refactor(
+    const Eigen::SparseMatrix<T>& A,
+    min_quad_with_fixed_data<T> & data);
 
   // Solves a system previously factored using min_quad_with_fixed_precompute
   //
+  // Each column of Y is an independent problem. Columns are solved in blocks
+  // concurrently on igl::ThreadPool (within a block the solvers process
+  // several right-hand sides at once).
+  //
   // Template:
   //   T  type of sparse matrix (e.g. double)
   //   DerivedY  type of Y (e.g. derived from VectorXd or MatrixXd)
   //   DerivedZ  type of Z (e.g. derived from VectorXd or MatrixXd)
   // Inputs:
   //   data  factorization struct with all necessary precomputation to solve
-  //   B  n by 1 column of linear coefficients
-  //   Y  b by 1 list of constant fixed values
-  //   Beq  m by 1 list of linear equality constraint constant values
+  //   B  n by 1 column of linear coefficients shared by all columns, or n by
+  //     cols list of linear coefficients
+  //   Y  b by cols list of constant fixed values
+  //   Beq  m by 1 or m by cols list of linear equality constraint constant
+  //     values
   // Outputs:
   //   Z  n by cols solution
   //   sol  #unknowns+#lagrange by cols solution to linear system
@@ -100,6 +127,27 @@ namespace igl
     const Eigen::MatrixBase<DerivedY> & Y,
     const Eigen::MatrixBase<DerivedBeq> & Beq,
     Eigen::PlainObjectBase<DerivedZ> & Z);
+  // Wrapper without sol streaming the columns by blocks: only the right-hand
+  // sides and solutions of the blocks being solved are held in memory (in
+  // addition to B, Y and Z), so that many columns can be solved at once
+  // (e.g. harmonic or biharmonic coordinates of many handles).
+  //
+  // Inputs:
+  //   max_block  maximum number of columns solved at a time by a thread
+  //     {64 in the wrapper above}
+  template <
+    typename T,
+    typename DerivedB,
+    typename DerivedY,
+    typename DerivedBeq,
+    typename DerivedZ>
+  IGL_INLINE bool min_quad_with_fixed_solve(
+    const min_quad_with_fixed_data<T> & data,
+    const Eigen::MatrixBase<DerivedB> & B,
+    const Eigen::MatrixBase<DerivedY> & Y,
+    const Eigen::MatrixBase<DerivedBeq> & Beq,
+    const int max_block,
+    Eigen::PlainObjectBase<DerivedZ> & Z);
   template <
     typename T,
     typename Derivedknown,
@@ -169,6 +217,17 @@ struct igl::min_quad_with_fixed_data
   // Debug
   Eigen::SparseMatrix<T> NA;
   Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> NB;
+  // Used by min_quad_with_fixed_refactor
+  // Number of entries of A
+  int A_nnz;
+  // Indices into the (compressed) values of A of the values of Auu, NA and
+  // preY, -1 for entries not coming from A (e.g. from Aeq). preY is the sum
+  // of two slices of A (see min_quad_with_fixed_precompute): preYT_map
+  // indexes the second one, or is empty if preY is twice the first one.
+  Eigen::VectorXi Auu_map;
+  Eigen::VectorXi NA_map;
+  Eigen::VectorXi preY_map;
+  Eigen::VectorXi preYT_map;
 };
 
 #ifndef IGL_STATIC_LIBRARY
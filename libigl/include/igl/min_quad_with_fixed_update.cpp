@@ -0,0 +1,445 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "min_quad_with_fixed_update.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+namespace igl
+{
+  namespace min_quad_with_fixed_update_internal
+  {
+    // Fully precompute the problem with the given constraints and make it the
+    // base
+    template <typename T, typename Derivedknown>
+    IGL_INLINE bool reset(
+      const Eigen::MatrixBase<Derivedknown> & known,
+      const Eigen::SparseMatrix<T>& Aeq,
+      min_quad_with_fixed_update_data<T> & data)
+    {
+      data.known = known.template cast<int>();
+      // Keep an empty Aeq as 0 by n so that it can be iterated and multiplied
+      if(Aeq.rows() == 0)
+      {
+        data.Aeq.resize(0,data.A.cols());
+      }else
+      {
+        data.Aeq = Aeq;
+      }
+      data.freed.resize(0);
+      data.fixed.resize(0);
+      data.Aeq_added.resize(0,data.A.cols());
+      data.Gr.resize(0,0);
+      data.W.resize(0,0);
+      if(!min_quad_with_fixed_precompute(
+        data.A,data.known,data.Aeq,data.pd,data.base))
+      {
+        return false;
+      }
+      data.unknown_pos.setConstant(data.A.rows(),-1);
+      for(int u = 0;u<data.base.unknown.size();u++)
+      {
+        data.unknown_pos(data.base.unknown(u)) = u;
+      }
+      return true;
+    }
+    // Solve the base system (unknowns followed by lagrange multipliers)
+    template <typename T>
+    IGL_INLINE bool base_solve(
+      const min_quad_with_fixed_data<T> & base,
+      const Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> & f,
+      Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> & t)
+    {
+      switch(base.solver_type)
+      {
+        case min_quad_with_fixed_data<T>::LLT:
+          t = base.llt.solve(f);
+          return true;
+        case min_quad_with_fixed_data<T>::LDLT:
+          t = base.ldlt.solve(f);
+          return true;
+        case min_quad_with_fixed_data<T>::LU:
+          t = base.lu.solve(f);
+          return true;
+        default:
+          return false;
+      }
+    }
+  }
+}
+
+template <typename T, typename Derivedknown>
+IGL_INLINE bool igl::min_quad_with_fixed_update_precompute(
+  const Eigen::SparseMatrix<T>& A,
+  const Eigen::MatrixBase<Derivedknown> & known,
+  const Eigen::SparseMatrix<T>& Aeq,
+  const bool pd,
+  min_quad_with_fixed_update_data<T> & data)
+{
+  data.A = A;
+  data.A.makeCompressed();
+  data.pd = pd;
+  // Rows of A are only needed explicitly if A is not symmetric
+  data.AT = data.A.transpose();
+  if(
+    std::equal(
+      data.A.outerIndexPtr(),
+      data.A.outerIndexPtr()+data.A.cols()+1,
+      data.AT.outerIndexPtr()) &&
+    std::equal(
+      data.A.innerIndexPtr(),
+      data.A.innerIndexPtr()+data.A.nonZeros(),
+      data.AT.innerIndexPtr()) &&
+    std::equal(
+      data.A.valuePtr(),
+      data.A.valuePtr()+data.A.nonZeros(),
+      data.AT.valuePtr()))
+  {
+    data.AT = Eigen::SparseMatrix<T>();
+  }
+  return min_quad_with_fixed_update_internal::reset(known,Aeq,data);
+}
+
+template <typename T, typename Derivedknown>
+IGL_INLINE bool igl::min_quad_with_fixed_update(
+  const Eigen::MatrixBase<Derivedknown> & known,
+  const Eigen::SparseMatrix<T>& Aeq,
+  min_quad_with_fixed_update_data<T> & data)
+{
+  using namespace Eigen;
+  using namespace std;
+  using namespace min_quad_with_fixed_update_internal;
+  typedef Matrix<T,Dynamic,Dynamic> MatrixXT;
+  const int n = data.A.rows();
+  const int neq0 = data.Aeq.rows();
+  // Rows of the base Aeq should be kept as is
+  if(Aeq.rows() < neq0 || (Aeq.rows() > 0 && Aeq.cols() != n))
+  {
+    return reset(known,Aeq,data);
+  }
+  if(neq0 > 0)
+  {
+    const SparseMatrix<T> D = SparseMatrix<T>(Aeq.topRows(neq0)) - data.Aeq;
+    if(D.norm() != 0)
+    {
+      return reset(known,Aeq,data);
+    }
+  }
+  const auto & base = data.base;
+  // The Schur complement needs a direct solver of the full base system
+  if(base.solver_type == min_quad_with_fixed_data<T>::QR_LLT)
+  {
+    return reset(known,Aeq,data);
+  }
+
+  // Modifications w.r.t. the base
+  vector<bool> is_known(n,false);
+  for(int i = 0;i<known.size();i++)
+  {
+    is_known[known(i)] = true;
+  }
+  vector<int> freed,fixed;
+  for(int k = 0;k<base.known.size();k++)
+  {
+    if(!is_known[base.known(k)])
+    {
+      freed.push_back(base.known(k));
+    }
+  }
+  for(int i = 0;i<known.size();i++)
+  {
+    if(data.unknown_pos(known(i)) >= 0)
+    {
+      fixed.push_back(i);
+    }
+  }
+  const int r = freed.size();
+  const int f = fixed.size();
+  const int m = Aeq.rows()-neq0;
+  const int q = r+f+m;
+  if(q > data.max_updates)
+  {
+    return reset(known,Aeq,data);
+  }
+
+  // Couplings of the modifications with the base system (Gc, Gr) and among
+  // themselves (C). Modification j is a freed variable (j<r), a newly fixed
+  // variable (j<r+f) or an added constraint.
+  const int nu = base.unknown.size();
+  const int nul = nu+neq0;
+  // position of freed variables
+  vector<int> freed_pos(n,-1);
+  for(int j = 0;j<r;j++)
+  {
+    freed_pos[freed[j]] = j;
+  }
+  SparseMatrix<T,RowMajor> Aeq_added(m,n);
+  if(m > 0)
+  {
+    Aeq_added = Aeq.bottomRows(m);
+  }
+  vector<Triplet<T> > GcIJV,GrIJV;
+  MatrixXT C = MatrixXT::Zero(q,q);
+  const SparseMatrix<T> & AT = data.AT.size() == 0 ? data.A : data.AT;
+  for(int j = 0;j<r;j++)
+  {
+    const int v = freed[j];
+    // Same entries as in 0.5*A during precomputation
+    for(typename SparseMatrix<T>::InnerIterator it(data.A,v);it;++it)
+    {
+      if(data.unknown_pos(it.row()) >= 0)
+      {
+        GcIJV.emplace_back(data.unknown_pos(it.row()),j,it.value()*0.5);
+      }else if(freed_pos[it.row()] >= 0)
+      {
+        C(freed_pos[it.row()],j) = it.value()*0.5;
+      }
+    }
+    for(typename SparseMatrix<T>::InnerIterator it(AT,v);it;++it)
+    {
+      if(data.unknown_pos(it.row()) >= 0)
+      {
+        GrIJV.emplace_back(j,data.unknown_pos(it.row()),it.value()*0.5);
+      }
+    }
+    for(typename SparseMatrix<T>::InnerIterator it(data.Aeq,v);it;++it)
+    {
+      GcIJV.emplace_back(nu+it.row(),j,it.value());
+      GrIJV.emplace_back(j,nu+it.row(),it.value());
+    }
+  }
+  for(int j = 0;j<f;j++)
+  {
+    const int u = data.unknown_pos(known(fixed[j]));
+    GcIJV.emplace_back(u,r+j,1);
+    GrIJV.emplace_back(r+j,u,1);
+  }
+  for(int i = 0;i<m;i++)
+  {
+    const int j = r+f+i;
+    typedef typename SparseMatrix<T,RowMajor>::InnerIterator RowIterator;
+    for(RowIterator it(Aeq_added,i);it;++it)
+    {
+      if(data.unknown_pos(it.col()) >= 0)
+      {
+        GcIJV.emplace_back(data.unknown_pos(it.col()),j,it.value());
+        GrIJV.emplace_back(j,data.unknown_pos(it.col()),it.value());
+      }else if(freed_pos[it.col()] >= 0)
+      {
+        C(freed_pos[it.col()],j) = it.value();
+        C(j,freed_pos[it.col()]) = it.value();
+      }
+    }
+  }
+  SparseMatrix<T> Gc(nul,q),Gr(q,nul);
+  Gc.setFromTriplets(GcIJV.begin(),GcIJV.end());
+  Gr.setFromTriplets(GrIJV.begin(),GrIJV.end());
+
+  // W = NA \ Gc, reusing the columns of variables already modified at the
+  // previous update
+  MatrixXT W(nul,q);
+  vector<int> previous(q,-1);
+  for(int j = 0;j<r;j++)
+  {
+    for(int o = 0;o<data.freed.size();o++)
+    {
+      if(data.freed(o) == freed[j])
+      {
+        previous[j] = o;
+      }
+    }
+  }
+  for(int j = 0;j<f;j++)
+  {
+    for(int o = 0;o<data.fixed.size();o++)
+    {
+      if(data.known(data.fixed(o)) == known(fixed[j]))
+      {
+        previous[r+j] = data.freed.size()+o;
+      }
+    }
+  }
+  std::atomic<bool> error(false);
+  parallel_for(q,[&](const int j)
+  {
+    if(previous[j] >= 0)
+    {
+      W.col(j) = data.W.col(previous[j]);
+      return;
+    }
+    MatrixXT g = Gc.col(j),w;
+    if(!base_solve(base,g,w))
+    {
+      error = true;
+      return;
+    }
+    W.col(j) = w;
+  },2);
+  if(error)
+  {
+    return false;
+  }
+  // Schur complement
+  if(q > 0)
+  {
+    MatrixXT S = C;
+    S -= Gr*W;
+    data.S.compute(S);
+    if(!data.S.isInvertible())
+    {
+      // E.g., added constraints redundant with the others
+      return reset(known,Aeq,data);
+    }
+  }
+  data.known = known.template cast<int>();
+  data.freed = Eigen::Map<const VectorXi>(freed.data(),r);
+  data.fixed = Eigen::Map<const VectorXi>(fixed.data(),f);
+  data.Aeq_added = Aeq_added;
+  data.Gr = Gr;
+  data.W = W;
+  return true;
+}
+
+template <
+  typename T,
+  typename DerivedB,
+  typename DerivedY,
+  typename DerivedBeq,
+  typename DerivedZ>
+IGL_INLINE bool igl::min_quad_with_fixed_update_solve(
+  const min_quad_with_fixed_update_data<T> & data,
+  const Eigen::MatrixBase<DerivedB> & B,
+  const Eigen::MatrixBase<DerivedY> & Y,
+  const Eigen::MatrixBase<DerivedBeq> & Beq,
+  Eigen::PlainObjectBase<DerivedZ> & Z)
+{
+  using namespace Eigen;
+  using namespace min_quad_with_fixed_update_internal;
+  typedef Matrix<T,Dynamic,Dynamic> MatrixXT;
+  const auto & base = data.base;
+  // Unmodified base problem
+  if(
+    data.W.cols() == 0 &&
+    data.known.size() == base.known.size() &&
+    data.known == base.known)
+  {
+    return min_quad_with_fixed_solve(base,B,Y,Beq,Z);
+  }
+  // A QR_LLT base is always reset by min_quad_with_fixed_update
+  assert(base.solver_type != min_quad_with_fixed_data<T>::QR_LLT);
+  const int n = data.A.rows();
+  const int cols = Y.cols();
+  const int nu = base.unknown.size();
+  const int neq0 = data.Aeq.rows();
+  const int r = data.freed.size();
+  const int f = data.fixed.size();
+  const int m = data.Aeq_added.rows();
+  assert(Y.rows() == data.known.size());
+  assert(B.rows() == n && (B.cols() == 1 || B.cols() == cols));
+  assert(Beq.rows() == neq0+m && (Beq.cols() == 1 || Beq.cols() == cols));
+  const auto jB = [&B](const int j){ return B.cols() == 1 ? 0 : j; };
+  const auto jBeq = [&Beq](const int j){ return Beq.cols() == 1 ? 0 : j; };
+  // Fixed values of base known variables, zero elsewhere
+  MatrixXT Yb = MatrixXT::Zero(n,cols);
+  for(int i = 0;i<data.known.size();i++)
+  {
+    if(data.unknown_pos(data.known(i)) < 0)
+    {
+      Yb.row(data.known(i)) = Y.row(i);
+    }
+  }
+  MatrixXT AY = data.A*Yb;
+  if(data.AT.size() != 0)
+  {
+    // Known values enter the right hand side through the symmetric part of A
+    // (see preY in min_quad_with_fixed_precompute), while newly fixed values
+    // enter through the columns of A in the base system
+    MatrixXT Yf = MatrixXT::Zero(n,cols);
+    for(int k = 0;k<f;k++)
+    {
+      Yf.row(data.known(data.fixed(k))) = Y.row(data.fixed(k));
+    }
+    const MatrixXT Yall = Yb+Yf;
+    AY = 0.5*(data.A*Yall + data.AT*Yall) - data.A*Yf;
+  }
+  // Right hand side of the base system and of the modifications (same
+  // scaling as in min_quad_with_fixed_solve)
+  MatrixXT fb(nu+neq0,cols);
+  for(int j = 0;j<cols;j++)
+  {
+    for(int u = 0;u<nu;u++)
+    {
+      const int v = base.unknown(u);
+      fb(u,j) = -0.5*B(v,jB(j)) - 0.5*AY(v,j);
+    }
+    for(int i = 0;i<neq0;i++)
+    {
+      fb(nu+i,j) = Beq(i,jBeq(j));
+    }
+  }
+  if(neq0 > 0)
+  {
+    fb.bottomRows(neq0) -= data.Aeq*Yb;
+  }
+  MatrixXT t;
+  if(!base_solve(base,fb,t))
+  {
+    return false;
+  }
+  MatrixXT z;
+  if(r+f+m > 0)
+  {
+    MatrixXT g(r+f+m,cols);
+    const MatrixXT AaY = data.Aeq_added*Yb;
+    for(int j = 0;j<cols;j++)
+    {
+      for(int k = 0;k<r;k++)
+      {
+        const int v = data.freed(k);
+        g(k,j) = -0.5*B(v,jB(j)) - 0.5*AY(v,j);
+      }
+      for(int k = 0;k<f;k++)
+      {
+        g(r+k,j) = Y(data.fixed(k),j);
+      }
+      for(int i = 0;i<m;i++)
+      {
+        g(r+f+i,j) = Beq(neq0+i,jBeq(j)) - AaY(i,j);
+      }
+    }
+    g -= data.Gr*t;
+    z = data.S.solve(g);
+    t -= data.W*z;
+  }
+  // Place solution in Z
+  Z.resize(n,cols);
+  for(int u = 0;u<nu;u++)
+  {
+    Z.row(base.unknown(u)) = t.row(u);
+  }
+  for(int k = 0;k<r;k++)
+  {
+    Z.row(data.freed(k)) = z.row(k);
+  }
+  for(int i = 0;i<data.known.size();i++)
+  {
+    Z.row(data.known(i)) = Y.row(i);
+  }
+  return true;
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template bool igl::min_quad_with_fixed_update_precompute<double, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::SparseMatrix<double, 0, int> const&, bool, igl::min_quad_with_fixed_update_data<double>&);
+template bool igl::min_quad_with_fixed_update<double, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::SparseMatrix<double, 0, int> const&, igl::min_quad_with_fixed_update_data<double>&);
+template bool igl::min_quad_with_fixed_update_solve<double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::min_quad_with_fixed_update_data<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template bool igl::min_quad_with_fixed_update_solve<double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::min_quad_with_fixed_update_data<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template bool igl::min_quad_with_fixed_update_solve<double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::min_quad_with_fixed_update_data<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+#endif
@@ -0,0 +1,133 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_MIN_QUAD_WITH_FIXED_UPDATE_H
+#define IGL_MIN_QUAD_WITH_FIXED_UPDATE_H
+#include "igl_inline.h"
+#include "min_quad_with_fixed.h"
+#include <Eigen/Core>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+namespace igl
+{
+  template <typename T>
+  struct min_quad_with_fixed_update_data;
+  // MIN_QUAD_WITH_FIXED_UPDATE_PRECOMPUTE Precompute a min_quad_with_fixed
+  // problem (see min_quad_with_fixed.h) whose fixed variables and linear
+  // equality constraints will change a few at a time, e.g. handles added or
+  // removed during interactive deformation.
+  //
+  // Inputs:
+  //   A  n by n matrix of quadratic coefficients
+  //   known list of indices to known rows in Z
+  //   Aeq  m by n list of linear equality constraint coefficients
+  //   pd flag specifying whether A(unknown,unknown) is positive definite
+  // Outputs:
+  //   data  factorization struct with all necessary information to update
+  //     and solve using min_quad_with_fixed_update and
+  //     min_quad_with_fixed_update_solve
+  // Returns true on success, false on error
+  template <typename T, typename Derivedknown>
+  IGL_INLINE bool min_quad_with_fixed_update_precompute(
+    const Eigen::SparseMatrix<T>& A,
+    const Eigen::MatrixBase<Derivedknown> & known,
+    const Eigen::SparseMatrix<T>& Aeq,
+    const bool pd,
+    min_quad_with_fixed_update_data<T> & data);
+  // MIN_QUAD_WITH_FIXED_UPDATE Change the known variables and the linear
+  // equality constraints of a precomputed problem without refactoring.
+  //
+  // The factorization of the last fully precomputed ("base") problem is
+  // kept. Variables freed or newly fixed since then and added equality
+  // constraints are handled with a Schur complement: each modification costs
+  // one solve with the base factorization (reused for modifications already
+  // present at the previous update) and its solution is stored as a dense
+  // column, so the memory grows by #unknowns per modification. Once there
+  // are more than data.max_updates modifications, or if rows of the base Aeq
+  // change, the problem is fully precomputed again and becomes the new base.
+  //
+  // Inputs:
+  //   known  list of indices to known rows in Z
+  //   Aeq  m by n list of linear equality constraint coefficients: the rows
+  //     of the base Aeq followed by added rows
+  //   data  struct output by min_quad_with_fixed_update_precompute
+  // Outputs:
+  //   data  struct updated for the new constraints
+  // Returns true on success, false on error
+  template <typename T, typename Derivedknown>
+  IGL_INLINE bool min_quad_with_fixed_update(
+    const Eigen::MatrixBase<Derivedknown> & known,
+    const Eigen::SparseMatrix<T>& Aeq,
+    min_quad_with_fixed_update_data<T> & data);
+  // MIN_QUAD_WITH_FIXED_UPDATE_SOLVE Solve the current problem
+  //
+  // Inputs:
+  //   data  struct output by min_quad_with_fixed_update
+  //   B  n by 1 or n by cols list of linear coefficients
+  //   Y  #known by cols list of fixed values (in the order of the last known
+  //     list)
+  //   Beq  m by 1 or m by cols list of linear equality constraint constant
+  //     values
+  // Outputs:
+  //   Z  n by cols solution
+  // Returns true on success, false on error
+  template <
+    typename T,
+    typename DerivedB,
+    typename DerivedY,
+    typename DerivedBeq,
+    typename DerivedZ>
+  IGL_INLINE bool min_quad_with_fixed_update_solve(
+    const min_quad_with_fixed_update_data<T> & data,
+    const Eigen::MatrixBase<DerivedB> & B,
+    const Eigen::MatrixBase<DerivedY> & Y,
+    const Eigen::MatrixBase<DerivedBeq> & Beq,
+    Eigen::PlainObjectBase<DerivedZ> & Z);
+}
+
+template <typename T>
+struct igl::min_quad_with_fixed_update_data
+{
+  typedef Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> MatrixXT;
+  // Maximum number of modifications (freed and newly fixed variables, added
+  // equality constraints) before refactoring {16}
+  int max_updates;
+  // Matrix of quadratic coefficients
+  Eigen::SparseMatrix<T> A;
+  // Transpose of A if A is not symmetric, otherwise empty
+  Eigen::SparseMatrix<T> AT;
+  // Whether A(unknown,unknown) is positive definite
+  bool pd;
+  // Base problem: factorization, linear equality constraints and position of
+  // each variable in base.unknown (-1 if known)
+  min_quad_with_fixed_data<T> base;
+  Eigen::SparseMatrix<T> Aeq;
+  Eigen::VectorXi unknown_pos;
+  // Current known variables
+  Eigen::VectorXi known;
+  // Modifications: base known variables now free, indices into known of
+  // base unknown variables now fixed and rows of Aeq added to the base ones
+  Eigen::VectorXi freed;
+  Eigen::VectorXi fixed;
+  Eigen::SparseMatrix<T,Eigen::RowMajor> Aeq_added;
+  // Schur complement correction: #modifications by #unknowns+#lagrange
+  // coupling of the modifications to the base system, base solutions for
+  // the #unknowns+#lagrange by #modifications couplings the other way
+  // around, and factorization of the #modifications by #modifications Schur
+  // complement
+  Eigen::SparseMatrix<T> Gr;
+  MatrixXT W;
+  Eigen::FullPivLU<MatrixXT> S;
+  min_quad_with_fixed_update_data():max_updates(16),pd(false){};
+};
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "min_quad_with_fixed_update.cpp"
+#endif
+
+#endif
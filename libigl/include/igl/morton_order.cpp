@@ -0,0 +1,68 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "morton_order.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+template <typename DerivedP, typename DerivedI>
+IGL_INLINE void igl::morton_order(
+  const Eigen::MatrixBase<DerivedP> & P,
+  Eigen::PlainObjectBase<DerivedI> & I)
+{
+  typedef typename DerivedP::Scalar Scalar;
+  const int n = P.rows();
+  const int dim = P.cols();
+  assert(dim >= 1 && dim <= 63 && "dim should be in [1,63]");
+  I.resize(n,1);
+  if(n == 0)
+  {
+    return;
+  }
+  const Eigen::Matrix<Scalar,1,Eigen::Dynamic> min_P = P.colwise().minCoeff();
+  const Eigen::Matrix<Scalar,1,Eigen::Dynamic> max_P = P.colwise().maxCoeff();
+  const int bits = 63/dim;
+  const double cells = double((std::uint64_t(1)<<bits)-1);
+  std::vector<std::uint64_t> codes(n);
+  parallel_for(n,[&](const int i)
+  {
+    std::uint64_t code = 0;
+    for(int d = 0;d<dim;d++)
+    {
+      const double extent = double(max_P(d)-min_P(d));
+      const std::uint64_t q = extent > 0 ?
+        std::uint64_t(double(P(i,d)-min_P(d))/extent*cells) : 0;
+      // Interleave: bit b of coordinate d goes to bit b*dim+d
+      for(int b = 0;b<bits;b++)
+      {
+        code |= ((q>>b)&std::uint64_t(1)) << (b*dim+d);
+      }
+    }
+    codes[i] = code;
+  },1000);
+  std::vector<int> order(n);
+  for(int i = 0;i<n;i++)
+  {
+    order[i] = i;
+  }
+  std::sort(order.begin(),order.end(),[&codes](const int a, const int b)
+  {
+    return codes[a] < codes[b] || (codes[a] == codes[b] && a < b);
+  });
+  for(int i = 0;i<n;i++)
+  {
+    I(i) = order[i];
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::morton_order<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+#endif
@@ -0,0 +1,31 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_MORTON_ORDER_H
+#define IGL_MORTON_ORDER_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  // Order points along a Morton (Z-order) space filling curve, so that points
+  // close in the order tend to be close in space. Coordinates are quantized
+  // to 63/dim bits within the bounding box of P.
+  //
+  // Inputs:
+  //   P  #P by dim list of points
+  // Outputs:
+  //   I  #P list of indices into P so that P(I,:) is in Morton order (ties
+  //     broken by index)
+  template <typename DerivedP, typename DerivedI>
+  IGL_INLINE void morton_order(
+    const Eigen::MatrixBase<DerivedP> & P,
+    Eigen::PlainObjectBase<DerivedI> & I);
+}
+#ifndef IGL_STATIC_LIBRARY
+#  include "morton_order.cpp"
+#endif
+#endif
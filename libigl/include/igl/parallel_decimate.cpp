@@ -0,0 +1,291 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "parallel_decimate.h"
+#include "IndexedPriorityQueue.h"
+#include "circulation.h"
+#include "collapse_edge.h"
+#include "connect_boundary_to_infinity.h"
+#include "edge_flaps.h"
+#include "parallel_for.h"
+#include "remove_unreferenced.h"
+#include "shortest_edge_and_midpoint.h"
+#include "slice.h"
+#include "slice_mask.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+IGL_INLINE bool igl::parallel_decimate(
+  const Eigen::MatrixXd & OV,
+  const Eigen::MatrixXi & OF,
+  const std::function<void(
+    const int,
+    const Eigen::MatrixXd &,
+    const Eigen::MatrixXi &,
+    const Eigen::MatrixXi &,
+    const Eigen::VectorXi &,
+    const Eigen::MatrixXi &,
+    const Eigen::MatrixXi &,
+    double &,
+    Eigen::RowVectorXd &)> & cost_and_placement,
+  const std::function<void(
+    const int,
+    const int,
+    const int)> & post_collapse,
+  const Eigen::MatrixXi & OE,
+  const Eigen::VectorXi & OEMAP,
+  const Eigen::MatrixXi & OEF,
+  const Eigen::MatrixXi & OEI,
+  const size_t max_m,
+  const double eligible_fraction,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
+{
+  using namespace Eigen;
+  using namespace std;
+  // Working copies
+  MatrixXd V = OV;
+  MatrixXi F = OF;
+  MatrixXi E = OE;
+  VectorXi EMAP = OEMAP;
+  MatrixXi EF = OEF;
+  MatrixXi EI = OEI;
+  const double inf = std::numeric_limits<double>::infinity();
+  // Vertices at infinity are shared by all collapses and never collapsed
+  vector<char> finite(V.rows());
+  for(int v = 0;v<V.rows();v++)
+  {
+    finite[v] = V.row(v).allFinite();
+  }
+  const auto is_real = [&F,&finite](const int f)
+  {
+    return finite[F(f,0)] && finite[F(f,1)] && finite[F(f,2)];
+  };
+  // Number of real faces
+  int m = 0;
+  for(int f = 0;f<F.rows();f++)
+  {
+    m += is_real(f);
+  }
+
+  IndexedPriorityQueue<> Q;
+  Q.resize(E.rows());
+  MatrixXd C(E.rows(),V.cols());
+  vector<double> costs(E.rows());
+  parallel_for(E.rows(),[&](const int e)
+  {
+    RowVectorXd p(1,V.cols());
+    cost_and_placement(e,V,F,E,EMAP,EF,EI,costs[e],p);
+    C.row(e) = p;
+  },1000);
+  for(int e = 0;e<E.rows();e++)
+  {
+    const bool touches_inf = !finite[E(e,0)] || !finite[E(e,1)];
+    Q.update(e,touches_inf ? inf : costs[e]);
+  }
+
+  // Round in which each vertex was last claimed by a selected collapse
+  vector<int> claimed(V.rows(),-1);
+  // Round in which each edge was last marked for a cost update
+  vector<int> marked(E.rows(),-1);
+  // Per candidate: faces around its edge
+  vector<vector<int> > N;
+  vector<int> candidates,selected,e1s,e2s,f1s,f2s,update;
+  vector<char> collapsed;
+  bool clean_finish = m <= (int)max_m;
+  for(int round = 0;!clean_finish;round++)
+  {
+    if(Q.empty() || Q.top().first == inf)
+    {
+      break;
+    }
+    // Pop eligible edges in order of cost
+    const int num_eligible = std::max(1,(int)(eligible_fraction*Q.size()));
+    candidates.clear();
+    while((int)candidates.size() < num_eligible &&
+      !Q.empty() && Q.top().first != inf)
+    {
+      candidates.push_back(Q.top().second);
+      costs[Q.top().second] = Q.top().first;
+      Q.pop();
+    }
+    // Faces around each candidate
+    N.resize(candidates.size());
+    parallel_for(candidates.size(),[&](const int c)
+    {
+      const int e = candidates[c];
+      N[c] = circulation(e, true,F,E,EMAP,EF,EI);
+      const vector<int> Nd = circulation(e,false,F,E,EMAP,EF,EI);
+      N[c].insert(N[c].end(),Nd.begin(),Nd.end());
+    },1000);
+    // Greedily select candidates with disjoint neighborhoods. Each collapse
+    // removes at most two real faces: don't collapse more than needed.
+    const int max_selected = (m-(int)max_m+1)/2;
+    selected.clear();
+    vector<int> selected_N;
+    for(int c = 0;c<(int)candidates.size();c++)
+    {
+      const int e = candidates[c];
+      bool free = (int)selected.size() < max_selected;
+      for(int i = 0;free && i<(int)N[c].size();i++)
+      {
+        for(int k = 0;k<3;k++)
+        {
+          const int v = F(N[c][i],k);
+          if(finite[v] && claimed[v] == round)
+          {
+            free = false;
+            break;
+          }
+        }
+      }
+      if(!free)
+      {
+        // Try again next round
+        Q.update(e,costs[e]);
+        continue;
+      }
+      for(const int f : N[c])
+      {
+        for(int k = 0;k<3;k++)
+        {
+          claimed[F(f,k)] = round;
+        }
+      }
+      selected.push_back(e);
+      selected_N.push_back(c);
+    }
+    // Validate and collapse in parallel
+    const int ns = selected.size();
+    collapsed.assign(ns,false);
+    e1s.resize(ns);
+    e2s.resize(ns);
+    f1s.resize(ns);
+    f2s.resize(ns);
+    vector<int> removed(ns,0);
+    parallel_for(ns,[&](const int i)
+    {
+      const int e = selected[i];
+      const int s = std::min(E(e,0),E(e,1));
+      const int d = std::max(E(e,0),E(e,1));
+      const int real = is_real(EF(e,0)) + is_real(EF(e,1));
+      collapsed[i] = collapse_edge(
+        e,C.row(e),V,F,E,EMAP,EF,EI,e1s[i],e2s[i],f1s[i],f2s[i]);
+      if(collapsed[i])
+      {
+        removed[i] = real;
+        post_collapse(e,s,d);
+      }
+    },16);
+    // Update queue and gather edges of faces around collapsed edges
+    update.clear();
+    for(int i = 0;i<ns;i++)
+    {
+      const int e = selected[i];
+      if(!collapsed[i])
+      {
+        // reinsert with infinite weight (see collapse_edge)
+        Q.update(e,inf);
+        continue;
+      }
+      m -= removed[i];
+      Q.erase(e1s[i]);
+      Q.erase(e2s[i]);
+      for(const int n : N[selected_N[i]])
+      {
+        if(F(n,0) == IGL_COLLAPSE_EDGE_NULL &&
+            F(n,1) == IGL_COLLAPSE_EDGE_NULL &&
+            F(n,2) == IGL_COLLAPSE_EDGE_NULL)
+        {
+          continue;
+        }
+        for(int v = 0;v<3;v++)
+        {
+          const int ei = EMAP(v*F.rows()+n);
+          if(marked[ei] != round)
+          {
+            marked[ei] = round;
+            update.push_back(ei);
+          }
+        }
+      }
+    }
+    // Recompute costs in parallel
+    parallel_for(update.size(),[&](const int u)
+    {
+      const int e = update[u];
+      RowVectorXd p(1,V.cols());
+      cost_and_placement(e,V,F,E,EMAP,EF,EI,costs[e],p);
+      C.row(e) = p;
+    },1000);
+    for(const int e : update)
+    {
+      const bool touches_inf = !finite[E(e,0)] || !finite[E(e,1)];
+      Q.update(e,touches_inf ? inf : costs[e]);
+    }
+    clean_finish = m <= (int)max_m;
+  }
+
+  // remove all IGL_COLLAPSE_EDGE_NULL faces
+  MatrixXi F2(F.rows(),3);
+  J.resize(F.rows());
+  int nf = 0;
+  for(int f = 0;f<F.rows();f++)
+  {
+    if(
+      F(f,0) != IGL_COLLAPSE_EDGE_NULL ||
+      F(f,1) != IGL_COLLAPSE_EDGE_NULL ||
+      F(f,2) != IGL_COLLAPSE_EDGE_NULL)
+    {
+      F2.row(nf) = F.row(f);
+      J(nf) = f;
+      nf++;
+    }
+  }
+  F2.conservativeResize(nf,F2.cols());
+  J.conservativeResize(nf);
+  VectorXi _1;
+  remove_unreferenced(V,F2,U,G,_1,I);
+  return clean_finish;
+}
+
+IGL_INLINE bool igl::parallel_decimate(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const size_t max_m,
+  const double eligible_fraction,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
+{
+  const int orig_m = F.rows();
+  Eigen::MatrixXd VO;
+  Eigen::MatrixXi FO;
+  igl::connect_boundary_to_infinity(V,F,VO,FO);
+  Eigen::VectorXi EMAP;
+  Eigen::MatrixXi E,EF,EI;
+  edge_flaps(FO,E,EMAP,EF,EI);
+  bool ret = parallel_decimate(
+    VO,FO,
+    shortest_edge_and_midpoint,
+    [](const int,const int,const int){},
+    E,EMAP,EF,EI,
+    max_m,eligible_fraction,
+    U,G,J,I);
+  const Eigen::Array<bool,Eigen::Dynamic,1> keep = (J.array()<orig_m);
+  igl::slice_mask(Eigen::MatrixXi(G),keep,1,G);
+  igl::slice_mask(Eigen::VectorXi(J),keep,1,J);
+  Eigen::VectorXi _1,I2;
+  igl::remove_unreferenced(Eigen::MatrixXd(U),Eigen::MatrixXi(G),U,G,_1,I2);
+  igl::slice(Eigen::VectorXi(I),I2,1,I);
+  return ret;
+}
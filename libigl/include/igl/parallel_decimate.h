@@ -0,0 +1,118 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PARALLEL_DECIMATE_H
+#define IGL_PARALLEL_DECIMATE_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <functional>
+namespace igl
+{
+  // Decimate a mesh by collapsing batches of edges in parallel. Each round
+  // takes the eligible_fraction cheapest edges of the queue, greedily selects
+  // (in order of cost) a maximal subset of them whose neighborhoods (all
+  // vertices of all faces incident on either endpoint) are pairwise disjoint,
+  // validates (see edge_collapse_is_valid) and collapses the selected edges in
+  // parallel, and finally recomputes in parallel the costs of the edges of
+  // the faces around the collapsed edges only.
+  //
+  // eligible_fraction trades quality for throughput: as it approaches 0
+  // every round collapses only the cheapest edge, as does igl::decimate.
+  // Larger values collapse more edges per round, some of them out of strict
+  // cost order. The output does not depend on the number of threads.
+  //
+  // Vertices with non-finite positions (i.e., the point at infinity added by
+  // igl::connect_boundary_to_infinity) are shared between batched
+  // collapses, edges incident on them are never collapsed and faces incident
+  // on them do not count toward max_m.
+  //
+  // Inputs:
+  //   V  #V by dim list of vertex positions
+  //   F  #F by 3 list of face indices into V of a **closed** manifold mesh
+  //   cost_and_placement  function computing cost of collapsing an edge and
+  //     the position where it should be placed (see decimate.h). Called
+  //     concurrently from several threads: it must not modify shared state.
+  //   post_collapse  function called after edge e=(s,d) with s<d has been
+  //     collapsed onto s: post_collapse(e,s,d). Called concurrently from
+  //     several threads: it may only modify data associated with s and d.
+  //   E  #E by 2 list of edge indices into V (see edge_flaps.h)
+  //   EMAP #F*3 list of indices into E, mapping each directed edge to unique
+  //     unique edge in E
+  //   EF  #E by 2 list of edge flaps
+  //   EI  #E by 2 list of edge flap corners
+  //   max_m  desired number of output faces (not counting faces incident on
+  //     vertices at infinity)
+  //   eligible_fraction  fraction in (0,1] of the queue eligible for
+  //     collapse in each round
+  // Outputs:
+  //   U  #U by dim list of output vertex posistions (can be same ref as V)
+  //   G  #G by 3 list of output face indices into U (can be same ref as G)
+  //   J  #G list of indices into F of birth face
+  //   I  #U list of indices into V of birth vertices
+  // Returns true if max_m was reached (otherwise #G > max_m)
+  //
+  // See also: decimate, qslim, parallel_qslim
+  IGL_INLINE bool parallel_decimate(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const std::function<void(
+      const int              /*e*/,
+      const Eigen::MatrixXd &/*V*/,
+      const Eigen::MatrixXi &/*F*/,
+      const Eigen::MatrixXi &/*E*/,
+      const Eigen::VectorXi &/*EMAP*/,
+      const Eigen::MatrixXi &/*EF*/,
+      const Eigen::MatrixXi &/*EI*/,
+      double &               /*cost*/,
+      Eigen::RowVectorXd &   /*p*/
+      )> & cost_and_placement,
+    const std::function<void(
+      const int              /*e*/,
+      const int              /*s*/,
+      const int              /*d*/
+      )> & post_collapse,
+    const Eigen::MatrixXi & E,
+    const Eigen::VectorXi & EMAP,
+    const Eigen::MatrixXi & EF,
+    const Eigen::MatrixXi & EI,
+    const size_t max_m,
+    const double eligible_fraction,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
+  // Decimate a manifold mesh (possibly with boundary) using the default edge
+  // cost and merged vertex placement functions {edge length, edge midpoint}
+  // (see decimate.h).
+  //
+  // Inputs:
+  //   V  #V by dim list of vertex positions
+  //   F  #F by 3 list of face indices into V.
+  //   max_m  desired number of output faces
+  //   eligible_fraction  fraction in (0,1] of the queue eligible for
+  //     collapse in each round
+  // Outputs:
+  //   U  #U by dim list of output vertex posistions (can be same ref as V)
+  //   G  #G by 3 list of output face indices into U (can be same ref as G)
+  //   J  #G list of indices into F of birth face
+  //   I  #U list of indices into V of birth vertices
+  // Returns true if max_m was reached (otherwise #G > max_m)
+  IGL_INLINE bool parallel_decimate(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const size_t max_m,
+    const double eligible_fraction,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "parallel_decimate.cpp"
+#endif
+#endif
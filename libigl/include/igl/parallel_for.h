@@ -8,6 +8,7 @@
 #ifndef IGL_PARALLEL_FOR_H
 #define IGL_PARALLEL_FOR_H
 #include "igl_inline.h"
+#include "ThreadPool.h"
 #include <functional>
 
 namespace igl
@@ -22,9 +23,12 @@ namespace igl
   //       func(i);
   //     }
   //
-  // then `parallel_for(loop_size,func,min_parallel)` will use as many threads as
-  // available on the current hardware to parallelize this for loop so long as
-  // loop_size<min_parallel, otherwise it will just use a serial for loop.
+  // then `parallel_for(loop_size,func,min_parallel)` will use the threads of
+  // igl::ThreadPool::instance() to parallelize this for loop so long as
+  // loop_size>=min_parallel, otherwise it will just use a serial for loop.
+  // Iterations are handed out dynamically (see ThreadPool.h), so the number of
+  // threads and the chunk size can be tuned at runtime via
+  // igl::ThreadPool::instance().set_num_threads(n) and set_grain_size(g).
   //
   // Inputs:
   //   loop_size  number of iterations. I.e. for(int i = 0;i<loop_size;i++) ...
@@ -86,11 +90,7 @@ namespace igl
 
 // Implementation
 
-#include <cmath>
 #include <cassert>
-#include <thread>
-#include <vector>
-#include <algorithm>
 
 template<typename Index, typename FunctionType >
 inline bool igl::parallel_for(
@@ -120,16 +120,14 @@ inline bool igl::parallel_for(
 {
   assert(loop_size>=0);
   if(loop_size==0) return false;
-  // Estimate number of threads in the pool
-  // http://ideone.com/Z7zldb
-  const static size_t sthc = std::thread::hardware_concurrency();
+  ThreadPool & pool = ThreadPool::instance();
   const size_t nthreads = 
 #ifdef IGL_PARALLEL_FOR_FORCE_SERIAL
     0;
 #else
-    loop_size<min_parallel?0:(sthc==0?8:sthc);
+    (size_t)loop_size<min_parallel?0:pool.num_threads();
 #endif
-  if(nthreads==0)
+  if(nthreads<=1)
   {
     // serial
     prep_func(1);
@@ -138,38 +136,15 @@ inline bool igl::parallel_for(
     return false;
   }else
   {
-    // Size of a slice for the range functions
-    Index slice = 
-      std::max(
-        (Index)std::round((loop_size+1)/static_cast<double>(nthreads)),(Index)1);
- 
-    // [Helper] Inner loop
-    const auto & range = [&func](const Index k1, const Index k2, const size_t t)
+    // [Helper] Inner loop over a chunk handed out by the pool
+    const ThreadPool::ChunkFunction range = 
+      [&func](const long long k1, const long long k2, const size_t t)
     {
-      for(Index k = k1; k < k2; k++) func(k,t);
+      for(Index k = (Index)k1; k < (Index)k2; k++) func(k,t);
     };
     prep_func(nthreads);
-    // Create pool and launch jobs
-    std::vector<std::thread> pool;
-    pool.reserve(nthreads);
-    // Inner range extents
-    Index i1 = 0;
-    Index i2 = std::min(0 + slice, loop_size);
-    {
-      size_t t = 0;
-      for (; t+1 < nthreads && i1 < loop_size; ++t)
-      {
-        pool.emplace_back(range, i1, i2, t);
-        i1 = i2;
-        i2 = std::min(i2 + slice, loop_size);
-      }
-      if (i1 < loop_size)
-      {
-        pool.emplace_back(range, i1, loop_size, t);
-      }
-    }
-    // Wait for jobs to finish
-    for (std::thread &t : pool) if (t.joinable()) t.join();
+    // Blocks until all chunks are done
+    pool.run((long long)loop_size,range);
     // Accumulate across threads
     for(size_t t = 0;t<nthreads;t++)
     {
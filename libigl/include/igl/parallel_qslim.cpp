@@ -0,0 +1,73 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "parallel_qslim.h"
+
+#include "IndexedPriorityQueue.h"
+#include "connect_boundary_to_infinity.h"
+#include "edge_flaps.h"
+#include "parallel_decimate.h"
+#include "per_vertex_point_to_plane_quadrics.h"
+#include "qslim_optimal_collapse_edge_callbacks.h"
+#include "quadric_binary_plus_operator.h"
+#include "remove_unreferenced.h"
+#include "slice.h"
+#include "slice_mask.h"
+
+IGL_INLINE bool igl::parallel_qslim(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const size_t max_m,
+  const double eligible_fraction,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
+{
+  using namespace igl;
+  // Original number of faces
+  const int orig_m = F.rows();
+  Eigen::MatrixXd VO;
+  Eigen::MatrixXi FO;
+  igl::connect_boundary_to_infinity(V,F,VO,FO);
+  Eigen::VectorXi EMAP;
+  Eigen::MatrixXi E,EF,EI;
+  edge_flaps(FO,E,EMAP,EF,EI);
+  // Quadrics per vertex
+  typedef std::tuple<Eigen::MatrixXd,Eigen::RowVectorXd,double> Quadric;
+  std::vector<Quadric> quadrics;
+  per_vertex_point_to_plane_quadrics(VO,FO,EMAP,EF,EI,quadrics);
+  // The cost only reads the quadrics of the endpoints (the endpoint state
+  // variables are only used by the serial pre/post collapse callbacks)
+  int v1 = -1;
+  int v2 = -1;
+  typedef IndexedPriorityQueue<> PQ;
+  decimate_callback_types<PQ>::cost_and_placement cost_and_placement;
+  decimate_callback_types<PQ>::pre_collapse pre_collapse;
+  decimate_callback_types<PQ>::post_collapse post_collapse;
+  qslim_optimal_collapse_edge_callbacks<PQ>(
+    E,quadrics,v1,v2, cost_and_placement, pre_collapse,post_collapse);
+  // Merge quadrics onto surviving vertex (only touches s and d)
+  bool ret = parallel_decimate(
+    VO, FO,
+    cost_and_placement,
+    [&quadrics](const int, const int s, const int d)
+    {
+      quadrics[s] = quadrics[s] + quadrics[d];
+    },
+    E, EMAP, EF, EI,
+    max_m, eligible_fraction,
+    U, G, J, I);
+  // Remove phony boundary faces and clean up
+  const Eigen::Array<bool,Eigen::Dynamic,1> keep = (J.array()<orig_m);
+  igl::slice_mask(Eigen::MatrixXi(G),keep,1,G);
+  igl::slice_mask(Eigen::VectorXi(J),keep,1,J);
+  Eigen::VectorXi _1,I2;
+  igl::remove_unreferenced(Eigen::MatrixXd(U),Eigen::MatrixXi(G),U,G,_1,I2);
+  igl::slice(Eigen::VectorXi(I),I2,1,I);
+  return ret;
+}
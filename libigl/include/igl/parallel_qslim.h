@@ -0,0 +1,44 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PARALLEL_QSLIM_H
+#define IGL_PARALLEL_QSLIM_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  // Decimate (simplify) a triangle mesh in nD with the quadric error metric
+  // of igl::qslim, collapsing batches of edges with disjoint neighborhoods in
+  // parallel (see parallel_decimate.h).
+  //
+  // Inputs:
+  //   V  #V by dim list of vertex positions.
+  //   F  #F by 3 list of triangle indices into V
+  //   max_m  desired number of output faces
+  //   eligible_fraction  fraction in (0,1] of the queue eligible for
+  //     collapse in each round (smaller is closer to qslim, larger is faster)
+  // Outputs:
+  //   U  #U by dim list of output vertex posistions (can be same ref as V)
+  //   G  #G by 3 list of output face indices into U (can be same ref as G)
+  //   J  #G list of indices into F of birth face
+  //   I  #U list of indices into V of birth vertices
+  // Returns true if max_m was reached (otherwise #G > max_m)
+  IGL_INLINE bool parallel_qslim(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const size_t max_m,
+    const double eligible_fraction,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "parallel_qslim.cpp"
+#endif
+#endif
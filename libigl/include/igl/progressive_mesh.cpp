@@ -0,0 +1,231 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "progressive_mesh.h"
+#include "IndexedPriorityQueue.h"
+#include "circulation.h"
+#include "collapse_edge.h"
+#include "connect_boundary_to_infinity.h"
+#include "decimate.h"
+#include "edge_flaps.h"
+#include "max_faces_stopping_condition.h"
+#include "shortest_edge_and_midpoint.h"
+#include <cstring>
+#include <limits>
+
+template <typename PriorityQueue>
+IGL_INLINE bool igl::progressive_mesh(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const typename igl::decimate_callback_types<PriorityQueue>::cost_and_placement
+    & cost_and_placement,
+  const typename igl::decimate_callback_types<PriorityQueue>::stopping_condition
+    & stopping_condition,
+  const typename igl::decimate_callback_types<PriorityQueue>::pre_collapse
+    & pre_collapse,
+  const typename igl::decimate_callback_types<PriorityQueue>::post_collapse
+    & post_collapse,
+  const Eigen::MatrixXi & E,
+  const Eigen::VectorXi & EMAP,
+  const Eigen::MatrixXi & EF,
+  const Eigen::MatrixXi & EI,
+  igl::ProgressiveMesh & PM)
+{
+  using namespace std;
+  const int dim = V.cols();
+  vector<char> & collapses = PM.collapses;
+  collapses.clear();
+  const auto write = [](vector<char> & buffer,const void * data,size_t size)
+  {
+    const char * bytes = static_cast<const char *>(data);
+    buffer.insert(buffer.end(),bytes,bytes+size);
+  };
+  const auto is_real = [](const Eigen::MatrixXd & V,const int * f)->bool
+  {
+    return
+      V.row(f[0]).allFinite() && V.row(f[1]).allFinite() &&
+      V.row(f[2]).allFinite();
+  };
+  // Record of the collapse about to happen (see ProgressiveMesh::collapses)
+  vector<char> pending;
+  int s = -1;
+  const typename decimate_callback_types<PriorityQueue>::pre_collapse
+    record_pre_collapse = [&](
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const Eigen::MatrixXi & E,
+    const Eigen::VectorXi & EMAP,
+    const Eigen::MatrixXi & EF,
+    const Eigen::MatrixXi & EI,
+    const PriorityQueue & Q,
+    const Eigen::MatrixXd & C,
+    const int e)->bool
+  {
+    if(!pre_collapse(V,F,E,EMAP,EF,EI,Q,C,e))
+    {
+      return false;
+    }
+    // Same conventions as collapse_edge
+    const bool eflip = E(e,0)>E(e,1);
+    s = eflip?E(e,1):E(e,0);
+    const int d = eflip?E(e,0):E(e,1);
+    const int f[2] = {EF(e,0),EF(e,1)};
+    int f_corners[2][3];
+    int real = 0;
+    for(int side = 0;side<2;side++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        f_corners[side][c] = F(f[side],c);
+      }
+      real += is_real(V,f_corners[side]) ? 1 : 0;
+    }
+    // Corners of d on faces that survive the collapse
+    vector<int> corners;
+    for(const int g : circulation(e,!eflip,F,E,EMAP,EF,EI))
+    {
+      if(g == f[0] || g == f[1])
+      {
+        continue;
+      }
+      for(int c = 0;c<3;c++)
+      {
+        if(F(g,c) == d)
+        {
+          corners.push_back(3*g+c);
+        }
+      }
+    }
+    const int header[6] = {s,d,f[0],f[1],real,(int)corners.size()};
+    pending.clear();
+    write(pending,header,sizeof(header));
+    write(pending,f_corners,sizeof(f_corners));
+    write(pending,corners.data(),corners.size()*sizeof(int));
+    const Eigen::RowVectorXd Vs = V.row(s);
+    const Eigen::RowVectorXd Vd = V.row(d);
+    write(pending,Vs.data(),dim*sizeof(double));
+    write(pending,Vd.data(),dim*sizeof(double));
+    return true;
+  };
+  const typename decimate_callback_types<PriorityQueue>::post_collapse
+    record_post_collapse = [&](
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const Eigen::MatrixXi & E,
+    const Eigen::VectorXi & EMAP,
+    const Eigen::MatrixXi & EF,
+    const Eigen::MatrixXi & EI,
+    const PriorityQueue & Q,
+    const Eigen::MatrixXd & C,
+    const int e,
+    const int e1,
+    const int e2,
+    const int f1,
+    const int f2,
+    const bool collapsed)
+  {
+    if(collapsed)
+    {
+      const Eigen::RowVectorXd p = V.row(s);
+      write(pending,p.data(),dim*sizeof(double));
+      const int size = pending.size()+sizeof(int);
+      write(pending,&size,sizeof(int));
+      collapses.insert(collapses.end(),pending.begin(),pending.end());
+    }
+    post_collapse(V,F,E,EMAP,EF,EI,Q,C,e,e1,e2,f1,f2,collapsed);
+  };
+
+  Eigen::MatrixXd U;
+  Eigen::MatrixXi G;
+  Eigen::VectorXi J,I;
+  const bool ret = decimate<PriorityQueue>(
+    Eigen::MatrixXd(V),Eigen::MatrixXi(F),
+    cost_and_placement,stopping_condition,
+    record_pre_collapse,record_post_collapse,
+    Eigen::MatrixXi(E),Eigen::VectorXi(EMAP),
+    Eigen::MatrixXi(EF),Eigen::MatrixXi(EI),
+    U,G,J,I);
+  vector<char>(collapses).swap(collapses);
+
+  // Base mesh in the index space of the full mesh
+  PM.V = V;
+  for(int u = 0;u<U.rows();u++)
+  {
+    PM.V.row(I(u)) = U.row(u);
+  }
+  PM.F.setConstant(F.rows(),3,IGL_COLLAPSE_EDGE_NULL);
+  PM.m = 0;
+  for(int g = 0;g<G.rows();g++)
+  {
+    int f[3];
+    for(int c = 0;c<3;c++)
+    {
+      f[c] = PM.F(J(g),c) = I(G(g,c));
+    }
+    PM.m += is_real(PM.V,f) ? 1 : 0;
+  }
+  PM.next = collapses.size();
+  return ret;
+}
+
+IGL_INLINE bool igl::progressive_mesh(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const size_t min_m,
+  igl::ProgressiveMesh & PM)
+{
+  // Original number of faces
+  const int orig_m = F.rows();
+  // Tracking number of faces
+  int m = F.rows();
+  Eigen::MatrixXd VO;
+  Eigen::MatrixXi FO;
+  igl::connect_boundary_to_infinity(V,F,VO,FO);
+  Eigen::VectorXi EMAP;
+  Eigen::MatrixXi E,EF,EI;
+  edge_flaps(FO,E,EMAP,EF,EI);
+  typedef IndexedPriorityQueue<> PQ;
+  const auto always_try = [](
+    const Eigen::MatrixXd &                                         ,/*V*/
+    const Eigen::MatrixXi &                                         ,/*F*/
+    const Eigen::MatrixXi &                                         ,/*E*/
+    const Eigen::VectorXi &                                         ,/*EMAP*/
+    const Eigen::MatrixXi &                                         ,/*EF*/
+    const Eigen::MatrixXi &                                         ,/*EI*/
+    const PQ &                                                      ,/*Q*/
+    const Eigen::MatrixXd &                                         ,/*C*/
+    const int                                                        /*e*/
+    ) -> bool { return true;};
+  const auto never_care = [](
+    const Eigen::MatrixXd &                                         ,   /*V*/
+    const Eigen::MatrixXi &                                         ,   /*F*/
+    const Eigen::MatrixXi &                                         ,   /*E*/
+    const Eigen::VectorXi &                                         ,/*EMAP*/
+    const Eigen::MatrixXi &                                         ,  /*EF*/
+    const Eigen::MatrixXi &                                         ,  /*EI*/
+    const PQ &                                                      ,   /*Q*/
+    const Eigen::MatrixXd &                                         ,   /*C*/
+    const int                                                       ,   /*e*/
+    const int                                                       ,  /*e1*/
+    const int                                                       ,  /*e2*/
+    const int                                                       ,  /*f1*/
+    const int                                                       ,  /*f2*/
+    const bool                                                  /*collapsed*/
+    )-> void { };
+  return progressive_mesh<PQ>(
+    VO,FO,
+    shortest_edge_and_midpoint,
+    max_faces_stopping_condition<PQ>(m,orig_m,min_m),
+    always_try,never_care,
+    E,EMAP,EF,EI,
+    PM);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template bool igl::progressive_mesh<igl::IndexedPriorityQueue<4> >(Eigen::MatrixXd const&, Eigen::MatrixXi const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::cost_and_placement const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::stopping_condition const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::pre_collapse const&, igl::decimate_callback_types<igl::IndexedPriorityQueue<4> >::post_collapse const&, Eigen::MatrixXi const&, Eigen::VectorXi const&, Eigen::MatrixXi const&, Eigen::MatrixXi const&, igl::ProgressiveMesh&);
+#endif
@@ -0,0 +1,115 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PROGRESSIVE_MESH_H
+#define IGL_PROGRESSIVE_MESH_H
+#include "igl_inline.h"
+#include "decimate_callback_types.h"
+#include <Eigen/Core>
+#include <vector>
+namespace igl
+{
+  // Progressive mesh ("Progressive Meshes" [Hoppe 1996]): the sequence of
+  // edge collapses of a decimation together with the mesh at one level of
+  // detail. Any level of detail between the base mesh (all collapses applied)
+  // and the full mesh (none applied) is reached from the current one by
+  // undoing collapses (vertex splits) or redoing them, in time proportional to
+  // the number of collapses in between (see progressive_mesh_lod).
+  //
+  // Vertices with non-finite positions (i.e., the point at infinity added by
+  // igl::connect_boundary_to_infinity) and faces incident on them are not part
+  // of any level of detail.
+  struct ProgressiveMesh
+  {
+    // #V by dim list of vertex positions and #F by 3 list of face indices
+    // into V of the current level of detail, in the index space of the full
+    // mesh: faces removed by applied collapses are IGL_COLLAPSE_EDGE_NULL and
+    // vertices removed by applied collapses are unreferenced.
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi F;
+    // Number of faces of the current level of detail
+    int m;
+    // Binary stream of all collapses in order. Each record holds the
+    // surviving and removed vertices s<d, the two removed faces and their
+    // corners, the other corners of d (which move to s), the positions of s
+    // and d before the collapse and of s after it, and ends with its size in
+    // bytes so that the stream can be read in both directions.
+    std::vector<char> collapses;
+    // Byte offset into collapses of the first collapse not applied to the
+    // current level of detail
+    size_t next;
+    ProgressiveMesh():m(0),next(0){}
+  };
+
+  // Decimate a mesh (see decimate.h) recording all collapses into a
+  // progressive mesh, whose current level of detail is set to the base mesh.
+  //
+  // Templates:
+  //   PriorityQueue  type of queue of (cost,edge) pairs (see decimate.h)
+  // Inputs:
+  //   V  #V by dim list of vertex positions
+  //   F  #F by 3 list of face indices into V of a **closed** manifold mesh
+  //   cost_and_placement  function computing cost of collapsing an edge and
+  //     the position where it should be placed (see decimate.h)
+  //   stopping_condition  function returning whether to stop collapsing
+  //     edges: the base mesh (see decimate.h)
+  //   pre_collapse  callback called before edge is collapsed (see
+  //     decimate.h)
+  //   post_collapse  callback called after edge is collapsed (see
+  //     decimate.h)
+  //   E  #E by 2 list of edge indices into V (see edge_flaps.h)
+  //   EMAP #F*3 list of indices into E, mapping each directed edge to unique
+  //     unique edge in E
+  //   EF  #E by 2 list of edge flaps
+  //   EI  #E by 2 list of edge flap corners
+  // Outputs:
+  //   PM  progressive mesh at the base mesh
+  // Returns true if stopping_condition was reached (otherwise no more edges
+  //   could be collapsed)
+  //
+  // See also: progressive_mesh_lod, progressive_qslim
+  template <typename PriorityQueue>
+  IGL_INLINE bool progressive_mesh(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const typename decimate_callback_types<PriorityQueue>::cost_and_placement
+      & cost_and_placement,
+    const typename decimate_callback_types<PriorityQueue>::stopping_condition
+      & stopping_condition,
+    const typename decimate_callback_types<PriorityQueue>::pre_collapse
+      & pre_collapse,
+    const typename decimate_callback_types<PriorityQueue>::post_collapse
+      & post_collapse,
+    const Eigen::MatrixXi & E,
+    const Eigen::VectorXi & EMAP,
+    const Eigen::MatrixXi & EF,
+    const Eigen::MatrixXi & EI,
+    ProgressiveMesh & PM);
+  // Build a progressive mesh of a manifold mesh (possibly with boundary)
+  // using the default edge cost and merged vertex placement functions {edge
+  // length, edge midpoint} (see decimate.h).
+  //
+  // Inputs:
+  //   V  #V by dim list of vertex positions
+  //   F  #F by 3 list of face indices into V.
+  //   min_m  desired number of faces of the base mesh
+  // Outputs:
+  //   PM  progressive mesh at the base mesh. Its vertices are V followed by
+  //     the point at infinity and its first #F faces are F.
+  // Returns true if min_m was reached (otherwise the base mesh has more than
+  //   min_m faces)
+  IGL_INLINE bool progressive_mesh(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const size_t min_m,
+    ProgressiveMesh & PM);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "progressive_mesh.cpp"
+#endif
+#endif
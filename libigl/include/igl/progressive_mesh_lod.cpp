@@ -0,0 +1,143 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "progressive_mesh_lod.h"
+#include "collapse_edge.h"
+#include "remove_unreferenced.h"
+#include <cassert>
+#include <cstring>
+
+namespace igl
+{
+  namespace progressive_mesh_lod_internal
+  {
+    // Read a value of type T from a record and advance past it
+    template <typename T>
+    IGL_INLINE void read(const char * & record,T * value,const int count)
+    {
+      std::memcpy(value,record,count*sizeof(T));
+      record += count*sizeof(T);
+    }
+    // Redo (collapse) or undo (vertex split) a recorded collapse (see
+    // ProgressiveMesh::collapses)
+    //
+    // Inputs:
+    //   record  pointer to the first byte of the record
+    //   collapse  whether to redo rather than undo
+    //   PM  progressive mesh
+    // Outputs:
+    //   PM  progressive mesh with the collapse redone or undone
+    // Returns size of the record in bytes
+    IGL_INLINE int apply(
+      const char * record,
+      const bool collapse,
+      ProgressiveMesh & PM)
+    {
+      const char * begin = record;
+      const int dim = PM.V.cols();
+      int header[6];
+      read(record,header,6);
+      const int s = header[0];
+      const int d = header[1];
+      const int real = header[4];
+      const int num_corners = header[5];
+      int f_corners[6];
+      read(record,f_corners,6);
+      const char * corners = record;
+      record += num_corners*sizeof(int);
+      Eigen::RowVectorXd Vs(dim),Vd(dim),p(dim);
+      read(record,Vs.data(),dim);
+      read(record,Vd.data(),dim);
+      read(record,p.data(),dim);
+      for(int i = 0;i<num_corners;i++)
+      {
+        int corner;
+        read(corners,&corner,1);
+        PM.F(corner/3,corner%3) = collapse ? s : d;
+      }
+      for(int side = 0;side<2;side++)
+      {
+        for(int c = 0;c<3;c++)
+        {
+          PM.F(header[2+side],c) =
+            collapse ? IGL_COLLAPSE_EDGE_NULL : f_corners[3*side+c];
+        }
+      }
+      PM.V.row(s) = collapse ? p : Vs;
+      PM.V.row(d) = collapse ? p : Vd;
+      PM.m += collapse ? -real : real;
+      return record-begin+sizeof(int);
+    }
+  }
+}
+
+IGL_INLINE int igl::progressive_mesh_lod(
+  const size_t max_m,
+  igl::ProgressiveMesh & PM)
+{
+  using namespace progressive_mesh_lod_internal;
+  const char * collapses = PM.collapses.data();
+  // Redo collapses while there are too many faces
+  while(PM.m > (int)max_m && PM.next < PM.collapses.size())
+  {
+    PM.next += apply(collapses+PM.next,true,PM);
+  }
+  // Undo collapses while there are few enough faces
+  while(PM.next > 0)
+  {
+    const char * end = collapses+PM.next-sizeof(int);
+    int size;
+    read(end,&size,1);
+    const char * record = collapses+PM.next-size;
+    int header[5];
+    read(record,header,5);
+    if(PM.m+header[4] > (int)max_m)
+    {
+      break;
+    }
+    PM.next -= apply(collapses+PM.next-size,false,PM);
+  }
+  return PM.m;
+}
+
+IGL_INLINE int igl::progressive_mesh_lod(
+  const size_t max_m,
+  igl::ProgressiveMesh & PM,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
+{
+  const int m = progressive_mesh_lod(max_m,PM);
+  Eigen::MatrixXi F(m,3);
+  J.resize(m);
+  int g = 0;
+  for(int f = 0;f<PM.F.rows();f++)
+  {
+    if(
+      PM.F(f,0) == IGL_COLLAPSE_EDGE_NULL &&
+      PM.F(f,1) == IGL_COLLAPSE_EDGE_NULL &&
+      PM.F(f,2) == IGL_COLLAPSE_EDGE_NULL)
+    {
+      continue;
+    }
+    if(
+      !PM.V.row(PM.F(f,0)).allFinite() ||
+      !PM.V.row(PM.F(f,1)).allFinite() ||
+      !PM.V.row(PM.F(f,2)).allFinite())
+    {
+      continue;
+    }
+    F.row(g) = PM.F.row(f);
+    J(g) = f;
+    g++;
+  }
+  assert(g == m);
+  Eigen::VectorXi _1;
+  remove_unreferenced(PM.V,F,U,G,_1,I);
+  return m;
+}
@@ -0,0 +1,50 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PROGRESSIVE_MESH_LOD_H
+#define IGL_PROGRESSIVE_MESH_LOD_H
+#include "igl_inline.h"
+#include "progressive_mesh.h"
+#include <Eigen/Core>
+namespace igl
+{
+  // Move a progressive mesh to the finest level of detail with at most max_m
+  // faces (or to the base mesh if it has more) by undoing or redoing
+  // collapses from its current level of detail. This takes time proportional
+  // to the number of collapses in between, independently of the size of the
+  // mesh, and never re-runs the decimation.
+  //
+  // Inputs:
+  //   max_m  desired number of faces
+  //   PM  progressive mesh (see progressive_mesh.h)
+  // Outputs:
+  //   PM  progressive mesh at the requested level of detail
+  // Returns number of faces of the level of detail (PM.m)
+  IGL_INLINE int progressive_mesh_lod(
+    const size_t max_m,
+    ProgressiveMesh & PM);
+  // Same as above but also extracts the level of detail as a compact mesh
+  // (in time linear in the size of the full mesh).
+  //
+  // Outputs:
+  //   U  #U by dim list of output vertex positions
+  //   G  #G by 3 list of output face indices into U
+  //   J  #G list of indices into PM.F of birth face
+  //   I  #U list of indices into PM.V of birth vertices
+  IGL_INLINE int progressive_mesh_lod(
+    const size_t max_m,
+    ProgressiveMesh & PM,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "progressive_mesh_lod.cpp"
+#endif
+#endif
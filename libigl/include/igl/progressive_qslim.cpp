@@ -0,0 +1,54 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "progressive_qslim.h"
+#include "connect_boundary_to_infinity.h"
+#include "edge_flaps.h"
+#include "IndexedPriorityQueue.h"
+#include "max_faces_stopping_condition.h"
+#include "per_vertex_point_to_plane_quadrics.h"
+#include "qslim_optimal_collapse_edge_callbacks.h"
+
+IGL_INLINE bool igl::progressive_qslim(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const size_t min_m,
+  igl::ProgressiveMesh & PM)
+{
+  // Original number of faces
+  const int orig_m = F.rows();
+  // Tracking number of faces
+  int m = F.rows();
+  Eigen::MatrixXd VO;
+  Eigen::MatrixXi FO;
+  igl::connect_boundary_to_infinity(V,F,VO,FO);
+  Eigen::VectorXi EMAP;
+  Eigen::MatrixXi E,EF,EI;
+  edge_flaps(FO,E,EMAP,EF,EI);
+  // Quadrics per vertex
+  typedef std::tuple<Eigen::MatrixXd,Eigen::RowVectorXd,double> Quadric;
+  std::vector<Quadric> quadrics;
+  per_vertex_point_to_plane_quadrics(VO,FO,EMAP,EF,EI,quadrics);
+  // State variables keeping track of edge we just collapsed
+  int v1 = -1;
+  int v2 = -1;
+  // Callbacks for computing and updating metric
+  typedef IndexedPriorityQueue<> PQ;
+  decimate_callback_types<PQ>::cost_and_placement cost_and_placement;
+  decimate_callback_types<PQ>::pre_collapse pre_collapse;
+  decimate_callback_types<PQ>::post_collapse post_collapse;
+  qslim_optimal_collapse_edge_callbacks<PQ>(
+    E,quadrics,v1,v2, cost_and_placement, pre_collapse,post_collapse);
+  return progressive_mesh<PQ>(
+    VO,FO,
+    cost_and_placement,
+    max_faces_stopping_condition<PQ>(m,orig_m,min_m),
+    pre_collapse,
+    post_collapse,
+    E,EMAP,EF,EI,
+    PM);
+}
@@ -0,0 +1,48 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PROGRESSIVE_QSLIM_H
+#define IGL_PROGRESSIVE_QSLIM_H
+#include "igl_inline.h"
+#include "progressive_mesh.h"
+#include <Eigen/Core>
+namespace igl
+{
+  // Build a progressive mesh with the collapses of igl::qslim. Levels of
+  // detail are then extracted with progressive_mesh_lod, e.g.,
+  //
+  //   igl::ProgressiveMesh PM;
+  //   igl::progressive_qslim(V,F,1000,PM);
+  //   for(const int m : {100000,10000,1000})
+  //   {
+  //     igl::progressive_mesh_lod(m,PM,U,G,J,I);
+  //     ...
+  //   }
+  //
+  // For min_m <= m < #F, each level of detail is the mesh output by
+  // igl::qslim(V,F,m,...), with the same faces and vertex positions (up to
+  // the order of rows).
+  //
+  // Inputs:
+  //   V  #V by dim list of vertex positions
+  //   F  #F by 3 list of triangle indices into V
+  //   min_m  desired number of faces of the base (coarsest) mesh
+  // Outputs:
+  //   PM  progressive mesh at the base mesh. Its vertices are V followed by
+  //     the point at infinity and its first #F faces are F.
+  // Returns true if min_m was reached (otherwise the base mesh has more than
+  //   min_m faces)
+  IGL_INLINE bool progressive_qslim(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const size_t min_m,
+    ProgressiveMesh & PM);
+}
+#ifndef IGL_STATIC_LIBRARY
+#  include "progressive_qslim.cpp"
+#endif
+#endif
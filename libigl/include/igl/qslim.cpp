@@ -11,6 +11,7 @@
 #include "connect_boundary_to_infinity.h"
 #include "decimate.h"
 #include "edge_flaps.h"
+#include "IndexedPriorityQueue.h"
 #include "max_faces_stopping_condition.h"
 #include "per_vertex_point_to_plane_quadrics.h"
 #include "qslim_optimal_collapse_edge_callbacks.h"
@@ -18,6 +19,8 @@
 #include "remove_unreferenced.h"
 #include "slice.h"
 #include "slice_mask.h"
+#include <limits>
+#include <utility>
 
 IGL_INLINE bool igl::qslim(
   const Eigen::MatrixXd & V,
@@ -27,6 +30,18 @@ IGL_INLINE bool igl::qslim(
   Eigen::MatrixXi & G,
   Eigen::VectorXi & J,
   Eigen::VectorXi & I)
+{
+  return igl::qslim(Eigen::MatrixXd(V),Eigen::MatrixXi(F),max_m,U,G,J,I);
+}
+
+IGL_INLINE bool igl::qslim(
+  Eigen::MatrixXd && V,
+  Eigen::MatrixXi && F,
+  const size_t max_m,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
 {
   using namespace igl;
 
@@ -34,71 +49,39 @@ IGL_INLINE bool igl::qslim(
   const int orig_m = F.rows();
   // Tracking number of faces
   int m = F.rows();
-  typedef Eigen::MatrixXd DerivedV;
-  typedef Eigen::MatrixXi DerivedF;
-  DerivedV VO;
-  DerivedF FO;
-  igl::connect_boundary_to_infinity(V,F,VO,FO);
+  // Connect boundary to infinity in place
+  {
+    Eigen::MatrixXi FO;
+    igl::connect_boundary_to_infinity(F,(int)V.rows(),FO);
+    F.swap(FO);
+  }
+  V.conservativeResize(V.rows()+1,V.cols());
+  V.row(V.rows()-1).setConstant(std::numeric_limits<double>::infinity());
   Eigen::VectorXi EMAP;
   Eigen::MatrixXi E,EF,EI;
-  edge_flaps(FO,E,EMAP,EF,EI);
+  edge_flaps(F,E,EMAP,EF,EI);
   // Quadrics per vertex
   typedef std::tuple<Eigen::MatrixXd,Eigen::RowVectorXd,double> Quadric;
   std::vector<Quadric> quadrics;
-  per_vertex_point_to_plane_quadrics(VO,FO,EMAP,EF,EI,quadrics);
+  per_vertex_point_to_plane_quadrics(V,F,EMAP,EF,EI,quadrics);
   // State variables keeping track of edge we just collapsed
   int v1 = -1;
   int v2 = -1;
   // Callbacks for computing and updating metric
-  std::function<void(
-    const int e,
-    const Eigen::MatrixXd &,
-    const Eigen::MatrixXi &,
-    const Eigen::MatrixXi &,
-    const Eigen::VectorXi &,
-    const Eigen::MatrixXi &,
-    const Eigen::MatrixXi &,
-    double &,
-    Eigen::RowVectorXd &)> cost_and_placement;
-  std::function<bool(
-    const Eigen::MatrixXd &                                         ,/*V*/
-    const Eigen::MatrixXi &                                         ,/*F*/
-    const Eigen::MatrixXi &                                         ,/*E*/
-    const Eigen::VectorXi &                                         ,/*EMAP*/
-    const Eigen::MatrixXi &                                         ,/*EF*/
-    const Eigen::MatrixXi &                                         ,/*EI*/
-    const std::set<std::pair<double,int> > &                        ,/*Q*/
-    const std::vector<std::set<std::pair<double,int> >::iterator > &,/*Qit*/
-    const Eigen::MatrixXd &                                         ,/*C*/
-    const int                                                        /*e*/
-    )> pre_collapse;
-  std::function<void(
-    const Eigen::MatrixXd &                                         ,   /*V*/
-    const Eigen::MatrixXi &                                         ,   /*F*/
-    const Eigen::MatrixXi &                                         ,   /*E*/
-    const Eigen::VectorXi &                                         ,/*EMAP*/
-    const Eigen::MatrixXi &                                         ,  /*EF*/
-    const Eigen::MatrixXi &                                         ,  /*EI*/
-    const std::set<std::pair<double,int> > &                        ,   /*Q*/
-    const std::vector<std::set<std::pair<double,int> >::iterator > &, /*Qit*/
-    const Eigen::MatrixXd &                                         ,   /*C*/
-    const int                                                       ,   /*e*/
-    const int                                                       ,  /*e1*/
-    const int                                                       ,  /*e2*/
-    const int                                                       ,  /*f1*/
-    const int                                                       ,  /*f2*/
-    const bool                                                  /*collapsed*/
-    )> post_collapse;
-  qslim_optimal_collapse_edge_callbacks(
+  typedef IndexedPriorityQueue<> PQ;
+  decimate_callback_types<PQ>::cost_and_placement cost_and_placement;
+  decimate_callback_types<PQ>::pre_collapse pre_collapse;
+  decimate_callback_types<PQ>::post_collapse post_collapse;
+  qslim_optimal_collapse_edge_callbacks<PQ>(
     E,quadrics,v1,v2, cost_and_placement, pre_collapse,post_collapse);
-  // Call to greedy decimator
-  bool ret = decimate(
-    VO, FO,
+  // Call to greedy decimator (working on V,F,E,... themselves)
+  bool ret = decimate<PQ>(
+    std::move(V), std::move(F),
     cost_and_placement,
-    max_faces_stopping_condition(m,orig_m,max_m),
+    max_faces_stopping_condition<PQ>(m,orig_m,max_m),
     pre_collapse,
     post_collapse,
-    E, EMAP, EF, EI,
+    std::move(E), std::move(EMAP), std::move(EF), std::move(EI),
     U, G, J, I);
   // Remove phony boundary faces and clean up
   const Eigen::Array<bool,Eigen::Dynamic,1> keep = (J.array()<orig_m);
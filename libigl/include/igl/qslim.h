@@ -34,6 +34,17 @@ namespace igl
     Eigen::MatrixXi & G,
     Eigen::VectorXi & J,
     Eigen::VectorXi & I);
+  // Same as above but consumes the input mesh: (V,F) are used as the working
+  // mesh (and left in an unspecified state) instead of being copied (see
+  // decimate.h).
+  IGL_INLINE bool qslim(
+    Eigen::MatrixXd && V,
+    Eigen::MatrixXi && F,
+    const size_t max_m,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
 }
 #ifndef IGL_STATIC_LIBRARY
 #  include "qslim.cpp"
@@ -8,6 +8,7 @@
 #ifndef IGL_QSLIM_OPTIMAL_COLLAPSE_EDGE_CALLBACKS_H
 #define IGL_QSLIM_OPTIMAL_COLLAPSE_EDGE_CALLBACKS_H
 #include "igl_inline.h"
+#include "decimate_callback_types.h"
 #include <Eigen/Core>
 #include <functional>
 #include <vector>
@@ -74,6 +75,24 @@ namespace igl
       const int                                                       ,  /*f2*/
       const bool                                                  /*collapsed*/
       )> & post_collapse);
+  // Same callbacks for the versions of igl::decimate templated on the queue
+  // type.
+  //
+  // Templates:
+  //   PriorityQueue  type of queue of (cost,edge) pairs
+  template <typename PriorityQueue>
+  IGL_INLINE void qslim_optimal_collapse_edge_callbacks(
+    Eigen::MatrixXi & E,
+    std::vector<std::tuple<Eigen::MatrixXd,Eigen::RowVectorXd,double> > & 
+      quadrics,
+    int & v1,
+    int & v2,
+    typename decimate_callback_types<PriorityQueue>::cost_and_placement
+      & cost_and_placement,
+    typename decimate_callback_types<PriorityQueue>::pre_collapse
+      & pre_collapse,
+    typename decimate_callback_types<PriorityQueue>::post_collapse
+      & post_collapse);
 }
 #ifndef IGL_STATIC_LIBRARY
 #  include "qslim_optimal_collapse_edge_callbacks.cpp"
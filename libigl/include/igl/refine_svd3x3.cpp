@@ -0,0 +1,69 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "refine_svd3x3.h"
+#include "svd2x2.h"
+#include <Eigen/Geometry>
+#include <cmath>
+
+IGL_INLINE void igl::refine_svd3x3(
+  const Eigen::Matrix3d & A,
+  Eigen::Matrix3d & U,
+  Eigen::Vector3d & S,
+  Eigen::Matrix3d & V)
+{
+  const auto orthonormalize = [](Eigen::Matrix3d & X)
+  {
+    X.col(0).normalize();
+    X.col(1) -= X.col(0).dot(X.col(1))*X.col(0);
+    X.col(1).normalize();
+    X.col(2) = X.col(0).cross(X.col(1));
+  };
+  orthonormalize(U);
+  orthonormalize(V);
+  Eigen::Matrix3d B = U.transpose()*A*V;
+  const double tol = 1e-15*B.norm();
+  const int pairs[3][2] = {{0,1},{0,2},{1,2}};
+  for(int sweep = 0;sweep<5;sweep++)
+  {
+    const double off =
+      std::abs(B(0,1))+std::abs(B(1,0))+std::abs(B(0,2))+
+      std::abs(B(2,0))+std::abs(B(1,2))+std::abs(B(2,1));
+    // the first sweep also sorts the diagonal
+    if(off <= tol && sweep > 0)
+    {
+      break;
+    }
+    for(int k = 0;k<3;k++)
+    {
+      const int p = pairs[k][0], q = pairs[k][1];
+      Eigen::Matrix2d Bpq,u,v;
+      Eigen::Vector2d sv;
+      Bpq << B(p,p), B(p,q), B(q,p), B(q,q);
+      svd2x2(Bpq,u,sv,v);
+      for(int j = 0;j<3;j++)
+      {
+        const double bp = B(p,j), bq = B(q,j);
+        B(p,j) = u(0,0)*bp+u(1,0)*bq;
+        B(q,j) = u(0,1)*bp+u(1,1)*bq;
+      }
+      for(int j = 0;j<3;j++)
+      {
+        const double bp = B(j,p), bq = B(j,q);
+        B(j,p) = bp*v(0,0)+bq*v(1,0);
+        B(j,q) = bp*v(0,1)+bq*v(1,1);
+        const double up = U(j,p), uq = U(j,q);
+        U(j,p) = up*u(0,0)+uq*u(1,0);
+        U(j,q) = up*u(0,1)+uq*u(1,1);
+        const double vp = V(j,p), vq = V(j,q);
+        V(j,p) = vp*v(0,0)+vq*v(1,0);
+        V(j,q) = vp*v(0,1)+vq*v(1,1);
+      }
+    }
+  }
+  S = B.diagonal();
+}
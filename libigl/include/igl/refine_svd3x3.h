@@ -0,0 +1,39 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_REFINE_SVD3X3_H
+#define IGL_REFINE_SVD3X3_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  // Refine an approximate SVD A ~ U * diag(S) * V' with U and V rotations,
+  // e.g. as computed in single precision by svd3x3, svd3x3_sse or svd3x3_avx,
+  // to double precision: U and V are orthonormalized and U' * A * V is
+  // diagonalized with sweeps of 2x2 Jacobi rotations (see svd2x2), which
+  // converge quadratically.
+  //
+  // Inputs:
+  //   A  3x3 matrix
+  //   U  3x3 approximate left singular vectors
+  //   V  3x3 approximate right singular vectors
+  // Outputs:
+  //   U  3x3 left singular vectors, det(U) = 1
+  //   S  3x1 singular values sorted by decreasing magnitude, only S[2] may be
+  //     negative
+  //   V  3x3 right singular vectors, det(V) = 1
+  IGL_INLINE void refine_svd3x3(
+    const Eigen::Matrix3d & A,
+    Eigen::Matrix3d & U,
+    Eigen::Vector3d & S,
+    Eigen::Matrix3d & V);
+}
+#ifndef IGL_STATIC_LIBRARY
+#  include "refine_svd3x3.cpp"
+#endif
+#endif
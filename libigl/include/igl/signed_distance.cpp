@@ -54,6 +54,7 @@ IGL_INLINE void igl::signed_distance(
   Eigen::MatrixXi E;
   Eigen::VectorXi EMAP;
   WindingNumberAABB<Eigen::Vector3d> hier3;
+  FastWindingNumberData fwn3;
   switch(sign_type)
   {
     default:
@@ -75,6 +76,18 @@ IGL_INLINE void igl::signed_distance(
           break;
       }
       break;
+    case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
+      switch(dim)
+      {
+        default:
+        case 3:
+          fast_winding_number_precompute(V,F,fwn3);
+          break;
+        case 2:
+          // no precomp, no hierarchy
+          break;
+      }
+      break;
     case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
       switch(dim)
       {
@@ -146,6 +159,11 @@ IGL_INLINE void igl::signed_distance(
           signed_distance_winding_number(tree3,V,F,hier3,q3,s,sqrd,i,c3):
           signed_distance_winding_number(tree2,V,F,q2,s,sqrd,i,c2);
         break;
+      case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
+        dim==3 ? 
+          signed_distance_fast_winding_number(tree3,V,F,fwn3,q3,s,sqrd,i,c3):
+          signed_distance_winding_number(tree2,V,F,q2,s,sqrd,i,c2);
+        break;
       case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
       {
         RowVector3d n3;
@@ -327,6 +345,36 @@ IGL_INLINE void igl::signed_distance_winding_number(
 
 }
 
+IGL_INLINE double igl::signed_distance_fast_winding_number(
+  const AABB<Eigen::MatrixXd,3> & tree,
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const igl::FastWindingNumberData & fwn,
+  const Eigen::RowVector3d & q)
+{
+  double s,sqrd;
+  Eigen::RowVector3d c;
+  int i=-1;
+  signed_distance_fast_winding_number(tree,V,F,fwn,q,s,sqrd,i,c);
+  return s*sqrt(sqrd);
+}
+
+IGL_INLINE void igl::signed_distance_fast_winding_number(
+  const AABB<Eigen::MatrixXd,3> & tree,
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const igl::FastWindingNumberData & fwn,
+  const Eigen::RowVector3d & q,
+  double & s,
+  double & sqrd,
+  int & i,
+  Eigen::RowVector3d & c)
+{
+  sqrd = tree.squared_distance(V,F,q,i,c);
+  const double w = fast_winding_number(fwn,q);
+  s = 1.-2.*w;
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // This template is necessary for the others to compile with clang
 // http://stackoverflow.com/questions/27748442/is-clangs-c11-support-reliable
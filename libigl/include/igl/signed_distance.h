@@ -11,6 +11,7 @@
 #include "igl_inline.h"
 #include "AABB.h"
 #include "WindingNumberAABB.h"
+#include "fast_winding_number.h"
 #include <Eigen/Core>
 #include <vector>
 namespace igl
@@ -22,7 +23,10 @@ namespace igl
     SIGNED_DISTANCE_TYPE_WINDING_NUMBER = 1,
     SIGNED_DISTANCE_TYPE_DEFAULT        = 2,
     SIGNED_DISTANCE_TYPE_UNSIGNED       = 3,
-    NUM_SIGNED_DISTANCE_TYPE            = 4
+    // Use approximate winding number (see fast_winding_number.h); falls back
+    // to exact winding number in 2D
+    SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER = 4,
+    NUM_SIGNED_DISTANCE_TYPE            = 5
   };
   // Computes signed distance to a mesh
   //
@@ -151,6 +155,33 @@ namespace igl
     double & sqrd,
     int & i,
     Eigen::Matrix<double,1,2> & c);
+  // Inputs:
+  //   tree  AABB acceleration tree (see AABB.h)
+  //   fwn  precomputed fast winding number data of (V,F) (see
+  //     fast_winding_number.h)
+  //   q  Query point
+  // Returns signed distance to mesh
+  IGL_INLINE double signed_distance_fast_winding_number(
+    const AABB<Eigen::MatrixXd,3> & tree,
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const igl::FastWindingNumberData & fwn,
+    const Eigen::RowVector3d & q);
+  // Outputs:
+  //   s  sign
+  //   sqrd  squared distance
+  //   i  closest primitive
+  //   c  closest point
+  IGL_INLINE void signed_distance_fast_winding_number(
+    const AABB<Eigen::MatrixXd,3> & tree,
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const igl::FastWindingNumberData & fwn,
+    const Eigen::RowVector3d & q,
+    double & s,
+    double & sqrd,
+    int & i,
+    Eigen::RowVector3d & c);
 }
 
 #ifndef IGL_STATIC_LIBRARY
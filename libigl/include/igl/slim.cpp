@@ -22,8 +22,19 @@
 #include "per_face_normals.h"
 #include "slice_into.h"
 #include "volume.h"
-#include "polar_svd.h"
 #include "flip_avoiding_line_search.h"
+#include "get_seconds.h"
+#include "parallel_for.h"
+#include "sparse_assembly.h"
+#include "svd2x2.h"
+#include "svd3x3.h"
+#include "refine_svd3x3.h"
+#ifdef __SSE__
+#  include "svd3x3_sse.h"
+#endif
+#ifdef __AVX__
+#  include "svd3x3_avx.h"
+#endif
 
 #include <iostream>
 #include <map>
@@ -42,9 +53,7 @@ namespace igl
     IGL_INLINE void compute_surface_gradient_matrix(const Eigen::MatrixXd &V, const Eigen::MatrixXi &F,
                                                     const Eigen::MatrixXd &F1, const Eigen::MatrixXd &F2,
                                                     Eigen::SparseMatrix<double> &D1, Eigen::SparseMatrix<double> &D2);
-    IGL_INLINE void buildA(igl::SLIMData& s, Eigen::SparseMatrix<double> &A);
-    IGL_INLINE void buildRhs(igl::SLIMData& s, const Eigen::SparseMatrix<double> &At);
-    IGL_INLINE void add_soft_constraints(igl::SLIMData& s, Eigen::SparseMatrix<double> &L);
+    IGL_INLINE void buildRhs(igl::SLIMData& s);
     IGL_INLINE double compute_energy(igl::SLIMData& s, Eigen::MatrixXd &V_new);
     IGL_INLINE double compute_soft_const_energy(igl::SLIMData& s,
                                                 const Eigen::MatrixXd &V,
@@ -62,11 +71,13 @@ namespace igl
                                         Eigen::MatrixXd &soft_bc_p);
     IGL_INLINE void update_weights_and_closest_rotations( igl::SLIMData& s,
                                                           const Eigen::MatrixXd &V,
-                                                          const Eigen::MatrixXi &F,
-                                                          Eigen::MatrixXd &uv);
+                                                          const Eigen::MatrixXi &F);
     IGL_INLINE void compute_jacobians(igl::SLIMData& s, const Eigen::MatrixXd &uv);
     IGL_INLINE void build_linear_system(igl::SLIMData& s, Eigen::SparseMatrix<double> &L);
+    IGL_INLINE void build_assembly_plan(igl::SLIMData& s);
     IGL_INLINE void pre_calc(igl::SLIMData& s);
+    IGL_INLINE void jacobian_determinants(const igl::SLIMData& s, Eigen::VectorXd &det);
+    IGL_INLINE void anderson_step(igl::SLIMData& s, double energy_prev);
 
     // Implementation
     IGL_INLINE void compute_surface_gradient_matrix(const Eigen::MatrixXd &V, const Eigen::MatrixXi &F,
@@ -84,60 +95,139 @@ namespace igl
       D2 = F2.col(0).asDiagonal() * Dx + F2.col(1).asDiagonal() * Dy + F2.col(2).asDiagonal() * Dz;
     }
 
-    IGL_INLINE void compute_jacobians(igl::SLIMData& s, const Eigen::MatrixXd &uv)
+    // Call func(i, ri, ui, sing, vi) following the conventions of
+    // igl::polar_svd: nonnegative singular values and ri the closest
+    // rotation, given the SVD of a jacobian with rotations ui and vi
+    template <typename Mat, typename Vec, typename Func>
+    IGL_INLINE void polar_svd_conventions(const int i, Mat &ui, Vec &sing, const Mat &vi, const Func &func)
     {
-      if (s.F.cols() == 3)
+      const int dim = Vec::RowsAtCompileTime;
+      if (sing(dim - 1) < 0)
       {
-        // Ji=[D1*u,D2*u,D1*v,D2*v];
-        s.Ji.col(0) = s.Dx * uv.col(0);
-        s.Ji.col(1) = s.Dy * uv.col(0);
-        s.Ji.col(2) = s.Dx * uv.col(1);
-        s.Ji.col(3) = s.Dy * uv.col(1);
+        sing(dim - 1) *= -1.;
+        ui.col(dim - 1) *= -1.;
       }
-      else /*tet mesh*/{
-        // Ji=[D1*u,D2*u,D3*u, D1*v,D2*v, D3*v, D1*w,D2*w,D3*w];
-        s.Ji.col(0) = s.Dx * uv.col(0);
-        s.Ji.col(1) = s.Dy * uv.col(0);
-        s.Ji.col(2) = s.Dz * uv.col(0);
-        s.Ji.col(3) = s.Dx * uv.col(1);
-        s.Ji.col(4) = s.Dy * uv.col(1);
-        s.Ji.col(5) = s.Dz * uv.col(1);
-        s.Ji.col(6) = s.Dx * uv.col(2);
-        s.Ji.col(7) = s.Dy * uv.col(2);
-        s.Ji.col(8) = s.Dz * uv.col(2);
+      Mat ri = ui * vi.transpose();
+      if (ri.determinant() < 0)
+      {
+        Mat wi = vi;
+        wi.col(dim - 1) *= -1.;
+        ri = ui * wi.transpose();
       }
+      func(i, ri, ui, sing, vi);
+    }
+
+    // Calls func(i, ri, ui, sing, vi) for each row i of Ji (2 by 2
+    // jacobians stored row-major) in parallel, where ri, ui, sing and vi are
+    // as output by igl::polar_svd, using closed form SVDs
+    template <typename Func>
+    IGL_INLINE void for_each_jacobian_svd2(const Eigen::MatrixXd &Ji, const Func &func)
+    {
+      igl::parallel_for(Ji.rows(), [&Ji, &func](const int i)
+      {
+        Eigen::Matrix2d ui, vi;
+        Eigen::Vector2d sing;
+        Eigen::Matrix2d ji;
+        ji << Ji(i, 0), Ji(i, 1), Ji(i, 2), Ji(i, 3);
+        igl::svd2x2(ji, ui, sing, vi);
+        polar_svd_conventions(i, ui, sing, vi, func);
+      }, 1000);
+    }
+
+    // Same for 3 by 3 jacobians: SVDs are computed by batches with the SIMD
+    // kernels of svd3x3_avx / svd3x3_sse (in single precision) and refined
+    // in double precision
+    template <typename Func>
+    IGL_INLINE void for_each_jacobian_svd3(const Eigen::MatrixXd &Ji, const Func &func)
+    {
+#ifdef __AVX__
+      const int batch = 8;
+#elif defined(__SSE__)
+      const int batch = 4;
+#else
+      const int batch = 1;
+#endif
+      const int num_batches = (Ji.rows() + batch - 1) / batch;
+      igl::parallel_for(num_batches, [&Ji, &func](const int k)
+      {
+        // scaled to unit norm for single precision
+        Eigen::Matrix<float, 3 * batch, 3> A, U, V;
+        Eigen::Matrix<float, 3 * batch, 1> S;
+        Eigen::Matrix3d ji[batch];
+        for (int b = 0; b < batch; b++)
+        {
+          const int i = k * batch + b;
+          if (i < Ji.rows())
+          {
+            for (int r = 0; r < 3; r++)
+              for (int c = 0; c < 3; c++)
+                ji[b](r, c) = Ji(i, r * 3 + c);
+          }
+          else
+            ji[b].setIdentity();
+          const double scale = ji[b].norm();
+          A.block(3 * b, 0, 3, 3) = (ji[b] / (scale > 0 ? scale : 1.)).cast<float>();
+        }
+#ifdef __AVX__
+        igl::svd3x3_avx(A, U, S, V);
+#elif defined(__SSE__)
+        igl::svd3x3_sse(A, U, S, V);
+#else
+        igl::svd3x3(A, U, S, V);
+#endif
+        for (int b = 0; b < batch && k * batch + b < Ji.rows(); b++)
+        {
+          Eigen::Matrix3d ui = U.block(3 * b, 0, 3, 3).cast<double>();
+          Eigen::Matrix3d vi = V.block(3 * b, 0, 3, 3).cast<double>();
+          Eigen::Vector3d sing;
+          igl::refine_svd3x3(ji[b], ui, sing, vi);
+          polar_svd_conventions(k * batch + b, ui, sing, vi, func);
+        }
+      }, 1000 / batch);
+    }
+
+    IGL_INLINE void compute_jacobians(igl::SLIMData& s, const Eigen::MatrixXd &uv)
+    {
+      // Ji=[D1*u,D2*u,D1*v,D2*v] (triangles) or
+      // Ji=[D1*u,D2*u,D3*u, D1*v,D2*v, D3*v, D1*w,D2*w,D3*w] (tets)
+      // computed one element at a time from the gradients in s.Dl
+      const int dim = s.dim;
+      const int nv = dim + 1;
+      igl::parallel_for(s.f_n, [&s, &uv, dim, nv](const int f)
+      {
+        for (int c = 0; c < dim; c++)
+        {
+          for (int d = 0; d < dim; d++)
+          {
+            double j = 0;
+            for (int p = 0; p < nv; p++)
+              j += s.Dl(f, d * nv + p) * uv(s.F(f, p), c);
+            s.Ji(f, c * dim + d) = j;
+          }
+        }
+      }, 1000);
     }
 
     IGL_INLINE void update_weights_and_closest_rotations(igl::SLIMData& s,
                                               const Eigen::MatrixXd &V,
-                                              const Eigen::MatrixXi &F,
-                                              Eigen::MatrixXd &uv)
+                                              const Eigen::MatrixXi &F)
     {
-      compute_jacobians(s, uv);
-
+      // jacobians of the current iterate are expected in s.Ji (see
+      // compute_jacobians)
       const double eps = 1e-8;
       double exp_f = s.exp_factor;
 
       if (s.dim == 2)
       {
-        for (int i = 0; i < s.Ji.rows(); ++i)
+        typedef Eigen::Matrix<double, 2, 2> Mat2;
+        typedef Eigen::Matrix<double, 2, 1> Vec2;
+        for_each_jacobian_svd2(s.Ji, [&](const int i, Mat2 &ri, const Mat2 &ui, const Vec2 &sing, const Mat2 &vi)
         {
-          typedef Eigen::Matrix<double, 2, 2> Mat2;
-          typedef Eigen::Matrix<double, 2, 1> Vec2;
-          Mat2 ji, ri, ti, ui, vi;
-          Vec2 sing;
           Vec2 closest_sing_vec;
           Mat2 mat_W;
           Vec2 m_sing_new;
           double s1, s2;
 
-          ji(0, 0) = s.Ji(i, 0);
-          ji(0, 1) = s.Ji(i, 1);
-          ji(1, 0) = s.Ji(i, 2);
-          ji(1, 1) = s.Ji(i, 3);
-
-          igl::polar_svd(ji, ri, ti, ui, sing, vi);
-
           s1 = sing(0);
           s2 = sing(1);
 
@@ -227,31 +317,17 @@ namespace igl
           s.Ri(i, 1) = ri(1, 0);
           s.Ri(i, 2) = ri(0, 1);
           s.Ri(i, 3) = ri(1, 1);
-        }
+        });
       }
       else
       {
         typedef Eigen::Matrix<double, 3, 1> Vec3;
         typedef Eigen::Matrix<double, 3, 3> Mat3;
-        Mat3 ji;
-        Vec3 m_sing_new;
-        Vec3 closest_sing_vec;
         const double sqrt_2 = sqrt(2);
-        for (int i = 0; i < s.Ji.rows(); ++i)
+        for_each_jacobian_svd3(s.Ji, [&](const int i, Mat3 &ri, const Mat3 &ui, const Vec3 &sing, const Mat3 &vi)
         {
-          ji(0, 0) = s.Ji(i, 0);
-          ji(0, 1) = s.Ji(i, 1);
-          ji(0, 2) = s.Ji(i, 2);
-          ji(1, 0) = s.Ji(i, 3);
-          ji(1, 1) = s.Ji(i, 4);
-          ji(1, 2) = s.Ji(i, 5);
-          ji(2, 0) = s.Ji(i, 6);
-          ji(2, 1) = s.Ji(i, 7);
-          ji(2, 2) = s.Ji(i, 8);
-
-          Mat3 ri, ti, ui, vi;
-          Vec3 sing;
-          igl::polar_svd(ji, ri, ti, ui, sing, vi);
+          Vec3 m_sing_new;
+          Vec3 closest_sing_vec;
 
           double s1 = sing(0);
           double s2 = sing(1);
@@ -377,7 +453,7 @@ namespace igl
           s.Ri(i, 6) = ri(0, 2);
           s.Ri(i, 7) = ri(1, 2);
           s.Ri(i, 8) = ri(2, 2);
-        } // for loop end
+        }); // for loop end
 
       } // if dim end
 
@@ -392,24 +468,33 @@ namespace igl
     {
       using namespace Eigen;
 
-      Eigen::SparseMatrix<double> L;
-      build_linear_system(s,L);
-
-      // solve
+      // solve the system assembled by build_linear_system, the sparsity
+      // pattern of s.L never changes so only the first solve analyzes it
       Eigen::VectorXd Uc;
       if (s.dim == 2)
       {
-        SimplicialLDLT<Eigen::SparseMatrix<double> > solver;
-        Uc = solver.compute(L).solve(s.rhs);
+        if (s.first_solve)
+        {
+          s.ldlt = std::make_shared<Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > >();
+          s.ldlt->analyzePattern(s.L);
+        }
+        s.ldlt->factorize(s.L);
+        Uc = s.ldlt->solve(s.rhs);
       }
       else
       { // seems like CG performs much worse for 2D and way better for 3D
         Eigen::VectorXd guess(uv.rows() * s.dim);
         for (int i = 0; i < s.v_num; i++) for (int j = 0; j < s.dim; j++) guess(uv.rows() * j + i) = uv(i, j); // flatten vector
-        ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Upper> solver;
-        solver.setTolerance(1e-8);
-        Uc = solver.compute(L).solveWithGuess(s.rhs, guess);
+        if (s.first_solve)
+        {
+          s.cg = std::make_shared<Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> >();
+          s.cg->setTolerance(1e-8);
+          s.cg->analyzePattern(s.L);
+        }
+        s.cg->factorize(s.L);
+        Uc = s.cg->solveWithGuess(s.rhs, guess);
       }
+      s.first_solve = false;
 
       for (int i = 0; i < s.dim; i++)
         uv.col(i) = Uc.block(i * s.v_n, 0, s.v_n, 1);
@@ -463,6 +548,7 @@ namespace igl
         s.Ri.resize(s.f_n, s.dim * s.dim);
         s.Ji.resize(s.f_n, s.dim * s.dim);
         s.rhs.resize(s.dim * s.v_num);
+        s.WW.resize(s.f_n, s.dim * s.dim);
 
         // flattened weight matrix
         s.WGL_M.resize(s.dim * s.dim * s.f_n);
@@ -470,45 +556,114 @@ namespace igl
           for (int j = 0; j < s.f_n; j++)
             s.WGL_M(i * s.f_n + j) = s.M(j);
 
+        build_assembly_plan(s);
         s.first_solve = true;
         s.has_pre_calc = true;
       }
     }
 
-    IGL_INLINE void build_linear_system(igl::SLIMData& s, Eigen::SparseMatrix<double> &L)
+    IGL_INLINE void build_assembly_plan(igl::SLIMData& s)
     {
-      // formula (35) in paper
-      Eigen::SparseMatrix<double> A(s.dim * s.dim * s.f_n, s.dim * s.v_n);
-      buildA(s,A);
-
-      Eigen::SparseMatrix<double> At = A.transpose();
-      At.makeCompressed();
-
-      Eigen::SparseMatrix<double> id_m(At.rows(), At.rows());
-      id_m.setIdentity();
-
-      // add proximal penalty
-      L = At * s.WGL_M.asDiagonal() * A + s.proximal_p * id_m; //add also a proximal term
-      L.makeCompressed();
-
-      buildRhs(s, At);
-      Eigen::SparseMatrix<double> OldL = L;
-      add_soft_constraints(s,L);
-      L.makeCompressed();
+      // L = At * WGL_M.asDiagonal() * A + proximal_p * I (formula (35) in
+      // paper) plus the soft constraints on the diagonal. The rows of A of
+      // an element are (W * [Dx;Dy;Dz] restricted to the element) so block
+      // (a,b) of L sums M(f) * (W'*W)(a,b) * (Dx'*Dx + Dy'*Dy + Dz'*Dz) over
+      // the elements f: store the gradients of the element vertices, their
+      // (dim+1)^2 products and the pattern of L
+      const int dim = s.dim;
+      const int nv = dim + 1;
+      const int nl = nv * nv;
+      s.Dl.setZero(s.f_n, dim * nv);
+      const Eigen::SparseMatrix<double> *D[3] = {&s.Dx, &s.Dy, &s.Dz};
+      for (int d = 0; d < dim; d++)
+      {
+        for (int k = 0; k < D[d]->outerSize(); ++k)
+        {
+          for (Eigen::SparseMatrix<double>::InnerIterator it(*D[d], k); it; ++it)
+          {
+            int p = 0;
+            while (p < nv && s.F(it.row(), p) != it.col()) p++;
+            assert(p < nv && "Gradient entry outside of element");
+            s.Dl(it.row(), d * nv + p) += it.value();
+          }
+        }
+      }
+      s.DD.setZero(s.f_n, nl);
+      for (int d = 0; d < dim; d++)
+        for (int p = 0; p < nv; p++)
+          for (int q = 0; q < nv; q++)
+            s.DD.col(p * nv + q) += s.Dl.col(d * nv + p).cwiseProduct(s.Dl.col(d * nv + q));
+
+      // triplets: element ones ordered by block, vertex pair and element,
+      // then the proximal and soft constraint diagonal ones
+      const int nf = s.f_n * dim * dim * nl;
+      const int nb = s.b.rows();
+      const auto ij = [&s, dim, nv, nl, nf, nb](const int t, int &i, int &j)
+      {
+        if (t < nf)
+        {
+          const int f = t % s.f_n;
+          const int pq = (t / s.f_n) % nl;
+          const int ab = t / (s.f_n * nl);
+          i = (ab / dim) * s.v_n + s.F(f, pq / nv);
+          j = (ab % dim) * s.v_n + s.F(f, pq % nv);
+        }
+        else if (t - nf < dim * s.v_n)
+          i = j = t - nf;
+        else
+        {
+          const int u = t - nf - dim * s.v_n;
+          i = j = (u / nb) * s.v_n + s.b(u % nb);
+        }
+      };
+      igl::sparse_assembly_pattern(dim * s.v_n, dim * s.v_n,
+                                   nf + dim * (s.v_n + nb), ij,
+                                   s.L, s.L_slots, s.L_order);
+      s.L_b = s.b;
     }
 
-    IGL_INLINE void add_soft_constraints(igl::SLIMData& s, Eigen::SparseMatrix<double> &L)
+    IGL_INLINE void build_linear_system(igl::SLIMData& s, Eigen::SparseMatrix<double> &L)
     {
-      int v_n = s.v_num;
-      for (int d = 0; d < s.dim; d++)
+      // the soft constraints are part of the pattern of L: rebuild the plan
+      // (and the symbolic analysis of L) if they changed since it was built
+      if (s.b.size() != s.L_b.size() || s.b != s.L_b)
       {
-        for (int i = 0; i < s.b.rows(); i++)
+        build_assembly_plan(s);
+        s.first_solve = true;
+      }
+
+      // element coefficients of the blocks of L: M(f) * (W'*W)(a,b)
+      const int dim = s.dim;
+      const Eigen::VectorXd *W[3][3] = {{&s.W_11, &s.W_12, &s.W_13},
+                                        {&s.W_21, &s.W_22, &s.W_23},
+                                        {&s.W_31, &s.W_32, &s.W_33}};
+      for (int a = 0; a < dim; a++)
+      {
+        for (int b = 0; b < dim; b++)
         {
-          int v_idx = s.b(i);
-          s.rhs(d * v_n + v_idx) += s.soft_const_p * s.bc(i, d); // rhs
-          L.coeffRef(d * v_n + v_idx, d * v_n + v_idx) += s.soft_const_p; // diagonal of matrix
+          Eigen::VectorXd w = Eigen::VectorXd::Zero(s.f_n);
+          for (int k = 0; k < dim; k++)
+            w += W[k][a]->cwiseProduct(*W[k][b]);
+          s.WW.col(a * dim + b) = s.M.cwiseProduct(w);
         }
       }
+
+      // write the values into the pattern of the assembly plan
+      const int nl = (dim + 1) * (dim + 1);
+      const int nf = s.f_n * dim * dim * nl;
+      if (&L != &s.L)
+        L = s.L;
+      igl::sparse_assembly_values(s.L_slots, s.L_order, [&s, dim, nl, nf](const int t)
+      {
+        if (t < nf)
+        {
+          const int f = t % s.f_n;
+          return s.WW(f, t / (s.f_n * nl)) * s.DD(f, (t / s.f_n) % nl);
+        }
+        return t - nf < dim * s.v_n ? s.proximal_p : s.soft_const_p;
+      }, L);
+
+      buildRhs(s);
     }
 
     IGL_INLINE double compute_energy(igl::SLIMData& s, Eigen::MatrixXd &V_new)
@@ -537,22 +692,16 @@ namespace igl
                                                     Eigen::MatrixXd &uv, Eigen::VectorXd &areas)
     {
 
-      double energy = 0;
+      // energy of each element, summed serially for reproducible results
+      Eigen::VectorXd energies(s.f_n);
       if (s.dim == 2)
       {
-        Eigen::Matrix<double, 2, 2> ji;
-        for (int i = 0; i < s.f_n; i++)
+        typedef Eigen::Matrix<double, 2, 2> Mat2;
+        typedef Eigen::Matrix<double, 2, 1> Vec2;
+        for_each_jacobian_svd2(Ji, [&](const int i, Mat2 &, const Mat2 &, const Vec2 &sing, const Mat2 &)
         {
-          ji(0, 0) = Ji(i, 0);
-          ji(0, 1) = Ji(i, 1);
-          ji(1, 0) = Ji(i, 2);
-          ji(1, 1) = Ji(i, 3);
-
-          typedef Eigen::Matrix<double, 2, 2> Mat2;
-          typedef Eigen::Matrix<double, 2, 1> Vec2;
-          Mat2 ri, ti, ui, vi;
-          Vec2 sing;
-          igl::polar_svd(ji, ri, ti, ui, sing, vi);
+          double &energy = energies(i);
+          energy = 0;
           double s1 = sing(0);
           double s2 = sing(1);
 
@@ -591,28 +740,16 @@ namespace igl
 
           }
 
-        }
+        });
       }
       else
       {
-        Eigen::Matrix<double, 3, 3> ji;
-        for (int i = 0; i < s.f_n; i++)
+        typedef Eigen::Matrix<double, 3, 3> Mat3;
+        typedef Eigen::Matrix<double, 3, 1> Vec3;
+        for_each_jacobian_svd3(Ji, [&](const int i, Mat3 &, const Mat3 &, const Vec3 &sing, const Mat3 &)
         {
-          ji(0, 0) = Ji(i, 0);
-          ji(0, 1) = Ji(i, 1);
-          ji(0, 2) = Ji(i, 2);
-          ji(1, 0) = Ji(i, 3);
-          ji(1, 1) = Ji(i, 4);
-          ji(1, 2) = Ji(i, 5);
-          ji(2, 0) = Ji(i, 6);
-          ji(2, 1) = Ji(i, 7);
-          ji(2, 2) = Ji(i, 8);
-
-          typedef Eigen::Matrix<double, 3, 3> Mat3;
-          typedef Eigen::Matrix<double, 3, 1> Vec3;
-          Mat3 ri, ti, ui, vi;
-          Vec3 sing;
-          igl::polar_svd(ji, ri, ti, ui, sing, vi);
+          double &energy = energies(i);
+          energy = 0;
           double s1 = sing(0);
           double s2 = sing(1);
           double s3 = sing(2);
@@ -651,186 +788,88 @@ namespace igl
               break;
             }
           }
-        }
+        });
       }
 
-      return energy;
+      return energies.sum();
     }
 
-    IGL_INLINE void buildA(igl::SLIMData& s, Eigen::SparseMatrix<double> &A)
+    IGL_INLINE void buildRhs(igl::SLIMData& s)
     {
-      // formula (35) in paper
-      std::vector<Eigen::Triplet<double> > IJV;
-      if (s.dim == 2)
+      // rhs = At * WGL_M.asDiagonal() * b + proximal_p * uv (formula (36) in
+      // paper for b) where the rows of b of an element are W * R, so block a
+      // of rhs is the sum over d of D_d' * (M(f) * (W'*W*R)(a,d))
+      const int dim = s.dim;
+      const Eigen::SparseMatrix<double> *D[3] = {&s.Dx, &s.Dy, &s.Dz};
+      Eigen::VectorXd f_rhs(s.f_n);
+      for (int a = 0; a < dim; a++)
       {
-        IJV.reserve(4 * (s.Dx.outerSize() + s.Dy.outerSize()));
-
-        /*A = [W11*Dx, W12*Dx;
-             W11*Dy, W12*Dy;
-             W21*Dx, W22*Dx;
-             W21*Dy, W22*Dy];*/
-        for (int k = 0; k < s.Dx.outerSize(); ++k)
+        Eigen::VectorXd rhs_a = s.proximal_p * s.V_o.col(a);
+        for (int d = 0; d < dim; d++)
         {
-          for (Eigen::SparseMatrix<double>::InnerIterator it(s.Dx, k); it; ++it)
-          {
-            int dx_r = it.row();
-            int dx_c = it.col();
-            double val = it.value();
-
-            IJV.push_back(Eigen::Triplet<double>(dx_r, dx_c, val * s.W_11(dx_r)));
-            IJV.push_back(Eigen::Triplet<double>(dx_r, s.v_n + dx_c, val * s.W_12(dx_r)));
-
-            IJV.push_back(Eigen::Triplet<double>(2 * s.f_n + dx_r, dx_c, val * s.W_21(dx_r)));
-            IJV.push_back(Eigen::Triplet<double>(2 * s.f_n + dx_r, s.v_n + dx_c, val * s.W_22(dx_r)));
-          }
+          // Ri stores R column-major
+          f_rhs.setZero();
+          for (int b = 0; b < dim; b++)
+            f_rhs += s.WW.col(a * dim + b).cwiseProduct(s.Ri.col(d * dim + b));
+          rhs_a += D[d]->transpose() * f_rhs;
         }
+        for (int i = 0; i < s.b.rows(); i++)
+          rhs_a(s.b(i)) += s.soft_const_p * s.bc(i, a);
+        s.rhs.segment(a * s.v_n, s.v_n) = rhs_a;
+      }
+    }
 
-        for (int k = 0; k < s.Dy.outerSize(); ++k)
-        {
-          for (Eigen::SparseMatrix<double>::InnerIterator it(s.Dy, k); it; ++it)
-          {
-            int dy_r = it.row();
-            int dy_c = it.col();
-            double val = it.value();
-
-            IJV.push_back(Eigen::Triplet<double>(s.f_n + dy_r, dy_c, val * s.W_11(dy_r)));
-            IJV.push_back(Eigen::Triplet<double>(s.f_n + dy_r, s.v_n + dy_c, val * s.W_12(dy_r)));
-
-            IJV.push_back(Eigen::Triplet<double>(3 * s.f_n + dy_r, dy_c, val * s.W_21(dy_r)));
-            IJV.push_back(Eigen::Triplet<double>(3 * s.f_n + dy_r, s.v_n + dy_c, val * s.W_22(dy_r)));
-          }
-        }
+    IGL_INLINE void jacobian_determinants(const igl::SLIMData& s, Eigen::VectorXd &det)
+    {
+      // Ji stores J row-major
+      det.resize(s.f_n);
+      if (s.dim == 2)
+      {
+        det = s.Ji.col(0).cwiseProduct(s.Ji.col(3)) - s.Ji.col(1).cwiseProduct(s.Ji.col(2));
       }
       else
       {
-
-        /*A = [W11*Dx, W12*Dx, W13*Dx;
-               W11*Dy, W12*Dy, W13*Dy;
-               W11*Dz, W12*Dz, W13*Dz;
-               W21*Dx, W22*Dx, W23*Dx;
-               W21*Dy, W22*Dy, W23*Dy;
-               W21*Dz, W22*Dz, W23*Dz;
-               W31*Dx, W32*Dx, W33*Dx;
-               W31*Dy, W32*Dy, W33*Dy;
-               W31*Dz, W32*Dz, W33*Dz;];*/
-        IJV.reserve(9 * (s.Dx.outerSize() + s.Dy.outerSize() + s.Dz.outerSize()));
-        for (int k = 0; k < s.Dx.outerSize(); k++)
-        {
-          for (Eigen::SparseMatrix<double>::InnerIterator it(s.Dx, k); it; ++it)
-          {
-            int dx_r = it.row();
-            int dx_c = it.col();
-            double val = it.value();
-
-            IJV.push_back(Eigen::Triplet<double>(dx_r, dx_c, val * s.W_11(dx_r)));
-            IJV.push_back(Eigen::Triplet<double>(dx_r, s.v_n + dx_c, val * s.W_12(dx_r)));
-            IJV.push_back(Eigen::Triplet<double>(dx_r, 2 * s.v_n + dx_c, val * s.W_13(dx_r)));
-
-            IJV.push_back(Eigen::Triplet<double>(3 * s.f_n + dx_r, dx_c, val * s.W_21(dx_r)));
-            IJV.push_back(Eigen::Triplet<double>(3 * s.f_n + dx_r, s.v_n + dx_c, val * s.W_22(dx_r)));
-            IJV.push_back(Eigen::Triplet<double>(3 * s.f_n + dx_r, 2 * s.v_n + dx_c, val * s.W_23(dx_r)));
-
-            IJV.push_back(Eigen::Triplet<double>(6 * s.f_n + dx_r, dx_c, val * s.W_31(dx_r)));
-            IJV.push_back(Eigen::Triplet<double>(6 * s.f_n + dx_r, s.v_n + dx_c, val * s.W_32(dx_r)));
-            IJV.push_back(Eigen::Triplet<double>(6 * s.f_n + dx_r, 2 * s.v_n + dx_c, val * s.W_33(dx_r)));
-          }
-        }
-
-        for (int k = 0; k < s.Dy.outerSize(); k++)
-        {
-          for (Eigen::SparseMatrix<double>::InnerIterator it(s.Dy, k); it; ++it)
-          {
-            int dy_r = it.row();
-            int dy_c = it.col();
-            double val = it.value();
-
-            IJV.push_back(Eigen::Triplet<double>(s.f_n + dy_r, dy_c, val * s.W_11(dy_r)));
-            IJV.push_back(Eigen::Triplet<double>(s.f_n + dy_r, s.v_n + dy_c, val * s.W_12(dy_r)));
-            IJV.push_back(Eigen::Triplet<double>(s.f_n + dy_r, 2 * s.v_n + dy_c, val * s.W_13(dy_r)));
-
-            IJV.push_back(Eigen::Triplet<double>(4 * s.f_n + dy_r, dy_c, val * s.W_21(dy_r)));
-            IJV.push_back(Eigen::Triplet<double>(4 * s.f_n + dy_r, s.v_n + dy_c, val * s.W_22(dy_r)));
-            IJV.push_back(Eigen::Triplet<double>(4 * s.f_n + dy_r, 2 * s.v_n + dy_c, val * s.W_23(dy_r)));
-
-            IJV.push_back(Eigen::Triplet<double>(7 * s.f_n + dy_r, dy_c, val * s.W_31(dy_r)));
-            IJV.push_back(Eigen::Triplet<double>(7 * s.f_n + dy_r, s.v_n + dy_c, val * s.W_32(dy_r)));
-            IJV.push_back(Eigen::Triplet<double>(7 * s.f_n + dy_r, 2 * s.v_n + dy_c, val * s.W_33(dy_r)));
-          }
-        }
-
-        for (int k = 0; k < s.Dz.outerSize(); k++)
+        for (int i = 0; i < s.f_n; i++)
         {
-          for (Eigen::SparseMatrix<double>::InnerIterator it(s.Dz, k); it; ++it)
-          {
-            int dz_r = it.row();
-            int dz_c = it.col();
-            double val = it.value();
-
-            IJV.push_back(Eigen::Triplet<double>(2 * s.f_n + dz_r, dz_c, val * s.W_11(dz_r)));
-            IJV.push_back(Eigen::Triplet<double>(2 * s.f_n + dz_r, s.v_n + dz_c, val * s.W_12(dz_r)));
-            IJV.push_back(Eigen::Triplet<double>(2 * s.f_n + dz_r, 2 * s.v_n + dz_c, val * s.W_13(dz_r)));
-
-            IJV.push_back(Eigen::Triplet<double>(5 * s.f_n + dz_r, dz_c, val * s.W_21(dz_r)));
-            IJV.push_back(Eigen::Triplet<double>(5 * s.f_n + dz_r, s.v_n + dz_c, val * s.W_22(dz_r)));
-            IJV.push_back(Eigen::Triplet<double>(5 * s.f_n + dz_r, 2 * s.v_n + dz_c, val * s.W_23(dz_r)));
-
-            IJV.push_back(Eigen::Triplet<double>(8 * s.f_n + dz_r, dz_c, val * s.W_31(dz_r)));
-            IJV.push_back(Eigen::Triplet<double>(8 * s.f_n + dz_r, s.v_n + dz_c, val * s.W_32(dz_r)));
-            IJV.push_back(Eigen::Triplet<double>(8 * s.f_n + dz_r, 2 * s.v_n + dz_c, val * s.W_33(dz_r)));
-          }
+          Eigen::Matrix3d ji;
+          ji << s.Ji(i, 0), s.Ji(i, 1), s.Ji(i, 2),
+                s.Ji(i, 3), s.Ji(i, 4), s.Ji(i, 5),
+                s.Ji(i, 6), s.Ji(i, 7), s.Ji(i, 8);
+          det(i) = ji.determinant();
         }
       }
-      A.setFromTriplets(IJV.begin(), IJV.end());
     }
 
-    IGL_INLINE void buildRhs(igl::SLIMData& s, const Eigen::SparseMatrix<double> &At)
+    IGL_INLINE void anderson_step(igl::SLIMData& s, double energy_prev)
     {
-      Eigen::VectorXd f_rhs(s.dim * s.dim * s.f_n);
-      f_rhs.setZero();
-      if (s.dim == 2)
+      // s.V_o is the result of the last iteration started from an iterate of
+      // energy energy_prev. The accelerated iterate is only accepted if no
+      // element changes orientation and its energy is below energy_prev
+      Eigen::MatrixXd V_g = s.V_o;
+      Eigen::Map<const Eigen::VectorXd> g(V_g.data(), V_g.size());
+      const Eigen::VectorXd &x = s.aa.compute(g);
+      if (x == g)
+        return;
+      Eigen::MatrixXd V_acc = Eigen::Map<const Eigen::MatrixXd>(x.data(), V_g.rows(), V_g.cols());
+
+      Eigen::VectorXd det_g, det_acc;
+      compute_jacobians(s, V_g);
+      jacobian_determinants(s, det_g);
+      const double energy_acc = compute_energy(s, V_acc) / s.mesh_area;
+      jacobian_determinants(s, det_acc);
+
+      bool accept = energy_acc < energy_prev;
+      for (int i = 0; accept && i < s.f_n; i++)
+        accept = det_g(i) * det_acc(i) > 0;
+      if (accept)
       {
-        /*b = [W11*R11 + W12*R21; (formula (36))
-             W11*R12 + W12*R22;
-             W21*R11 + W22*R21;
-             W21*R12 + W22*R22];*/
-        for (int i = 0; i < s.f_n; i++)
-        {
-          f_rhs(i + 0 * s.f_n) = s.W_11(i) * s.Ri(i, 0) + s.W_12(i) * s.Ri(i, 1);
-          f_rhs(i + 1 * s.f_n) = s.W_11(i) * s.Ri(i, 2) + s.W_12(i) * s.Ri(i, 3);
-          f_rhs(i + 2 * s.f_n) = s.W_21(i) * s.Ri(i, 0) + s.W_22(i) * s.Ri(i, 1);
-          f_rhs(i + 3 * s.f_n) = s.W_21(i) * s.Ri(i, 2) + s.W_22(i) * s.Ri(i, 3);
-        }
+        s.V_o = V_acc;
+        s.energy = energy_acc;
       }
       else
       {
-        /*b = [W11*R11 + W12*R21 + W13*R31;
-             W11*R12 + W12*R22 + W13*R32;
-             W11*R13 + W12*R23 + W13*R33;
-             W21*R11 + W22*R21 + W23*R31;
-             W21*R12 + W22*R22 + W23*R32;
-             W21*R13 + W22*R23 + W23*R33;
-             W31*R11 + W32*R21 + W33*R31;
-             W31*R12 + W32*R22 + W33*R32;
-             W31*R13 + W32*R23 + W33*R33;];*/
-        for (int i = 0; i < s.f_n; i++)
-        {
-          f_rhs(i + 0 * s.f_n) = s.W_11(i) * s.Ri(i, 0) + s.W_12(i) * s.Ri(i, 1) + s.W_13(i) * s.Ri(i, 2);
-          f_rhs(i + 1 * s.f_n) = s.W_11(i) * s.Ri(i, 3) + s.W_12(i) * s.Ri(i, 4) + s.W_13(i) * s.Ri(i, 5);
-          f_rhs(i + 2 * s.f_n) = s.W_11(i) * s.Ri(i, 6) + s.W_12(i) * s.Ri(i, 7) + s.W_13(i) * s.Ri(i, 8);
-          f_rhs(i + 3 * s.f_n) = s.W_21(i) * s.Ri(i, 0) + s.W_22(i) * s.Ri(i, 1) + s.W_23(i) * s.Ri(i, 2);
-          f_rhs(i + 4 * s.f_n) = s.W_21(i) * s.Ri(i, 3) + s.W_22(i) * s.Ri(i, 4) + s.W_23(i) * s.Ri(i, 5);
-          f_rhs(i + 5 * s.f_n) = s.W_21(i) * s.Ri(i, 6) + s.W_22(i) * s.Ri(i, 7) + s.W_23(i) * s.Ri(i, 8);
-          f_rhs(i + 6 * s.f_n) = s.W_31(i) * s.Ri(i, 0) + s.W_32(i) * s.Ri(i, 1) + s.W_33(i) * s.Ri(i, 2);
-          f_rhs(i + 7 * s.f_n) = s.W_31(i) * s.Ri(i, 3) + s.W_32(i) * s.Ri(i, 4) + s.W_33(i) * s.Ri(i, 5);
-          f_rhs(i + 8 * s.f_n) = s.W_31(i) * s.Ri(i, 6) + s.W_32(i) * s.Ri(i, 7) + s.W_33(i) * s.Ri(i, 8);
-        }
+        s.aa.replace(g);
       }
-      Eigen::VectorXd uv_flat(s.dim *s.v_n);
-      for (int i = 0; i < s.dim; i++)
-        for (int j = 0; j < s.v_n; j++)
-          uv_flat(s.v_n * i + j) = s.V_o(j, i);
-
-      s.rhs = (At * s.WGL_M.asDiagonal() * f_rhs + s.proximal_p * uv_flat);
     }
 
   }
@@ -874,26 +913,69 @@ IGL_INLINE void igl::slim_precompute(
 
   igl::slim::pre_calc(data);
   data.energy = igl::slim::compute_energy(data,data.V_o) / data.mesh_area;
+  data.iter = 0;
+  data.aa = igl::AndersonAcceleration();
 }
 
 IGL_INLINE Eigen::MatrixXd igl::slim_solve(SLIMData &data, int iter_num)
 {
+  SLIMData::Timings timings;
+  return igl::slim_solve(data, iter_num, timings);
+}
+
+IGL_INLINE Eigen::MatrixXd igl::slim_solve(SLIMData &data, int iter_num, SLIMData::Timings &timings)
+{
+  timings = SLIMData::Timings();
+  data.energies.resize(iter_num);
+  if (data.anderson_window > 0)
+  {
+    // restart the acceleration if the window or V_o changed since the last call
+    Eigen::Map<const Eigen::VectorXd> x(data.V_o.data(), data.V_o.size());
+    if (data.aa.window() != data.anderson_window ||
+        data.aa.current().size() != x.size() || data.aa.current() != x)
+      data.aa.init(data.anderson_window, x);
+  }
   for (int i = 0; i < iter_num; i++)
   {
+    const double energy_prev = data.energy;
     Eigen::MatrixXd dest_res;
     dest_res = data.V_o;
 
     // Solve Weighted Proxy
-    igl::slim::update_weights_and_closest_rotations(data,data.V, data.F, dest_res);
+    double t = igl::get_seconds();
+    igl::slim::compute_jacobians(data, dest_res);
+    double t_end = igl::get_seconds();
+    timings.jacobians += t_end - t;
+    t = t_end;
+    igl::slim::update_weights_and_closest_rotations(data,data.V, data.F);
+    t_end = igl::get_seconds();
+    timings.weights += t_end - t;
+    t = t_end;
+    igl::slim::build_linear_system(data, data.L);
+    t_end = igl::get_seconds();
+    timings.assembly += t_end - t;
+    t = t_end;
     igl::slim::solve_weighted_arap(data,data.V, data.F, dest_res, data.b, data.bc);
-
-    double old_energy = data.energy;
+    t_end = igl::get_seconds();
+    timings.solve += t_end - t;
+    t = t_end;
 
     std::function<double(Eigen::MatrixXd &)> compute_energy = [&](
         Eigen::MatrixXd &aaa) { return igl::slim::compute_energy(data,aaa); };
 
     data.energy = igl::flip_avoiding_line_search(data.F, data.V_o, dest_res, compute_energy,
                                                  data.energy * data.mesh_area) / data.mesh_area;
+    t_end = igl::get_seconds();
+    timings.line_search += t_end - t;
+    t = t_end;
+
+    if (data.anderson_window > 0)
+    {
+      igl::slim::anderson_step(data, energy_prev);
+      timings.acceleration += igl::get_seconds() - t;
+    }
+    data.energies(i) = data.energy;
+    data.iter++;
   }
   return data.V_o;
 }
@@ -9,8 +9,10 @@
 #define SLIM_H
 
 #include "igl_inline.h"
+#include "AndersonAcceleration.h"
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <memory>
 
 namespace igl
 {
@@ -40,10 +42,27 @@ struct SLIMData
 
   double exp_factor; // used for exponential energies, ignored otherwise
   bool mesh_improvement_3d; // only supported for 3d
+  // number of previous iterates combined by Anderson acceleration of the
+  // iterations, 0 disables it
+  int anderson_window = 0;
 
   // Output
   Eigen::MatrixXd V_o; // #V by dim list of mesh vertex positions (dim = 2 for parametrization, 3 otherwise)
   double energy; // objective value
+  int iter; // number of iterations since slim_precompute
+  Eigen::VectorXd energies; // objective value after each iteration of the last slim_solve
+
+  // Time in seconds spent in each phase of slim_solve
+  struct Timings
+  {
+    double jacobians; // computing the jacobians
+    double weights; // computing the weights and closest rotations
+    double assembly; // assembling the linear system
+    double solve; // factorizing and solving the linear system
+    double line_search; // flip avoiding line search
+    double acceleration; // Anderson acceleration and its safeguard
+    Timings():jacobians(0),weights(0),assembly(0),solve(0),line_search(0),acceleration(0){}
+  };
 
   // INTERNAL
   Eigen::VectorXd M;
@@ -60,6 +79,24 @@ struct SLIMData
   Eigen::VectorXd W_21; Eigen::VectorXd W_22; Eigen::VectorXd W_23;
   Eigen::VectorXd W_31; Eigen::VectorXd W_32; Eigen::VectorXd W_33;
   Eigen::SparseMatrix<double> Dx,Dy,Dz;
+  // #F by dim*(dim+1) entries of Dx,Dy,Dz of the vertices of each element
+  Eigen::MatrixXd Dl;
+  // Assembly plan of the linear system: #F by (dim+1)^2 products of the
+  // gradient rows of pairs of element vertices, #F by dim^2 element
+  // coefficients of the dim by dim blocks, sparsity pattern of the system
+  // and triplets of its entries (see sparse_assembly_pattern)
+  Eigen::MatrixXd DD,WW;
+  Eigen::SparseMatrix<double> L;
+  Eigen::VectorXi L_slots,L_order;
+  // soft constraint indices the assembly plan was built for
+  Eigen::VectorXi L_b;
+  // Solvers reusing the symbolic analysis of L (held by pointer as Eigen's
+  // solvers are noncopyable: copies of SLIMData share them until their next
+  // analysis, so copies should not be solved concurrently)
+  std::shared_ptr<Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > > ldlt;
+  std::shared_ptr<Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> > cg;
+  // Anderson acceleration state, kept across calls to slim_solve
+  AndersonAcceleration aa;
   int f_n,v_n;
   bool first_solve;
   bool has_pre_calc = false;
@@ -84,10 +121,15 @@ IGL_INLINE void slim_precompute(
   Eigen::MatrixXd& bc,
   double soft_p);
 
-// Run iter_num iterations of SLIM
+// Run iter_num iterations of SLIM. If data.anderson_window > 0 the iterations
+// are accelerated with igl::AndersonAcceleration; an accelerated iterate is
+// only accepted if it flips no element and decreases the energy.
 // Outputs:
 //    V_o (in SLIMData): #V by dim list of mesh vertex positions
 IGL_INLINE Eigen::MatrixXd slim_solve(SLIMData& data, int iter_num);
+// Outputs:
+//    timings     time spent in each phase, summed over the iterations
+IGL_INLINE Eigen::MatrixXd slim_solve(SLIMData& data, int iter_num, SLIMData::Timings& timings);
 
 } // END NAMESPACE
 
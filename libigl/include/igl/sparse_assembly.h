@@ -0,0 +1,275 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SPARSE_ASSEMBLY_H
+#define IGL_SPARSE_ASSEMBLY_H
+#include "parallel_for.h"
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace igl
+{
+  // SPARSE_ASSEMBLY_PATTERN Compute the compressed (column-major) sparsity
+  // pattern of the matrix assembled from a list of (i,j,v) triplets, where
+  // each triplet is only known through a function of its index, together with
+  // the triplets contributing to each stored entry. Together with
+  // sparse_assembly_values this is a drop-in replacement of
+  //
+  //     std::vector<Eigen::Triplet<Scalar> > IJV;
+  //     for(int t = 0;t<num_triplets;t++)
+  //     {
+  //       int i,j;
+  //       ij(t,i,j);
+  //       IJV.emplace_back(i,j,value(t));
+  //     }
+  //     X.resize(rows,cols);
+  //     X.setFromTriplets(IJV.begin(),IJV.end());
+  //
+  // which runs in parallel, needs a fraction of the memory and gives
+  // bitwise identical results. The pattern only depends on the indices so it
+  // can be reused to assemble new values.
+  //
+  // Inputs:
+  //   rows  number of rows of X
+  //   cols  number of columns of X
+  //   num_triplets  number of triplets
+  //   ij  function handle so that ij(t,i,j) sets the row i and column j of
+  //     the t-th triplet
+  // Outputs:
+  //   X  rows by cols compressed sparse matrix with the sparsity pattern of
+  //     the triplets (values are left unassigned)
+  //   slots  X.nonZeros()+1 list of offsets into order so that the triplets
+  //     contributing to X.valuePtr()[k] are order(slots(k)) ...
+  //     order(slots(k+1)-1)
+  //   order  num_triplets list of triplet indices, sorted by slot and then
+  //     by increasing index
+  template <typename IJFunctionType, typename Scalar>
+  inline void sparse_assembly_pattern(
+    const int rows,
+    const int cols,
+    const int num_triplets,
+    const IJFunctionType & ij,
+    Eigen::SparseMatrix<Scalar> & X,
+    Eigen::VectorXi & slots,
+    Eigen::VectorXi & order);
+  // SPARSE_ASSEMBLY_VALUES Assemble the values of a matrix with a sparsity
+  // pattern computed by sparse_assembly_pattern. Each entry is the sum of the
+  // values of its triplets in order of increasing index, so the result is
+  // bitwise identical to Eigen's setFromTriplets regardless of the number of
+  // threads.
+  //
+  // Inputs:
+  //   slots  X.nonZeros()+1 list of offsets into order (see
+  //     sparse_assembly_pattern)
+  //   order  list of triplet indices (see sparse_assembly_pattern)
+  //   value  function handle so that value(t) returns the value of the t-th
+  //     triplet
+  //   X  compressed sparse matrix output by sparse_assembly_pattern
+  // Outputs:
+  //   X  same matrix with its values overwritten
+  template <typename ValueFunctionType, typename Scalar>
+  inline void sparse_assembly_values(
+    const Eigen::VectorXi & slots,
+    const Eigen::VectorXi & order,
+    const ValueFunctionType & value,
+    Eigen::SparseMatrix<Scalar> & X);
+  // SPARSE_ASSEMBLY Assemble a matrix from a list of (i,j,v) triplets known
+  // through functions of their index (see sparse_assembly_pattern and
+  // sparse_assembly_values).
+  //
+  // Inputs:
+  //   rows  number of rows of X
+  //   cols  number of columns of X
+  //   num_triplets  number of triplets
+  //   ij  function handle so that ij(t,i,j) sets the row i and column j of
+  //     the t-th triplet
+  //   value  function handle so that value(t) returns the value of the t-th
+  //     triplet
+  // Outputs:
+  //   X  rows by cols assembled sparse matrix
+  template <
+    typename IJFunctionType,
+    typename ValueFunctionType,
+    typename Scalar>
+  inline void sparse_assembly(
+    const int rows,
+    const int cols,
+    const int num_triplets,
+    const IJFunctionType & ij,
+    const ValueFunctionType & value,
+    Eigen::SparseMatrix<Scalar> & X);
+}
+
+// Implementation
+
+#include <cassert>
+
+template <typename IJFunctionType, typename Scalar>
+inline void igl::sparse_assembly_pattern(
+  const int rows,
+  const int cols,
+  const int num_triplets,
+  const IJFunctionType & ij,
+  Eigen::SparseMatrix<Scalar> & X,
+  Eigen::VectorXi & slots,
+  Eigen::VectorXi & order)
+{
+  using namespace std;
+  // Bucket triplets by column (counting sort), remembering their rows. In
+  // parallel the order within a bucket is arbitrary: it is fixed by sorting
+  // each bucket below.
+  vector<atomic<int> > cursor(cols);
+  for(int c = 0;c<cols;c++)
+  {
+    cursor[c].store(0,memory_order_relaxed);
+  }
+  bool serial = true;
+  const auto set_serial = [&serial](const size_t n){ serial = n<=1; };
+  const auto no_op = [](const size_t){};
+  // Post-increment cursor[j], without the cost of an atomic operation when
+  // serial
+  const auto increment = [&](const int j)->int
+  {
+    if(serial)
+    {
+      const int o = cursor[j].load(memory_order_relaxed);
+      cursor[j].store(o+1,memory_order_relaxed);
+      return o;
+    }
+    return cursor[j].fetch_add(1,memory_order_relaxed);
+  };
+  parallel_for(num_triplets,set_serial,[&](const int t,const size_t)
+  {
+    int i,j;
+    ij(t,i,j);
+    assert(i >= 0 && i < rows && "Row index out of bounds");
+    assert(j >= 0 && j < cols && "Column index out of bounds");
+    increment(j);
+  },no_op,10000);
+  Eigen::VectorXi bucket(cols+1);
+  bucket(0) = 0;
+  for(int c = 0;c<cols;c++)
+  {
+    bucket(c+1) = bucket(c) + cursor[c].load(memory_order_relaxed);
+    cursor[c].store(bucket(c),memory_order_relaxed);
+  }
+  // (row,index) of each triplet, by column
+  vector<pair<int,int> > RT(num_triplets);
+  parallel_for(num_triplets,set_serial,[&](const int t,const size_t)
+  {
+    int i,j;
+    ij(t,i,j);
+    RT[increment(j)] = make_pair(i,t);
+  },no_op,10000);
+  vector<atomic<int> >().swap(cursor);
+
+  // Sort each bucket by (row,index) and count distinct rows
+  Eigen::VectorXi col_nnz(cols);
+  parallel_for(cols,[&](const int c)
+  {
+    const auto begin = RT.begin()+bucket(c);
+    const auto end = RT.begin()+bucket(c+1);
+    if(end-begin <= 32)
+    {
+      // Buckets are typically tiny (and already sorted by index if serial):
+      // insertion sort
+      for(auto a = begin;a<end;a++)
+      {
+        const pair<int,int> x = *a;
+        auto b = a;
+        for(;b>begin && *(b-1) > x;b--)
+        {
+          *b = *(b-1);
+        }
+        *b = x;
+      }
+    }else
+    {
+      std::sort(begin,end);
+    }
+    int nnz = 0;
+    for(auto a = begin;a<end;a++)
+    {
+      nnz += (a == begin || a->first != (a-1)->first) ? 1 : 0;
+    }
+    col_nnz(c) = nnz;
+  },1000);
+
+  // Compressed pattern
+  X.resize(rows,cols);
+  int nnz = 0;
+  for(int c = 0;c<cols;c++)
+  {
+    X.outerIndexPtr()[c] = nnz;
+    nnz += col_nnz(c);
+  }
+  X.outerIndexPtr()[cols] = nnz;
+  X.resizeNonZeros(nnz);
+  slots.resize(nnz+1);
+  slots(nnz) = num_triplets;
+  order.resize(num_triplets);
+  parallel_for(cols,[&](const int c)
+  {
+    int k = X.outerIndexPtr()[c];
+    for(int o = bucket(c);o<bucket(c+1);o++)
+    {
+      if(o == bucket(c) || RT[o].first != RT[o-1].first)
+      {
+        X.innerIndexPtr()[k] = RT[o].first;
+        slots(k) = o;
+        k++;
+      }
+      order(o) = RT[o].second;
+    }
+    assert(k == X.outerIndexPtr()[c+1]);
+  },1000);
+}
+
+template <typename ValueFunctionType, typename Scalar>
+inline void igl::sparse_assembly_values(
+  const Eigen::VectorXi & slots,
+  const Eigen::VectorXi & order,
+  const ValueFunctionType & value,
+  Eigen::SparseMatrix<Scalar> & X)
+{
+  assert(slots.size() == X.nonZeros()+1);
+  Scalar * values = X.valuePtr();
+  parallel_for(X.nonZeros(),[&](const int k)
+  {
+    // Same as setFromTriplets: assign the first value and add the others in
+    // order (so that, e.g., a single -0 stays -0)
+    Scalar v = Scalar(value(order(slots(k))));
+    for(int o = slots(k)+1;o<slots(k+1);o++)
+    {
+      v += Scalar(value(order(o)));
+    }
+    values[k] = v;
+  },10000);
+}
+
+template <
+  typename IJFunctionType,
+  typename ValueFunctionType,
+  typename Scalar>
+inline void igl::sparse_assembly(
+  const int rows,
+  const int cols,
+  const int num_triplets,
+  const IJFunctionType & ij,
+  const ValueFunctionType & value,
+  Eigen::SparseMatrix<Scalar> & X)
+{
+  Eigen::VectorXi slots,order;
+  sparse_assembly_pattern(rows,cols,num_triplets,ij,X,slots,order);
+  sparse_assembly_values(slots,order,value,X);
+}
+
+#endif
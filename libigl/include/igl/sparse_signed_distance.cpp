@@ -0,0 +1,274 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2015 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "sparse_signed_distance.h"
+#include "AABB.h"
+#include "WindingNumberAABB.h"
+#include "fast_winding_number.h"
+#include "parallel_for.h"
+#include "per_edge_normals.h"
+#include "per_face_normals.h"
+#include "per_vertex_normals.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+IGL_INLINE void igl::sparse_signed_distance(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const Eigen::AlignedBox3d & box,
+  const int s,
+  const int pad_count,
+  const double band,
+  const SignedDistanceType sign_type,
+  SparseSignedDistanceGrid & grid)
+{
+  using namespace Eigen;
+  using namespace std;
+  typedef SparseSignedDistanceGrid Grid;
+  const int B = Grid::BRICK_SIZE;
+  assert(V.cols() == 3 && "V should be 3D");
+  assert(F.cols() == 3 && "F should contain triangles");
+
+  // Same lattice as voxel_grid(box,s,pad_count,GV,res) without forming GV
+  MatrixXd::Index si = -1;
+  box.diagonal().maxCoeff(&si);
+  const double s_len = box.diagonal()(si);
+  assert(s>(pad_count*2+1) && "s should be > 2*pad_count+1");
+  const double ss = s - 2*pad_count;
+  for(int i = 0;i<3;i++)
+  {
+    grid.res(i) = i==si ? ss :
+      std::ceil(ss * (box.max()(i)-box.min()(i))/s_len);
+  }
+  grid.res.array() += 2*pad_count;
+  const Array<double,3,1> ps =
+    (double)(pad_count)/(grid.res.transpose().cast<double>().array()-1.);
+  const Array<double,3,1> A = box.diagonal().array()/(1.0-2.*ps);
+  Array<double,3,1>::Index ai = -1;
+  const double a = A.maxCoeff(&ai);
+  grid.h = a/(double)(grid.res(ai)-1);
+  grid.origin =
+    box.center().transpose() -
+    0.5*grid.h*(grid.res.cast<double>().array()-1.).matrix();
+  // A cube crossing the surface has all its corners within its diagonal of
+  // the surface
+  grid.band = std::max(band,std::sqrt(3.0))*grid.h;
+  grid.brick_res = (grid.res.array()+B-1)/B;
+  const long long nb =
+    (long long)grid.brick_res(0)*grid.brick_res(1)*grid.brick_res(2);
+
+  // Distance and sign queries
+  AABB<MatrixXd,3> tree;
+  tree.init(V,F);
+  MatrixXd FN,VN,EN;
+  MatrixXi E;
+  VectorXi EMAP;
+  WindingNumberAABB<Vector3d> hier;
+  FastWindingNumberData fwn;
+  switch(sign_type)
+  {
+    default:
+      assert(false && "Unknown SignedDistanceType");
+    case SIGNED_DISTANCE_TYPE_UNSIGNED:
+      break;
+    case SIGNED_DISTANCE_TYPE_DEFAULT:
+    case SIGNED_DISTANCE_TYPE_WINDING_NUMBER:
+      hier.set_mesh(V,F);
+      hier.grow();
+      break;
+    case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
+      fast_winding_number_precompute(V,F,fwn);
+      break;
+    case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
+      per_face_normals(V,F,FN);
+      per_vertex_normals(V,F,PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE,FN,VN);
+      per_edge_normals(
+        V,F,PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM,FN,EN,E,EMAP);
+      break;
+  }
+  // Signed distance at q (not truncated)
+  const auto signed_distance_at = [&](const RowVector3d & q)->double
+  {
+    double sign = 1,sqrd;
+    int i = -1;
+    RowVector3d c,n;
+    switch(sign_type)
+    {
+      default:
+      case SIGNED_DISTANCE_TYPE_UNSIGNED:
+        sqrd = tree.squared_distance(V,F,q,i,c);
+        break;
+      case SIGNED_DISTANCE_TYPE_DEFAULT:
+      case SIGNED_DISTANCE_TYPE_WINDING_NUMBER:
+        signed_distance_winding_number(tree,V,F,hier,q,sign,sqrd,i,c);
+        break;
+      case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
+        signed_distance_fast_winding_number(tree,V,F,fwn,q,sign,sqrd,i,c);
+        break;
+      case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
+        signed_distance_pseudonormal(tree,V,F,FN,VN,EN,EMAP,q,sign,sqrd,i,c,n);
+        break;
+    }
+    return sign*sqrt(sqrd);
+  };
+
+  // Seed candidate bricks from bounding boxes of triangles grown by the band
+  vector<vector<long long> > T_candidates;
+  parallel_for(
+    F.rows(),
+    [&T_candidates](const size_t nt){ T_candidates.resize(nt); },
+    [&](const int f, const size_t t)
+    {
+      RowVector3d fmin = V.row(F(f,0)), fmax = V.row(F(f,0));
+      for(int c = 1;c<3;c++)
+      {
+        fmin = fmin.cwiseMin(V.row(F(f,c)));
+        fmax = fmax.cwiseMax(V.row(F(f,c)));
+      }
+      int lo[3],hi[3];
+      for(int d = 0;d<3;d++)
+      {
+        lo[d] = std::max(0,(int)std::ceil(
+          (fmin(d)-grid.band-grid.origin(d))/grid.h));
+        hi[d] = std::min(grid.res(d)-1,(int)std::floor(
+          (fmax(d)+grid.band-grid.origin(d))/grid.h));
+        if(lo[d] > hi[d])
+        {
+          return;
+        }
+        lo[d] /= B;
+        hi[d] /= B;
+      }
+      for(int bz = lo[2];bz<=hi[2];bz++)
+      {
+        for(int by = lo[1];by<=hi[1];by++)
+        {
+          for(int bx = lo[0];bx<=hi[0];bx++)
+          {
+            T_candidates[t].push_back(
+              bx + (long long)grid.brick_res(0)*(by+(long long)grid.brick_res(1)*bz));
+          }
+        }
+      }
+    },
+    [](const size_t){},
+    1000);
+  vector<long long> candidates;
+  for(const auto & Tc : T_candidates)
+  {
+    candidates.insert(candidates.end(),Tc.begin(),Tc.end());
+  }
+  T_candidates.clear();
+  sort(candidates.begin(),candidates.end());
+  candidates.erase(unique(candidates.begin(),candidates.end()),candidates.end());
+  // Discard bricks whose bounding sphere lies outside of the band (large
+  // triangles have loose bounding boxes)
+  const auto brick_corner = [&grid,B](const long long b)->RowVector3i
+  {
+    return B*RowVector3i(
+      b%grid.brick_res(0),
+      (b/grid.brick_res(0))%grid.brick_res(1),
+      b/grid.brick_res(0)/grid.brick_res(1));
+  };
+  const double brick_radius = 0.5*sqrt(3.)*(B-1)*grid.h;
+  vector<char> keep(candidates.size());
+  parallel_for(candidates.size(),[&](const size_t c)
+  {
+    const RowVector3d center =
+      grid.origin +
+      grid.h*(brick_corner(candidates[c]).cast<double>().array()+0.5*(B-1)).matrix();
+    int i;
+    RowVector3d cp;
+    keep[c] =
+      sqrt(tree.squared_distance(V,F,center,i,cp)) - brick_radius <= grid.band;
+  },1000);
+  grid.bricks.clear();
+  for(size_t c = 0;c<candidates.size();c++)
+  {
+    if(keep[c])
+    {
+      grid.bricks.push_back(candidates[c]);
+    }
+  }
+  grid.brick_map.clear();
+  grid.brick_map.reserve(grid.bricks.size());
+  for(int b = 0;b<(int)grid.bricks.size();b++)
+  {
+    grid.brick_map[grid.bricks[b]] = b;
+  }
+
+  // Evaluate samples of allocated bricks
+  const int B3 = B*B*B;
+  grid.values.resize(grid.bricks.size()*B3);
+  parallel_for(grid.bricks.size(),[&](const size_t b)
+  {
+    const RowVector3i corner = brick_corner(grid.bricks[b]);
+    for(int l = 0;l<B3;l++)
+    {
+      const int i = corner(0)+l%B;
+      const int j = corner(1)+(l/B)%B;
+      const int k = corner(2)+l/(B*B);
+      double & val = grid.values[b*B3+l];
+      if(i>=grid.res(0) || j>=grid.res(1) || k>=grid.res(2))
+      {
+        // Beyond lattice
+        val = grid.band;
+        continue;
+      }
+      val = std::max(-grid.band,std::min(grid.band,
+        signed_distance_at(grid.point(i,j,k))));
+    }
+  },1);
+
+  // Flood fill signs of unallocated bricks
+  const signed char UNKNOWN = 2;
+  grid.far_sign.assign(nb,UNKNOWN);
+  for(const long long b : grid.bricks)
+  {
+    grid.far_sign[b] = 0;
+  }
+  vector<long long> Q;
+  for(long long b = 0;b<nb;b++)
+  {
+    if(grid.far_sign[b] != UNKNOWN)
+    {
+      continue;
+    }
+    const RowVector3d center =
+      grid.origin +
+      grid.h*(brick_corner(b).cast<double>().array()+0.5*(B-1)).matrix();
+    const signed char sign = signed_distance_at(center) < 0 ? -1 : 1;
+    grid.far_sign[b] = sign;
+    Q.assign(1,b);
+    while(!Q.empty())
+    {
+      const long long c = Q.back();
+      Q.pop_back();
+      const RowVector3i cc = brick_corner(c)/B;
+      for(int d = 0;d<3;d++)
+      {
+        for(int o = -1;o<=1;o+=2)
+        {
+          RowVector3i nc = cc;
+          nc(d) += o;
+          if(nc(d) < 0 || nc(d) >= grid.brick_res(d))
+          {
+            continue;
+          }
+          const long long n =
+            nc(0) + (long long)grid.brick_res(0)*(nc(1)+(long long)grid.brick_res(1)*nc(2));
+          if(grid.far_sign[n] == UNKNOWN)
+          {
+            grid.far_sign[n] = sign;
+            Q.push_back(n);
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,115 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2015 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SPARSE_SIGNED_DISTANCE_H
+#define IGL_SPARSE_SIGNED_DISTANCE_H
+#include "igl_inline.h"
+#include "signed_distance.h"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <unordered_map>
+#include <vector>
+namespace igl
+{
+  // Narrow-band signed distance field sampled on the lattice of
+  // igl::voxel_grid, stored sparsely in bricks of 8x8x8 samples. Only bricks
+  // containing samples within the band of the surface are allocated. Every
+  // other brick only stores a sign.
+  //
+  // Values are truncated to [-band,band]. So long as band >= sqrt(3)*h, every
+  // lattice cube crossing the zero level set has all its corners (in
+  // particular its lowest one, which owns it) inside allocated bricks, so
+  // extracting the surface (see copyleft/sparse_marching_cubes.h) gives the
+  // same result as on the dense grid.
+  struct SparseSignedDistanceGrid
+  {
+    enum { BRICK_SIZE = 8 };
+    // Sample (i,j,k) is at origin + h*(i,j,k), 0 <= (i,j,k) < res
+    Eigen::RowVector3d origin;
+    double h;
+    Eigen::RowVector3i res;
+    // Half width of band (in units of distance, not samples)
+    double band;
+    // Number of bricks along each side: ceil(res/BRICK_SIZE)
+    Eigen::RowVector3i brick_res;
+    // Map from linear brick index (bx + brick_res(0)*(by + brick_res(1)*bz))
+    // to position in bricks
+    std::unordered_map<long long,int> brick_map;
+    // List of allocated linear brick indices (sorted)
+    std::vector<long long> bricks;
+    // Values of samples of allocated bricks: BRICK_SIZE^3 per brick, x fastest
+    std::vector<double> values;
+    // Sign (-1 inside, +1 outside) of each unallocated brick (0 if
+    // allocated), indexed by linear brick index
+    std::vector<signed char> far_sign;
+    SparseSignedDistanceGrid():
+      origin(0,0,0),h(0),res(0,0,0),band(0),brick_res(0,0,0),
+      brick_map(),bricks(),values(),far_sign()
+    {}
+    // Returns linear index of brick containing sample (i,j,k)
+    inline long long brick_index(const int i, const int j, const int k) const
+    {
+      return (long long)(i/BRICK_SIZE) + (long long)brick_res(0)*(
+        (long long)(j/BRICK_SIZE) + (long long)brick_res(1)*(k/BRICK_SIZE));
+    }
+    // Returns position of brick containing sample (i,j,k) in bricks (-1 if
+    // not allocated)
+    inline int brick(const int i, const int j, const int k) const
+    {
+      const auto it = brick_map.find(brick_index(i,j,k));
+      return it == brick_map.end() ? -1 : it->second;
+    }
+    // Returns (truncated) signed distance at sample (i,j,k)
+    inline double value(const int i, const int j, const int k) const
+    {
+      const int b = brick(i,j,k);
+      if(b < 0)
+      {
+        return far_sign[brick_index(i,j,k)]*band;
+      }
+      return values[
+        b*BRICK_SIZE*BRICK_SIZE*BRICK_SIZE +
+        i%BRICK_SIZE + BRICK_SIZE*(j%BRICK_SIZE + BRICK_SIZE*(k%BRICK_SIZE))];
+    }
+    // Returns position of sample (i,j,k)
+    inline Eigen::RowVector3d point(const int i, const int j, const int k) const
+    {
+      return origin + h*Eigen::RowVector3d(i,j,k);
+    }
+  };
+  // Compute a sparse narrow-band signed distance field to a mesh. Bricks are
+  // seeded from the bounding boxes of the triangles grown by the band, bricks
+  // entirely outside of the band are discarded, and the remaining bricks are
+  // evaluated in parallel. Signs of unallocated bricks are flood filled:
+  // each connected component of unallocated bricks gets the sign of one
+  // query at one of its bricks.
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of triangle indices into V
+  //   box  bounding box to enclose by grid (see voxel_grid.h)
+  //   s  number of samples on largest side (including 2*pad_count)
+  //   pad_count  number of samples beyond box
+  //   band  half width of band in units of lattice spacing (at least
+  //     sqrt(3), smaller values are clamped)
+  //   sign_type  method for computing sign (see signed_distance.h)
+  // Outputs:
+  //   grid  sparse signed distance field
+  IGL_INLINE void sparse_signed_distance(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const Eigen::AlignedBox3d & box,
+    const int s,
+    const int pad_count,
+    const double band,
+    const SignedDistanceType sign_type,
+    SparseSignedDistanceGrid & grid);
+}
+#ifndef IGL_STATIC_LIBRARY
+#  include "sparse_signed_distance.cpp"
+#endif
+#endif
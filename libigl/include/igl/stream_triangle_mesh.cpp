@@ -0,0 +1,167 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "stream_triangle_mesh.h"
+#include "pathinfo.h"
+#include "ply.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+IGL_INLINE bool igl::stream_triangle_mesh(
+  const std::string & filename,
+  const std::function<void(const double,const double,const double)> & vertex,
+  const std::function<void(const int,const int,const int)> & face)
+{
+  using namespace std;
+  string d,b,ext,f;
+  pathinfo(filename,d,b,ext,f);
+  transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  FILE * fp = fopen(filename.c_str(),"r");
+  if(fp == NULL)
+  {
+    fprintf(stderr,"IOError: stream_triangle_mesh() could not open %s\n",
+      filename.c_str());
+    return false;
+  }
+  if(ext == "obj")
+  {
+#ifndef IGL_LINE_MAX
+#  define IGL_LINE_MAX 2048
+#endif
+    char line[IGL_LINE_MAX];
+    int line_no = 1;
+    int num_vertices = 0;
+    vector<int> polygon;
+    while(fgets(line, IGL_LINE_MAX, fp) != NULL)
+    {
+      char * l = line;
+      while(isspace(*l))
+      {
+        l++;
+      }
+      if(l[0] == 'v' && isspace(l[1]))
+      {
+        double x[3];
+        if(sscanf(l+1,"%lf %lf %lf",&x[0],&x[1],&x[2]) != 3)
+        {
+          fprintf(stderr,
+            "Error: stream_triangle_mesh() vertex on line %d should have 3 "
+            "coordinates\n",line_no);
+          fclose(fp);
+          return false;
+        }
+        vertex(x[0],x[1],x[2]);
+        num_vertices++;
+      }else if(l[0] == 'f' && isspace(l[1]))
+      {
+        // Each word starts with the vertex index (possibly followed by
+        // /texture/normal indices)
+        polygon.clear();
+        l++;
+        while(true)
+        {
+          char * end;
+          const long i = strtol(l,&end,10);
+          if(end == l)
+          {
+            break;
+          }
+          polygon.push_back(i<0 ? i+num_vertices : i-1);
+          l = end;
+          while(*l != '\0' && !isspace(*l))
+          {
+            l++;
+          }
+        }
+        if(polygon.size() < 3)
+        {
+          fprintf(stderr,
+            "Error: stream_triangle_mesh() face on line %d has fewer than 3 "
+            "vertices\n",line_no);
+          fclose(fp);
+          return false;
+        }
+        for(size_t c = 2;c<polygon.size();c++)
+        {
+          face(polygon[0],polygon[c-1],polygon[c]);
+        }
+      }
+      line_no++;
+    }
+    fclose(fp);
+    return true;
+  }else if(ext == "ply")
+  {
+    // See readPLY
+    typedef struct Vertex {
+      double x,y,z;
+    } Vertex;
+    typedef struct Face {
+      unsigned char nverts;
+      int *verts;
+    } Face;
+    PlyProperty vert_props[] = {
+      {"x", PLY_DOUBLE, PLY_DOUBLE, offsetof(Vertex,x), 0, 0, 0, 0},
+      {"y", PLY_DOUBLE, PLY_DOUBLE, offsetof(Vertex,y), 0, 0, 0, 0},
+      {"z", PLY_DOUBLE, PLY_DOUBLE, offsetof(Vertex,z), 0, 0, 0, 0},
+    };
+    PlyProperty face_props[] = {
+      {"vertex_indices", PLY_INT, PLY_INT, offsetof(Face,verts),
+        1, PLY_UCHAR, PLY_UCHAR, offsetof(Face,nverts)},
+    };
+    int nelems;
+    char ** elem_names;
+    PlyFile * in_ply = ply_read(fp,&nelems,&elem_names);
+    if(in_ply == NULL)
+    {
+      fclose(fp);
+      return false;
+    }
+    PlyProperty **plist;
+    int nprops;
+    int elem_count;
+    plist = ply_get_element_description(in_ply,"vertex",&elem_count,&nprops);
+    if(plist != NULL)
+    {
+      ply_get_property(in_ply,"vertex",&vert_props[0]);
+      ply_get_property(in_ply,"vertex",&vert_props[1]);
+      ply_get_property(in_ply,"vertex",&vert_props[2]);
+      for(int j = 0;j<elem_count;j++)
+      {
+        Vertex v;
+        ply_get_element_setup(in_ply,"vertex",3,vert_props);
+        ply_get_element(in_ply,(void*)&v);
+        vertex(v.x,v.y,v.z);
+      }
+    }
+    plist = ply_get_element_description(in_ply,"face",&elem_count,&nprops);
+    if(plist != NULL)
+    {
+      ply_get_property(in_ply,"face",&face_props[0]);
+      for(int j = 0;j<elem_count;j++)
+      {
+        Face g;
+        ply_get_element(in_ply,(void*)&g);
+        for(int c = 2;c<g.nverts;c++)
+        {
+          face(g.verts[0],g.verts[c-1],g.verts[c]);
+        }
+        free(g.verts);
+      }
+    }
+    ply_close(in_ply);
+    return true;
+  }
+  fprintf(stderr,"Error: stream_triangle_mesh() %s is not supported\n",
+    ext.c_str());
+  fclose(fp);
+  return false;
+}
@@ -0,0 +1,38 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_STREAM_TRIANGLE_MESH_H
+#define IGL_STREAM_TRIANGLE_MESH_H
+#include "igl_inline.h"
+#include <functional>
+#include <string>
+namespace igl
+{
+  // Read a mesh from an .obj or .ply file one element at a time, passing each
+  // vertex and face to a callback instead of storing the mesh. Memory use does
+  // not depend on the size of the mesh. Polygons are triangulated as fans.
+  //
+  // Inputs:
+  //   filename  path to .obj or .ply file
+  //   vertex  callback called with the position of each vertex, in order:
+  //     vertex(x,y,z)
+  //   face  callback called with the (0-based) vertex indices of each
+  //     triangle: face(i,j,k). .obj files may interleave vertices and faces:
+  //     faces only refer to vertices already passed to vertex.
+  // Returns true iff success
+  //
+  // See also: read_triangle_mesh, readOBJ, readPLY
+  IGL_INLINE bool stream_triangle_mesh(
+    const std::string & filename,
+    const std::function<void(const double,const double,const double)> & vertex,
+    const std::function<void(const int,const int,const int)> & face);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "stream_triangle_mesh.cpp"
+#endif
+#endif
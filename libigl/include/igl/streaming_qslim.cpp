@@ -0,0 +1,662 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "streaming_qslim.h"
+#include "IndexedPriorityQueue.h"
+#include "connect_boundary_to_infinity.h"
+#include "decimate.h"
+#include "edge_flaps.h"
+#include "max_faces_stopping_condition.h"
+#include "per_vertex_point_to_plane_quadrics.h"
+#include "qslim_optimal_collapse_edge_callbacks.h"
+#include "remove_unreferenced.h"
+#include "slice.h"
+#include "slice_mask.h"
+#include "stream_triangle_mesh.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace igl
+{
+  namespace streaming_qslim_internal
+  {
+    typedef std::tuple<Eigen::MatrixXd,Eigen::RowVectorXd,double> Quadric;
+    // Same as igl::qslim(V,F,...) but edges incident on locked vertices are
+    // never collapsed and vertex quadrics may be given.
+    //
+    // Inputs:
+    //   locked  list of whether each vertex is locked (vertices past its end
+    //     are not)
+    //   quadrics  #V list of vertex quadrics, or empty to compute them from
+    //     V,F (see per_vertex_point_to_plane_quadrics)
+    // Outputs:
+    //   quadrics  #U list of accumulated quadrics of output vertices
+    IGL_INLINE bool qslim_locked(
+      Eigen::MatrixXd && V,
+      Eigen::MatrixXi && F,
+      const std::vector<bool> & locked,
+      std::vector<Quadric> & quadrics,
+      const size_t max_m,
+      Eigen::MatrixXd & U,
+      Eigen::MatrixXi & G,
+      Eigen::VectorXi & J,
+      Eigen::VectorXi & I)
+    {
+      const int orig_m = F.rows();
+      int m = F.rows();
+      {
+        Eigen::MatrixXi FO;
+        connect_boundary_to_infinity(F,(int)V.rows(),FO);
+        F.swap(FO);
+      }
+      V.conservativeResize(V.rows()+1,V.cols());
+      const double inf = std::numeric_limits<double>::infinity();
+      V.row(V.rows()-1).setConstant(inf);
+      Eigen::VectorXi EMAP;
+      Eigen::MatrixXi E,EF,EI;
+      edge_flaps(F,E,EMAP,EF,EI);
+      if(quadrics.empty())
+      {
+        per_vertex_point_to_plane_quadrics(V,F,EMAP,EF,EI,quadrics);
+      }else
+      {
+        // Collapsing onto the point at infinity always costs infinity
+        const int dim = V.cols();
+        quadrics.push_back(Quadric{
+          Eigen::MatrixXd::Identity(dim,dim),
+          Eigen::RowVectorXd::Constant(dim,-inf),
+          inf});
+      }
+      int v1 = -1;
+      int v2 = -1;
+      typedef IndexedPriorityQueue<> PQ;
+      decimate_callback_types<PQ>::cost_and_placement qslim_cost_and_placement;
+      decimate_callback_types<PQ>::pre_collapse pre_collapse;
+      decimate_callback_types<PQ>::post_collapse post_collapse;
+      qslim_optimal_collapse_edge_callbacks<PQ>(
+        E,quadrics,v1,v2,qslim_cost_and_placement,pre_collapse,post_collapse);
+      const auto is_locked = [&locked](const int v)
+      {
+        return v < (int)locked.size() && locked[v];
+      };
+      const decimate_callback_types<PQ>::cost_and_placement cost_and_placement =
+        [&](
+        const int e,
+        const Eigen::MatrixXd & V,
+        const Eigen::MatrixXi & F,
+        const Eigen::MatrixXi & E,
+        const Eigen::VectorXi & EMAP,
+        const Eigen::MatrixXi & EF,
+        const Eigen::MatrixXi & EI,
+        double & cost,
+        Eigen::RowVectorXd & p)
+      {
+        qslim_cost_and_placement(e,V,F,E,EMAP,EF,EI,cost,p);
+        if(is_locked(E(e,0)) || is_locked(E(e,1)))
+        {
+          cost = inf;
+        }
+      };
+      const bool ret = decimate<PQ>(
+        std::move(V),std::move(F),
+        cost_and_placement,
+        max_faces_stopping_condition<PQ>(m,orig_m,max_m),
+        pre_collapse,
+        post_collapse,
+        std::move(E),std::move(EMAP),std::move(EF),std::move(EI),
+        U,G,J,I);
+      // Remove phony boundary faces and clean up
+      const Eigen::Array<bool,Eigen::Dynamic,1> keep = (J.array()<orig_m);
+      slice_mask(Eigen::MatrixXi(G),keep,1,G);
+      slice_mask(Eigen::VectorXi(J),keep,1,J);
+      Eigen::VectorXi _1,I2;
+      remove_unreferenced(Eigen::MatrixXd(U),Eigen::MatrixXi(G),U,G,_1,I2);
+      slice(Eigen::VectorXi(I),I2,1,I);
+      std::vector<Quadric> U_quadrics(I.size());
+      for(int u = 0;u<I.size();u++)
+      {
+        std::swap(U_quadrics[u],quadrics[I(u)]);
+      }
+      quadrics.swap(U_quadrics);
+      return ret;
+    }
+  }
+}
+
+IGL_INLINE bool igl::streaming_qslim(
+  const std::string & filename,
+  const size_t max_m,
+  const size_t max_chunk_m,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
+{
+  using namespace std;
+  // Number of bits per coordinate of grid cells
+  const int L = 7;
+  const int R = 1<<L;
+  // Number of vertex positions/faces read or written at once
+  const int block = 1<<16;
+
+  // Read the mesh into binary temporary files
+  FILE * vfile = tmpfile();
+  FILE * ffile = tmpfile();
+  // Single spill file holding the vertices then the faces of each chunk
+  // contiguously (one temp file per chunk would run out of descriptors)
+  FILE * sfile = tmpfile();
+  const auto close_files = [&]()
+  {
+    for(FILE * file : {vfile,ffile,sfile})
+    {
+      if(file != NULL)
+      {
+        fclose(file);
+      }
+    }
+  };
+  if(vfile == NULL || ffile == NULL || sfile == NULL)
+  {
+    fprintf(stderr,"IOError: streaming_qslim() could not open temp file\n");
+    close_files();
+    return false;
+  }
+  int n = 0;
+  int m = 0;
+  double bmin[3],bmax[3];
+  std::fill(bmin,bmin+3,numeric_limits<double>::infinity());
+  std::fill(bmax,bmax+3,-numeric_limits<double>::infinity());
+  if(!stream_triangle_mesh(filename,
+    [&](const double x,const double y,const double z)
+    {
+      const double p[3] = {x,y,z};
+      fwrite(p,sizeof(double),3,vfile);
+      for(int d = 0;d<3;d++)
+      {
+        bmin[d] = std::min(bmin[d],p[d]);
+        bmax[d] = std::max(bmax[d],p[d]);
+      }
+      n++;
+    },
+    [&](const int i,const int j,const int k)
+    {
+      const int t[3] = {i,j,k};
+      fwrite(t,sizeof(int),3,ffile);
+      m++;
+    }))
+  {
+    close_files();
+    return false;
+  }
+
+  // Morton code of the grid cell containing p
+  const auto cell = [&](const double * p)->int
+  {
+    int q[3];
+    for(int d = 0;d<3;d++)
+    {
+      const double extent = bmax[d]-bmin[d];
+      q[d] = extent > 0 ?
+        std::min((int)((p[d]-bmin[d])/extent*R),R-1) : 0;
+    }
+    int code = 0;
+    for(int b = 0;b<L;b++)
+    {
+      for(int d = 0;d<3;d++)
+      {
+        code |= ((q[d]>>b)&1) << (3*b+d);
+      }
+    }
+    return code;
+  };
+  // Call func(v,p) for each vertex v with position p of the temp file
+  vector<double> buffer(3*block);
+  const auto for_each_vertex =
+    [&](const std::function<void(const int,const double *)> & func)->bool
+  {
+    rewind(vfile);
+    for(int v0 = 0;v0<n;v0+=block)
+    {
+      const int nb = std::min(block,n-v0);
+      if((int)fread(buffer.data(),sizeof(double),3*nb,vfile) != 3*nb)
+      {
+        fprintf(stderr,
+          "IOError: streaming_qslim() could not read temp file\n");
+        return false;
+      }
+      for(int v = 0;v<nb;v++)
+      {
+        func(v0+v,&buffer[3*v]);
+      }
+    }
+    return true;
+  };
+  // Call func(f,t) for each face f with vertex indices t of the temp file
+  // until it returns false
+  vector<int> fbuffer(3*block);
+  const auto for_each_face =
+    [&](const std::function<bool(const int,const int *)> & func)->bool
+  {
+    rewind(ffile);
+    for(int f0 = 0;f0<m;f0+=block)
+    {
+      const int nb = std::min(block,m-f0);
+      if((int)fread(fbuffer.data(),sizeof(int),3*nb,ffile) != 3*nb)
+      {
+        fprintf(stderr,
+          "IOError: streaming_qslim() could not read temp file\n");
+        return false;
+      }
+      for(int f = 0;f<nb;f++)
+      {
+        if(!func(f0+f,&fbuffer[3*f]))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  // Cut the Morton curve through the grid into chunks of about max_chunk_m
+  // faces (estimated from the number of vertices)
+  vector<int> cell_chunk(1<<(3*L),0);
+  if(!for_each_vertex([&](const int,const double * p)
+    {
+      cell_chunk[cell(p)]++;
+    }))
+  {
+    close_files();
+    return false;
+  }
+  const double max_chunk_n =
+    std::max(1.0,(double)max_chunk_m*(double)n/std::max(m,1));
+  int num_chunks = 0;
+  {
+    double count = 0;
+    for(int & c : cell_chunk)
+    {
+      const int nc = c;
+      c = num_chunks;
+      count += nc;
+      if(count >= max_chunk_n)
+      {
+        num_chunks++;
+        count = 0;
+      }
+    }
+    if(count > 0)
+    {
+      num_chunks++;
+    }
+  }
+  vector<int> vertex_chunk(n);
+  vector<int> chunk_n(num_chunks,0);
+  if(!for_each_vertex([&](const int v,const double * p)
+    {
+      const int c = cell_chunk[cell(p)];
+      vertex_chunk[v] = c;
+      chunk_n[c]++;
+    }))
+  {
+    close_files();
+    return false;
+  }
+  vector<int>().swap(cell_chunk);
+
+  // Count the faces of each chunk, and keep faces whose vertices lie in
+  // different chunks as crossing faces. Vertices of crossing faces are
+  // locked.
+  vector<bool> locked(n,false);
+  vector<int> chunk_m(num_chunks,0);
+  // Crossing faces (index followed by vertex indices)
+  vector<int> CF;
+  // Indices into crossing faces around each chunk
+  vector<vector<int> > chunk_crossing(num_chunks);
+  if(!for_each_face([&](const int f,const int * t)->bool
+    {
+      for(int k = 0;k<3;k++)
+      {
+        if(t[k] < 0 || t[k] >= n)
+        {
+          fprintf(stderr,
+            "Error: streaming_qslim() face %d has invalid index %d\n",
+            f,t[k]);
+          return false;
+        }
+      }
+      const int c1 = vertex_chunk[t[0]];
+      const int c2 = vertex_chunk[t[1]];
+      const int c3 = vertex_chunk[t[2]];
+      if(c1 == c2 && c1 == c3)
+      {
+        chunk_m[c1]++;
+      }else
+      {
+        const int fc = CF.size()/4;
+        CF.push_back(f);
+        CF.insert(CF.end(),t,t+3);
+        locked[t[0]] = locked[t[1]] = locked[t[2]] = true;
+        chunk_crossing[c1].push_back(fc);
+        if(c2 != c1)
+        {
+          chunk_crossing[c2].push_back(fc);
+        }
+        if(c3 != c1 && c3 != c2)
+        {
+          chunk_crossing[c3].push_back(fc);
+        }
+      }
+      return true;
+    }))
+  {
+    close_files();
+    return false;
+  }
+
+  // Write the vertices (index followed by position) then the faces (index
+  // followed by vertex indices) of each chunk to its range of the spill
+  // file. Records are buffered per chunk and flushed at the chunk's offset.
+  const size_t vsize = sizeof(int)+3*sizeof(double);
+  const size_t fsize = 4*sizeof(int);
+  const size_t max_chunk_buffer = 1<<12;
+  vector<long> chunk_offset(num_chunks+1,0);
+  for(int c = 0;c<num_chunks;c++)
+  {
+    chunk_offset[c+1] = chunk_offset[c]+chunk_n[c]*vsize+chunk_m[c]*fsize;
+  }
+  vector<long> chunk_cursor(chunk_offset.begin(),chunk_offset.end()-1);
+  vector<vector<char> > chunk_buffer(num_chunks);
+  bool write_ok = true;
+  const auto flush = [&](const int c)
+  {
+    vector<char> & cb = chunk_buffer[c];
+    if(cb.empty())
+    {
+      return;
+    }
+    write_ok = write_ok &&
+      fseek(sfile,chunk_cursor[c],SEEK_SET) == 0 &&
+      fwrite(cb.data(),1,cb.size(),sfile) == cb.size();
+    chunk_cursor[c] += cb.size();
+    cb.clear();
+  };
+  const auto append = [&](const int c,const void * data,const size_t size)
+  {
+    vector<char> & cb = chunk_buffer[c];
+    cb.insert(cb.end(),(const char *)data,(const char *)data+size);
+    if(cb.size() >= max_chunk_buffer)
+    {
+      flush(c);
+    }
+  };
+  if(!for_each_vertex([&](const int v,const double * p)
+    {
+      append(vertex_chunk[v],&v,sizeof(int));
+      append(vertex_chunk[v],p,3*sizeof(double));
+    }))
+  {
+    close_files();
+    return false;
+  }
+  if(!for_each_face([&](const int f,const int * t)->bool
+    {
+      const int c = vertex_chunk[t[0]];
+      if(c == vertex_chunk[t[1]] && c == vertex_chunk[t[2]])
+      {
+        const int r[4] = {f,t[0],t[1],t[2]};
+        append(c,r,fsize);
+      }
+      return true;
+    }))
+  {
+    close_files();
+    return false;
+  }
+  for(int c = 0;c<num_chunks;c++)
+  {
+    flush(c);
+  }
+  vector<vector<char> >().swap(chunk_buffer);
+  fclose(ffile);
+  ffile = NULL;
+  if(!write_ok)
+  {
+    fprintf(stderr,"IOError: streaming_qslim() could not write temp file\n");
+    close_files();
+    return false;
+  }
+
+  // Stitched mesh: vertices (with their birth vertex and their quadric
+  // flattened as A,b,c) and faces (with their birth face)
+  vector<double> SV;
+  vector<int> SI;
+  vector<double> SQ;
+  vector<int> SF;
+  vector<int> SJ;
+  const int qsize = 3*3+3+1;
+  unordered_map<int,int> stitched_index;
+  const auto add_vertex = [&](const int v,const double * p)->int
+  {
+    const auto it = stitched_index.find(v);
+    if(it != stitched_index.end())
+    {
+      return it->second;
+    }
+    const int s = SI.size();
+    stitched_index[v] = s;
+    SI.push_back(v);
+    SV.insert(SV.end(),p,p+3);
+    SQ.resize(SQ.size()+qsize,0);
+    return s;
+  };
+  // Locked vertices are never moved: add them all up front
+  if(!for_each_vertex([&](const int v,const double * p)
+    {
+      if(locked[v])
+      {
+        add_vertex(v,p);
+      }
+    }))
+  {
+    close_files();
+    return false;
+  }
+  fclose(vfile);
+  vfile = NULL;
+
+  // Decimate each chunk, keeping its share of max_m faces. The crossing
+  // faces around the chunk are included (and left untouched as all their
+  // vertices are locked) so that the quadrics of the chunk's vertices
+  // account for all their faces and are carried over to the global pass.
+  const double ratio = (double)max_m/std::max(m,1);
+  for(int c = 0;c<num_chunks;c++)
+  {
+    const int nc = chunk_n[c];
+    const int mc = chunk_m[c];
+    const vector<int> & crossing = chunk_crossing[c];
+    vector<int> birth_v(nc);
+    vector<double> P(3*nc);
+    bool read_ok = fseek(sfile,chunk_offset[c],SEEK_SET) == 0;
+    for(int v = 0;read_ok && v<nc;v++)
+    {
+      read_ok =
+        fread(&birth_v[v],sizeof(int),1,sfile) == 1 &&
+        fread(&P[3*v],sizeof(double),3,sfile) == 3;
+    }
+    if(!read_ok)
+    {
+      fprintf(stderr,"IOError: streaming_qslim() could not read temp file\n");
+      close_files();
+      return false;
+    }
+    // Vertices of other chunks on crossing faces come after the chunk's own
+    vector<int> outer;
+    unordered_map<int,int> outer_index;
+    // Vertices were written in order of their index
+    const auto local = [&](const int v)->int
+    {
+      if(vertex_chunk[v] == c)
+      {
+        return
+          std::lower_bound(birth_v.begin(),birth_v.end(),v)-birth_v.begin();
+      }
+      const auto it = outer_index.find(v);
+      if(it != outer_index.end())
+      {
+        return it->second;
+      }
+      const int o = nc+outer.size();
+      outer_index[v] = o;
+      outer.push_back(v);
+      return o;
+    };
+    const int mcc = mc+crossing.size();
+    vector<int> birth_f(mc);
+    Eigen::MatrixXi F(mcc,3);
+    for(int f = 0;f<mc;f++)
+    {
+      int r[4];
+      if(fread(r,sizeof(int),4,sfile) != 4)
+      {
+        fprintf(stderr,
+          "IOError: streaming_qslim() could not read temp file\n");
+        close_files();
+        return false;
+      }
+      birth_f[f] = r[0];
+      F.row(f) = Eigen::RowVector3i(local(r[1]),local(r[2]),local(r[3]));
+    }
+    for(int f = 0;f<(int)crossing.size();f++)
+    {
+      const int * r = &CF[4*crossing[f]];
+      F.row(mc+f) = Eigen::RowVector3i(local(r[1]),local(r[2]),local(r[3]));
+    }
+    if(mcc == 0)
+    {
+      continue;
+    }
+    const int no = outer.size();
+    Eigen::MatrixXd V(nc+no,3);
+    vector<bool> locked_c(nc+no,true);
+    for(int v = 0;v<nc;v++)
+    {
+      V.row(v) = Eigen::RowVector3d(P[3*v+0],P[3*v+1],P[3*v+2]);
+      locked_c[v] = locked[birth_v[v]];
+    }
+    vector<double>().swap(P);
+    for(int o = 0;o<no;o++)
+    {
+      const int s = stitched_index[outer[o]];
+      V.row(nc+o) = Eigen::RowVector3d(SV[3*s+0],SV[3*s+1],SV[3*s+2]);
+    }
+    // Faces touching locked vertices can't all be removed: only the others
+    // are decimated in proportion to max_m
+    int seam_m = crossing.size();
+    for(int f = 0;f<mc;f++)
+    {
+      seam_m +=
+        locked_c[F(f,0)] || locked_c[F(f,1)] || locked_c[F(f,2)] ? 1 : 0;
+    }
+    Eigen::MatrixXd Uc;
+    Eigen::MatrixXi Gc;
+    Eigen::VectorXi Jc,Ic;
+    vector<streaming_qslim_internal::Quadric> quadrics;
+    streaming_qslim_internal::qslim_locked(
+      std::move(V),std::move(F),locked_c,quadrics,
+      seam_m+(size_t)std::ceil(ratio*(mcc-seam_m)),
+      Uc,Gc,Jc,Ic);
+    vector<int> index(Uc.rows(),-1);
+    for(int u = 0;u<Uc.rows();u++)
+    {
+      if(Ic(u) >= nc)
+      {
+        continue;
+      }
+      const double p[3] = {Uc(u,0),Uc(u,1),Uc(u,2)};
+      index[u] = add_vertex(birth_v[Ic(u)],p);
+      const auto & q = quadrics[u];
+      double * Q = &SQ[qsize*index[u]];
+      Eigen::Map<Eigen::Matrix3d> A(Q);
+      Eigen::Map<Eigen::RowVector3d> b(Q+9);
+      A = std::get<0>(q);
+      b = std::get<1>(q);
+      Q[12] = std::get<2>(q);
+    }
+    for(int g = 0;g<Gc.rows();g++)
+    {
+      // Crossing faces are stitched in below
+      if(Jc(g) >= mc)
+      {
+        continue;
+      }
+      for(int k = 0;k<3;k++)
+      {
+        SF.push_back(index[Gc(g,k)]);
+      }
+      SJ.push_back(birth_f[Jc(g)]);
+    }
+  }
+  fclose(sfile);
+  vector<int>().swap(vertex_chunk);
+  vector<vector<int> >().swap(chunk_crossing);
+
+  // Stitch in crossing faces
+  for(int f = 0;f<(int)CF.size()/4;f++)
+  {
+    for(int k = 1;k<4;k++)
+    {
+      SF.push_back(stitched_index[CF[4*f+k]]);
+    }
+    SJ.push_back(CF[4*f]);
+  }
+  vector<int>().swap(CF);
+  unordered_map<int,int>().swap(stitched_index);
+
+  // Global pass with the quadrics accumulated in the chunks
+  const int sn = SI.size();
+  const int sm = SJ.size();
+  Eigen::MatrixXd V =
+    Eigen::Map<Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> >(
+      SV.data(),sn,3);
+  vector<double>().swap(SV);
+  Eigen::MatrixXi F =
+    Eigen::Map<Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> >(
+      SF.data(),sm,3);
+  vector<int>().swap(SF);
+  vector<streaming_qslim_internal::Quadric> quadrics(sn);
+  for(int s = 0;s<sn;s++)
+  {
+    const double * Q = &SQ[qsize*s];
+    quadrics[s] = streaming_qslim_internal::Quadric{
+      Eigen::Map<const Eigen::Matrix3d>(Q),
+      Eigen::Map<const Eigen::RowVector3d>(Q+9),
+      Q[12]};
+  }
+  vector<double>().swap(SQ);
+  Eigen::VectorXi JS,IS;
+  const bool ret = streaming_qslim_internal::qslim_locked(
+    std::move(V),std::move(F),vector<bool>(),quadrics,max_m,U,G,JS,IS);
+  J.resize(JS.size());
+  for(int j = 0;j<JS.size();j++)
+  {
+    J(j) = SJ[JS(j)];
+  }
+  I.resize(IS.size());
+  for(int i = 0;i<IS.size();i++)
+  {
+    I(i) = SI[IS(i)];
+  }
+  return ret;
+}
@@ -0,0 +1,61 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_STREAMING_QSLIM_H
+#define IGL_STREAMING_QSLIM_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <string>
+namespace igl
+{
+  // Decimate a mesh too large to be loaded in memory, streamed from an .obj
+  // or .ply file, with the quadric error metric of igl::qslim.
+  //
+  // The mesh is read once (see stream_triangle_mesh) into temporary binary
+  // files. Vertices are then grouped into spatially coherent chunks of about
+  // max_chunk_m faces by cutting the Morton (Z-order) curve through a 128^3
+  // grid over the bounding box. Each chunk (faces whose vertices all lie in
+  // the chunk, plus the faces crossing into other chunks) is loaded and
+  // decimated on its own, while vertices of crossing faces are locked (edges
+  // incident on them are never collapsed) so that chunks still fit together.
+  // Faces away from locked vertices are decimated in proportion to max_m.
+  // Finally the decimated chunks are stitched with the crossing faces and the
+  // stitched mesh is decimated to max_m faces, starting from the quadrics
+  // accumulated in the chunks.
+  //
+  // Only one chunk is in memory at a time, besides one int and one bit per
+  // input vertex, the decimated chunks and the crossing faces. Temporary
+  // files (see std::tmpfile) take 24 bytes per vertex and 16 bytes per face.
+  //
+  // Inputs:
+  //   filename  path to .obj or .ply file of a manifold mesh (possibly with
+  //     boundary)
+  //   max_m  desired number of output faces
+  //   max_chunk_m  desired number of faces per chunk
+  // Outputs:
+  //   U  #U by 3 list of output vertex positions
+  //   G  #G by 3 list of output face indices into U
+  //   J  #G list of indices of birth faces (in the order of the file)
+  //   I  #U list of indices of birth vertices (in the order of the file)
+  // Returns true if the file could be read and max_m was reached (otherwise
+  //   #G > max_m)
+  //
+  // See also: qslim, decimate
+  IGL_INLINE bool streaming_qslim(
+    const std::string & filename,
+    const size_t max_m,
+    const size_t max_chunk_m,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "streaming_qslim.cpp"
+#endif
+#endif
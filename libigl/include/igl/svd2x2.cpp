@@ -0,0 +1,44 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "svd2x2.h"
+#include <cmath>
+
+IGL_INLINE void igl::svd2x2(
+  const Eigen::Matrix2d & A,
+  Eigen::Matrix2d & U,
+  Eigen::Vector2d & S,
+  Eigen::Matrix2d & V)
+{
+  const double a = A(0,0), b = A(0,1), c = A(1,0), d = A(1,1);
+  const double E = (a+d)/2, F = (a-d)/2;
+  const double G = (c+b)/2, H = (c-b)/2;
+  const double Q = std::sqrt(E*E+H*H), R = std::sqrt(F*F+G*G);
+  S(0) = Q+R;
+  // Q - R cancels for nearly singular matrices
+  S(1) = S(0) > 0 ? (a*d-b*c)/S(0) : 0;
+  // U is the rotation by phi = (a2+a1)/2 and V' the rotation by
+  // theta = (a2-a1)/2 = phi-a1 with a1 = atan2(G,F) and a2 = atan2(H,E),
+  // computed without trigonometric functions. The half angle is only defined
+  // up to pi, which negates both U and V.
+  const double c1 = R > 0 ? F/R : 1, s1 = R > 0 ? G/R : 0;
+  const double c2 = Q > 0 ? E/Q : 1, s2 = Q > 0 ? H/Q : 0;
+  const double c12 = c1*c2-s1*s2, s12 = s1*c2+c1*s2;
+  double cp, sp;
+  if(c12 >= 0)
+  {
+    cp = std::sqrt((1+c12)/2);
+    sp = s12/(2*cp);
+  }else
+  {
+    sp = std::sqrt((1-c12)/2);
+    cp = s12/(2*sp);
+  }
+  const double ct = cp*c1+sp*s1, st = sp*c1-cp*s1;
+  U << cp, -sp, sp, cp;
+  V << ct, st, -st, ct;
+}
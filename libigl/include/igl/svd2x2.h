@@ -0,0 +1,35 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2016 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SVD2X2_H
+#define IGL_SVD2X2_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  // Closed form SVD of a 2x2 matrix computed without trigonometric functions
+  // The resulting decomposition is A = U * diag(S[0], S[1]) * V' with U and V
+  // rotations (det(U) = det(V) = 1), so S[0] >= |S[1]| and S[1] < 0 iff
+  // det(A) < 0. The closest rotation to A is therefore simply U*V'.
+  //
+  // Inputs:
+  //   A  2x2 matrix
+  // Outputs:
+  //   U  2x2 left singular vectors
+  //   S  2x1 singular values
+  //   V  2x2 right singular vectors
+  IGL_INLINE void svd2x2(
+    const Eigen::Matrix2d & A,
+    Eigen::Matrix2d & U,
+    Eigen::Vector2d & S,
+    Eigen::Matrix2d & V);
+}
+#ifndef IGL_STATIC_LIBRARY
+#  include "svd2x2.cpp"
+#endif
+#endif
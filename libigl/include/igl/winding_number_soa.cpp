@@ -0,0 +1,273 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2015 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "winding_number_soa.h"
+#include "PI.h"
+#include <cassert>
+#include <cmath>
+#if defined(__SSE2__) || defined(__AVX__)
+#  include <immintrin.h>
+#endif
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::winding_number_soa_precompute(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  std::vector<double> & S)
+{
+  assert(V.cols() == 3 && "V should be 3D");
+  assert(F.cols() == 3 && "F should contain triangles");
+  const int m = F.rows();
+  const int nb = (m+3)/4;
+  // Padding stays zero: all corners at the origin
+  S.assign(36*nb,0);
+  for(int f = 0;f<m;f++)
+  {
+    double * block = &S[36*(f/4)];
+    for(int t = 0;t<3;t++)
+    {
+      for(int d = 0;d<3;d++)
+      {
+        block[(t*3+d)*4 + f%4] = V(F(f,t),d);
+      }
+    }
+  }
+}
+
+IGL_INLINE double igl::winding_number_soa(
+  const std::vector<double> & S,
+  const double * o)
+{
+#if defined(__AVX__)
+  return winding_number_soa_AVX(S,o);
+#elif defined(__SSE2__)
+  return winding_number_soa_SSE(S,o);
+#else
+  return winding_number_soa_scalar(S,o);
+#endif
+}
+
+IGL_INLINE double igl::winding_number_soa_scalar(
+  const std::vector<double> & S,
+  const double * o)
+{
+  const int nb = S.size()/36;
+  double w = 0;
+  for(int b = 0;b<nb;b++)
+  {
+    const double * block = &S[36*b];
+    for(int l = 0;l<4;l++)
+    {
+      double v[3][3];
+      double vl[3];
+      for(int t = 0;t<3;t++)
+      {
+        for(int d = 0;d<3;d++)
+        {
+          v[t][d] = block[(t*3+d)*4+l] - o[d];
+        }
+        vl[t] = sqrt(v[t][0]*v[t][0]+v[t][1]*v[t][1]+v[t][2]*v[t][2]);
+      }
+      const double detf =
+        v[0][0]*(v[1][1]*v[2][2]-v[2][1]*v[1][2])-
+        v[1][0]*(v[0][1]*v[2][2]-v[2][1]*v[0][2])+
+        v[2][0]*(v[0][1]*v[1][2]-v[1][1]*v[0][2]);
+      const double dp0 = v[1][0]*v[2][0]+v[1][1]*v[2][1]+v[1][2]*v[2][2];
+      const double dp1 = v[2][0]*v[0][0]+v[2][1]*v[0][1]+v[2][2]*v[0][2];
+      const double dp2 = v[0][0]*v[1][0]+v[0][1]*v[1][1]+v[0][2]*v[1][2];
+      w += atan2(detf,vl[0]*vl[1]*vl[2] + dp0*vl[0] + dp1*vl[1] + dp2*vl[2]);
+    }
+  }
+  // Only divide by 2*pi instead of 4*pi because there was a 2 out front
+  return w/(2.*igl::PI);
+}
+
+#if defined(__SSE2__) || defined(__AVX__)
+namespace igl
+{
+  namespace winding_number_soa_internal
+  {
+    // Thin wrappers so that one kernel serves both instruction sets
+#ifdef __SSE2__
+    struct SSE
+    {
+      typedef __m128d T;
+      enum { W = 2 };
+      static inline T set1(const double a){ return _mm_set1_pd(a); }
+      static inline T load(const double * p){ return _mm_loadu_pd(p); }
+      static inline T add(T a,T b){ return _mm_add_pd(a,b); }
+      static inline T sub(T a,T b){ return _mm_sub_pd(a,b); }
+      static inline T mul(T a,T b){ return _mm_mul_pd(a,b); }
+      static inline T div(T a,T b){ return _mm_div_pd(a,b); }
+      static inline T sqrt(T a){ return _mm_sqrt_pd(a); }
+      static inline T min(T a,T b){ return _mm_min_pd(a,b); }
+      static inline T max(T a,T b){ return _mm_max_pd(a,b); }
+      static inline T andnot(T a,T b){ return _mm_andnot_pd(a,b); }
+      static inline T band(T a,T b){ return _mm_and_pd(a,b); }
+      static inline T bxor(T a,T b){ return _mm_xor_pd(a,b); }
+      static inline T gt(T a,T b){ return _mm_cmpgt_pd(a,b); }
+      static inline T lt(T a,T b){ return _mm_cmplt_pd(a,b); }
+      // mask ? a : b
+      static inline T select(T mask,T a,T b)
+      {
+        return _mm_or_pd(_mm_and_pd(mask,a),_mm_andnot_pd(mask,b));
+      }
+      static inline double sum(T a)
+      {
+        double s[2];
+        _mm_storeu_pd(s,a);
+        return s[0]+s[1];
+      }
+    };
+#endif
+#ifdef __AVX__
+    struct AVX
+    {
+      typedef __m256d T;
+      enum { W = 4 };
+      static inline T set1(const double a){ return _mm256_set1_pd(a); }
+      static inline T load(const double * p){ return _mm256_loadu_pd(p); }
+      static inline T add(T a,T b){ return _mm256_add_pd(a,b); }
+      static inline T sub(T a,T b){ return _mm256_sub_pd(a,b); }
+      static inline T mul(T a,T b){ return _mm256_mul_pd(a,b); }
+      static inline T div(T a,T b){ return _mm256_div_pd(a,b); }
+      static inline T sqrt(T a){ return _mm256_sqrt_pd(a); }
+      static inline T min(T a,T b){ return _mm256_min_pd(a,b); }
+      static inline T max(T a,T b){ return _mm256_max_pd(a,b); }
+      static inline T andnot(T a,T b){ return _mm256_andnot_pd(a,b); }
+      static inline T band(T a,T b){ return _mm256_and_pd(a,b); }
+      static inline T bxor(T a,T b){ return _mm256_xor_pd(a,b); }
+      static inline T gt(T a,T b){ return _mm256_cmp_pd(a,b,_CMP_GT_OQ); }
+      static inline T lt(T a,T b){ return _mm256_cmp_pd(a,b,_CMP_LT_OQ); }
+      static inline T select(T mask,T a,T b)
+      {
+        return _mm256_blendv_pd(b,a,mask);
+      }
+      static inline double sum(T a)
+      {
+        double s[4];
+        _mm256_storeu_pd(s,a);
+        return (s[0]+s[1])+(s[2]+s[3]);
+      }
+    };
+#endif
+    // atan2 of each lane, accurate to a few ulps (Cephes' atan on [0,1] plus
+    // octant reconstruction). atan2(0,0) = 0.
+    template <typename P>
+    inline typename P::T atan2(const typename P::T y, const typename P::T x)
+    {
+      typedef typename P::T T;
+      const T sign = P::set1(-0.0);
+      const T zero = P::set1(0.0);
+      const T ax = P::andnot(sign,x);
+      const T ay = P::andnot(sign,y);
+      const T mx = P::max(ax,ay);
+      const T a = P::div(P::min(ax,ay),P::select(P::gt(mx,zero),mx,P::set1(1)));
+      // Reduce [0,1] to [-tan(pi/8),0.66]
+      const T big = P::gt(a,P::set1(0.66));
+      const T one = P::set1(1);
+      const T xr = P::select(big,P::div(P::sub(a,one),P::add(a,one)),a);
+      const T y0 = P::select(big,P::set1(0.25*igl::PI),zero);
+      const T z = P::mul(xr,xr);
+      T p = P::set1(-8.750608600031904122785E-1);
+      p = P::add(P::mul(p,z),P::set1(-1.615753718733365076637E1));
+      p = P::add(P::mul(p,z),P::set1(-7.500855792314704667340E1));
+      p = P::add(P::mul(p,z),P::set1(-1.228866684490136173410E2));
+      p = P::add(P::mul(p,z),P::set1(-6.485021904942025371773E1));
+      T q = P::add(z,P::set1(2.485846490142306297962E1));
+      q = P::add(P::mul(q,z),P::set1(1.650270098316988542046E2));
+      q = P::add(P::mul(q,z),P::set1(4.328810604912902668951E2));
+      q = P::add(P::mul(q,z),P::set1(4.853903996359136964868E2));
+      q = P::add(P::mul(q,z),P::set1(1.945506571482613964425E2));
+      T r = P::add(P::mul(xr,P::div(P::mul(z,p),q)),xr);
+      r = P::add(r,P::select(big,P::set1(0.5*6.123233995736765886130E-17),zero));
+      r = P::add(y0,r);
+      // Undo swap of x and y, reflection of x and sign of y
+      r = P::select(P::gt(ay,ax),P::sub(P::set1(0.5*igl::PI),r),r);
+      r = P::select(P::lt(x,zero),P::sub(P::set1(igl::PI),r),r);
+      return P::bxor(r,P::band(sign,y));
+    }
+    template <typename P>
+    inline double winding_number(const std::vector<double> & S,const double * o)
+    {
+      typedef typename P::T T;
+      const int nb = S.size()/36;
+      const T O[3] = {P::set1(o[0]),P::set1(o[1]),P::set1(o[2])};
+      T w = P::set1(0);
+      for(int b = 0;b<nb;b++)
+      {
+        for(int l = 0;l<4;l+=P::W)
+        {
+          const double * block = &S[36*b+l];
+          T v[3][3];
+          T vl[3];
+          for(int t = 0;t<3;t++)
+          {
+            for(int d = 0;d<3;d++)
+            {
+              v[t][d] = P::sub(P::load(block+(t*3+d)*4),O[d]);
+            }
+            vl[t] = P::sqrt(P::add(P::add(
+              P::mul(v[t][0],v[t][0]),
+              P::mul(v[t][1],v[t][1])),
+              P::mul(v[t][2],v[t][2])));
+          }
+          const T detf = P::add(P::sub(
+            P::mul(v[0][0],P::sub(
+              P::mul(v[1][1],v[2][2]),P::mul(v[2][1],v[1][2]))),
+            P::mul(v[1][0],P::sub(
+              P::mul(v[0][1],v[2][2]),P::mul(v[2][1],v[0][2])))),
+            P::mul(v[2][0],P::sub(
+              P::mul(v[0][1],v[1][2]),P::mul(v[1][1],v[0][2]))));
+          T dp[3];
+          for(int t = 0;t<3;t++)
+          {
+            const int t1 = (t+1)%3;
+            const int t2 = (t+2)%3;
+            dp[t] = P::add(P::add(
+              P::mul(v[t1][0],v[t2][0]),
+              P::mul(v[t1][1],v[t2][1])),
+              P::mul(v[t1][2],v[t2][2]));
+          }
+          const T den = P::add(P::add(P::add(
+            P::mul(P::mul(vl[0],vl[1]),vl[2]),
+            P::mul(dp[0],vl[0])),
+            P::mul(dp[1],vl[1])),
+            P::mul(dp[2],vl[2]));
+          w = P::add(w,atan2<P>(detf,den));
+        }
+      }
+      return P::sum(w)/(2.*igl::PI);
+    }
+  }
+}
+#endif
+
+#ifdef __SSE2__
+IGL_INLINE double igl::winding_number_soa_SSE(
+  const std::vector<double> & S,
+  const double * o)
+{
+  return winding_number_soa_internal::winding_number<
+    winding_number_soa_internal::SSE>(S,o);
+}
+#endif
+
+#ifdef __AVX__
+IGL_INLINE double igl::winding_number_soa_AVX(
+  const std::vector<double> & S,
+  const double * o)
+{
+  return winding_number_soa_internal::winding_number<
+    winding_number_soa_internal::AVX>(S,o);
+}
+#endif
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::winding_number_soa_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, std::vector<double, std::allocator<double> >&);
+#endif
@@ -0,0 +1,66 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2015 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_WINDING_NUMBER_SOA_H
+#define IGL_WINDING_NUMBER_SOA_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <vector>
+namespace igl
+{
+  // Copy the corners of a triangle mesh into a structure-of-arrays layout for
+  // vectorized evaluation of winding numbers (see winding_number_soa below).
+  // Triangles are grouped in blocks of 4; a block stores the x coordinates of
+  // the first corners of its 4 triangles, then their y coordinates, ..., then
+  // the z coordinates of their third corners (36 doubles). The last block is
+  // padded with degenerate triangles, which contribute nothing.
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of triangle indices into V
+  // Outputs:
+  //   S  36*ceil(#F/4) list of corner coordinates
+  template <typename DerivedV, typename DerivedF>
+  IGL_INLINE void winding_number_soa_precompute(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    std::vector<double> & S);
+  // Compute the winding number of a packed mesh at a single point, i.e., the
+  // sum of the solid angles of its triangles [Van Oosterom & Strackee 1983]
+  // divided by 4*pi. Uses AVX if compiled with AVX support, otherwise SSE2,
+  // otherwise the scalar implementation.
+  //
+  // Inputs:
+  //   S  list of corner coordinates (see winding_number_soa_precompute)
+  //   o  pointer to 3 coordinates of query point
+  // Returns winding number
+  IGL_INLINE double winding_number_soa(
+    const std::vector<double> & S,
+    const double * o);
+  // Same as above using std::atan2 on one triangle at a time (reference)
+  IGL_INLINE double winding_number_soa_scalar(
+    const std::vector<double> & S,
+    const double * o);
+#ifdef __SSE2__
+  // Same as above evaluating 2 triangles per instruction
+  IGL_INLINE double winding_number_soa_SSE(
+    const std::vector<double> & S,
+    const double * o);
+#endif
+#ifdef __AVX__
+  // Same as above evaluating 4 triangles per instruction
+  IGL_INLINE double winding_number_soa_AVX(
+    const std::vector<double> & S,
+    const double * o);
+#endif
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "winding_number_soa.cpp"
+#endif
+
+#endif
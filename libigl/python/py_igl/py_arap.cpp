@@ -22,6 +22,16 @@ ARAPData
 .def_readwrite("CSM", &igl::ARAPData::CSM)
 // .def_readwrite("solver_data", &igl::ARAPData::solver_data)
 .def_readwrite("dim", &igl::ARAPData::dim)
+.def_readwrite("anderson_window", &igl::ARAPData::anderson_window)
+.def_readwrite("parallel_local_step", &igl::ARAPData::parallel_local_step)
+.def_readwrite("iter", &igl::ARAPData::iter)
+.def_property("energies",
+[](const igl::ARAPData& data) {return Eigen::MatrixXd(data.energies);},
+[](igl::ARAPData& data, const Eigen::MatrixXd& energies)
+{
+  assert_is_VectorX("energies",energies);
+  data.energies = Eigen::VectorXd(energies);
+})
 .def_property("b",
 [](const igl::ARAPData& data) {return Eigen::MatrixXi(data.b);},
 [](igl::ARAPData& data, const Eigen::MatrixXi& b)
@@ -0,0 +1,60 @@
+#include <igl/get_seconds.h>
+#include <igl/hausdorff.h>
+#include <igl/parallel_qslim.h>
+#include <igl/qslim.h>
+#include <igl/read_triangle_mesh.h>
+#include <igl/upsample.h>
+#include <Eigen/Core>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "tutorial_shared_path.h"
+
+int main(int argc, char * argv[])
+{
+  using namespace std;
+  using namespace Eigen;
+  cout<<"Usage: ./712_ParallelDecimation_bin [filename.(off|obj|ply)] "
+    "[#upsample] [ratio]"<<endl;
+  string filename(TUTORIAL_SHARED_PATH "/fertility.off");
+  if(argc>=2)
+  {
+    filename = argv[1];
+  }
+  MatrixXd V;
+  MatrixXi F;
+  igl::read_triangle_mesh(filename,V,F);
+  // Optionally subdivide to get a larger input
+  if(argc>=3)
+  {
+    igl::upsample(MatrixXd(V),MatrixXi(F),V,F,atoi(argv[2]));
+  }
+  const double ratio = argc>=4 ? atof(argv[3]) : 0.1;
+  const size_t max_m = ratio*F.rows();
+  printf("Decimating %d faces to %d\n",(int)F.rows(),(int)max_m);
+
+  MatrixXd U;
+  MatrixXi G;
+  VectorXi J,I;
+  // Report time and (symmetric) Hausdorff distance to the input
+  const auto report = [&](const string & name, const double t)
+  {
+    double d;
+    igl::hausdorff(V,F,U,G,d);
+    printf("%-24s %8.3f s %8d faces  Hausdorff %g\n",
+      name.c_str(),t,(int)G.rows(),d);
+  };
+
+  double t = igl::get_seconds();
+  igl::qslim(V,F,max_m,U,G,J,I);
+  report("qslim",igl::get_seconds()-t);
+  for(const double fraction : {0.01,0.1,0.5})
+  {
+    t = igl::get_seconds();
+    igl::parallel_qslim(V,F,max_m,fraction,U,G,J,I);
+    report("parallel_qslim("+to_string(fraction).substr(0,4)+")",
+      igl::get_seconds()-t);
+  }
+}
@@ -0,0 +1,118 @@
+#include <igl/decimate.h>
+#include <igl/get_seconds.h>
+#include <igl/qslim.h>
+#include <igl/read_triangle_mesh.h>
+#include <igl/upsample.h>
+#include <Eigen/Core>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#ifdef __GLIBC__
+#  include <malloc.h>
+#endif
+
+#include "tutorial_shared_path.h"
+
+// Returns the value in MB of a field of /proc/self/status (e.g. "VmRSS:" for
+// the current and "VmHWM:" for the peak resident set size), or -1 if not
+// available (not on Linux)
+double status_mb(const std::string & field)
+{
+  std::ifstream status("/proc/self/status");
+  std::string key;
+  while(status >> key)
+  {
+    if(key == field)
+    {
+      double kb;
+      status >> kb;
+      return kb/1024.;
+    }
+  }
+  return -1;
+}
+
+// Return freed memory to the system and reset the peak resident set size to
+// the current one
+void reset_peak()
+{
+#ifdef __GLIBC__
+  malloc_trim(0);
+#endif
+  std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+int main(int argc, char * argv[])
+{
+  using namespace std;
+  using namespace Eigen;
+  cout<<"Usage: ./713_DecimationMemory_bin [filename.(off|obj|ply)] "
+    "[#upsample] [ratio]"<<endl;
+  string filename(TUTORIAL_SHARED_PATH "/fertility.off");
+  if(argc>=2)
+  {
+    filename = argv[1];
+  }
+  MatrixXd V;
+  MatrixXi F;
+  igl::read_triangle_mesh(filename,V,F);
+  // Optionally subdivide to get a larger input
+  if(argc>=3)
+  {
+    igl::upsample(MatrixXd(V),MatrixXi(F),V,F,atoi(argv[2]));
+  }
+  const double ratio = argc>=4 ? atof(argv[3]) : 0.1;
+  const size_t max_m = ratio*F.rows();
+  printf("Decimating %d faces to %d (input takes %.1f MB)\n",
+    (int)F.rows(),(int)max_m,
+    (V.size()*sizeof(double)+F.size()*sizeof(int))/(1024.*1024.));
+
+  // Report time and memory used on top of the caller's data (including the
+  // copy handed over to the move-in versions)
+  const auto measure = [&](
+    const string & name,
+    const function<void(MatrixXd &,MatrixXi &,VectorXi &,VectorXi &)> & run)
+  {
+    MatrixXd U;
+    MatrixXi G;
+    VectorXi J,I;
+    reset_peak();
+    const double before = status_mb("VmRSS:");
+    const double t = igl::get_seconds();
+    run(U,G,J,I);
+    const double time = igl::get_seconds()-t;
+    const double peak = status_mb("VmHWM:");
+    printf("%-24s %8.3f s %8d faces  peak %8.1f MB\n",
+      name.c_str(),time,(int)G.rows(),before<0 ? -1.0 : peak-before);
+  };
+
+  measure("decimate",[&](MatrixXd & U,MatrixXi & G,VectorXi & J,VectorXi & I)
+  {
+    igl::decimate(V,F,max_m,U,G,J,I);
+  });
+  {
+    MatrixXd W = V;
+    MatrixXi H = F;
+    measure("decimate (move)",
+      [&](MatrixXd & U,MatrixXi & G,VectorXi & J,VectorXi & I)
+    {
+      igl::decimate(std::move(W),std::move(H),max_m,U,G,J,I);
+    });
+  }
+  measure("qslim",[&](MatrixXd & U,MatrixXi & G,VectorXi & J,VectorXi & I)
+  {
+    igl::qslim(V,F,max_m,U,G,J,I);
+  });
+  {
+    MatrixXd W = V;
+    MatrixXi H = F;
+    measure("qslim (move)",
+      [&](MatrixXd & U,MatrixXi & G,VectorXi & J,VectorXi & I)
+    {
+      igl::qslim(std::move(W),std::move(H),max_m,U,G,J,I);
+    });
+  }
+}
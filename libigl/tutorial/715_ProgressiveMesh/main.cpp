@@ -0,0 +1,81 @@
+#include <igl/get_seconds.h>
+#include <igl/progressive_mesh_lod.h>
+#include <igl/progressive_qslim.h>
+#include <igl/qslim.h>
+#include <igl/read_triangle_mesh.h>
+#include <igl/upsample.h>
+#include <Eigen/Core>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "tutorial_shared_path.h"
+
+int main(int argc, char * argv[])
+{
+  using namespace std;
+  using namespace Eigen;
+  cout<<"Usage: ./715_ProgressiveMesh_bin [filename.(off|obj|ply)] "
+    "[#upsample]"<<endl;
+  string filename(TUTORIAL_SHARED_PATH "/fertility.off");
+  if(argc>=2)
+  {
+    filename = argv[1];
+  }
+  MatrixXd V;
+  MatrixXi F;
+  igl::read_triangle_mesh(filename,V,F);
+  // Optionally subdivide to get a larger input
+  if(argc>=3)
+  {
+    igl::upsample(MatrixXd(V),MatrixXi(F),V,F,atoi(argv[2]));
+  }
+  // Levels of detail: halving the number of faces down to about 1000
+  vector<size_t> lods;
+  for(size_t m = F.rows()/2;m >= 1000;m /= 2)
+  {
+    lods.push_back(m);
+  }
+  printf("Levels of detail of a mesh with %d faces:",(int)F.rows());
+  for(const size_t m : lods)
+  {
+    printf(" %d",(int)m);
+  }
+  printf("\n");
+
+  MatrixXd U;
+  MatrixXi G;
+  VectorXi J,I;
+  // One call to qslim per level of detail
+  double t = igl::get_seconds();
+  for(const size_t m : lods)
+  {
+    igl::qslim(V,F,m,U,G,J,I);
+  }
+  printf("%-28s %8.3f s\n","qslim per level",igl::get_seconds()-t);
+
+  // One decimation recorded once, then levels of detail from coarse to fine
+  // and back
+  t = igl::get_seconds();
+  igl::ProgressiveMesh PM;
+  igl::progressive_qslim(V,F,lods.back(),PM);
+  printf("%-28s %8.3f s (%.1f MB of collapses)\n","progressive_qslim",
+    igl::get_seconds()-t,PM.collapses.size()/(1024.*1024.));
+  t = igl::get_seconds();
+  for(int l = lods.size()-1;l>=0;l--)
+  {
+    igl::progressive_mesh_lod(lods[l],PM);
+  }
+  for(const size_t m : lods)
+  {
+    igl::progressive_mesh_lod(m,PM);
+  }
+  printf("%-28s %8.3f s\n","progressive_mesh_lod x2",igl::get_seconds()-t);
+  t = igl::get_seconds();
+  for(const size_t m : lods)
+  {
+    igl::progressive_mesh_lod(m,PM,U,G,J,I);
+  }
+  printf("%-28s %8.3f s\n","  with extraction",igl::get_seconds()-t);
+}
@@ -0,0 +1,102 @@
+#include <igl/get_seconds.h>
+#include <igl/read_triangle_mesh.h>
+#include <igl/winding_number.h>
+#include <igl/winding_number_soa.h>
+#include <igl/WindingNumberTree.h>
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "tutorial_shared_path.h"
+
+int main(int argc, char * argv[])
+{
+  using namespace std;
+  using namespace Eigen;
+  cout<<"Usage: ./716_WindingNumberSoA_bin [filename.(off|obj|ply)] "
+    "[#queries]"<<endl;
+  string filename(TUTORIAL_SHARED_PATH "/bunny.off");
+  if(argc>=2)
+  {
+    filename = argv[1];
+  }
+  MatrixXd V;
+  MatrixXi F;
+  igl::read_triangle_mesh(filename,V,F);
+  const int no = argc>=3 ? atoi(argv[2]) : 1000;
+  // Random queries in the bounding box enlarged by 10%
+  const RowVector3d min_corner = V.colwise().minCoeff();
+  const RowVector3d max_corner = V.colwise().maxCoeff();
+  const RowVector3d center = 0.5*(min_corner+max_corner);
+  const RowVector3d half = 0.55*(max_corner-min_corner);
+  MatrixXd O = MatrixXd::Random(no,3);
+  for(int o = 0;o<no;o++)
+  {
+    O.row(o) = center+O.row(o).cwiseProduct(half);
+  }
+  printf("%d winding numbers of a mesh with %d faces\n",no,(int)F.rows());
+
+  // Reference: one triangle at a time
+  VectorXd W_ref(no);
+  double t = igl::get_seconds();
+  for(int o = 0;o<no;o++)
+  {
+    const RowVector3d p = O.row(o);
+    igl::winding_number_3(V.data(),V.rows(),F.data(),F.rows(),p.data(),1,
+      &W_ref(o));
+  }
+  const double t_ref = igl::get_seconds()-t;
+  printf("%-30s %8.3f s\n","winding_number_3",t_ref);
+
+  // Packed evaluations: compare to the reference
+  std::vector<double> S;
+  t = igl::get_seconds();
+  igl::winding_number_soa_precompute(V,F,S);
+  printf("%-30s %8.3f s\n","winding_number_soa_precompute",
+    igl::get_seconds()-t);
+  const auto compare = [&](
+    const string & name,
+    const function<double(const Vector3d &)> & w)
+  {
+    double max_err = 0;
+    const double t = igl::get_seconds();
+    for(int o = 0;o<no;o++)
+    {
+      const Vector3d p = O.row(o).transpose();
+      max_err = std::max(max_err,std::abs(w(p)-W_ref(o)));
+    }
+    const double time = igl::get_seconds()-t;
+    printf("%-30s %8.3f s  speedup %6.2f  max |w-w_ref| %g\n",
+      name.c_str(),time,t_ref/time,max_err);
+  };
+  compare("winding_number_soa_scalar",[&](const Vector3d & p)
+  {
+    return igl::winding_number_soa_scalar(S,p.data());
+  });
+#ifdef __SSE2__
+  compare("winding_number_soa_SSE",[&](const Vector3d & p)
+  {
+    return igl::winding_number_soa_SSE(S,p.data());
+  });
+#endif
+#ifdef __AVX__
+  compare("winding_number_soa_AVX",[&](const Vector3d & p)
+  {
+    return igl::winding_number_soa_AVX(S,p.data());
+  });
+#endif
+  compare("winding_number_soa",[&](const Vector3d & p)
+  {
+    return igl::winding_number_soa(S,p.data());
+  });
+  igl::WindingNumberTree<Vector3d> tree(V,F);
+  compare("WindingNumberTree (all)",[&](const Vector3d & p)
+  {
+    return tree.winding_number_all(p);
+  });
+}
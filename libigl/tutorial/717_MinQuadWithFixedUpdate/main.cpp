@@ -0,0 +1,145 @@
+#include <igl/cotmatrix.h>
+#include <igl/get_seconds.h>
+#include <igl/min_quad_with_fixed.h>
+#include <igl/min_quad_with_fixed_update.h>
+#include <igl/read_triangle_mesh.h>
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "tutorial_shared_path.h"
+
+int main(int argc, char * argv[])
+{
+  using namespace std;
+  using namespace Eigen;
+  cout<<"Usage: ./717_MinQuadWithFixedUpdate_bin [filename.(off|obj|ply)]"<<
+    endl;
+  string filename(TUTORIAL_SHARED_PATH "/bunny.off");
+  if(argc>=2)
+  {
+    filename = argv[1];
+  }
+  MatrixXd V;
+  MatrixXi F;
+  igl::read_triangle_mesh(filename,V,F);
+  const int n = V.rows();
+  SparseMatrix<double> L;
+  igl::cotmatrix(V,F,L);
+  const VectorXd B = VectorXd::Random(n);
+  // Linear equality constraints given as lists of (index,coefficient) pairs.
+  // No constraints is an empty (0 by 0) matrix.
+  typedef vector<vector<pair<int,double> > > Rows;
+  const auto sparse_rows = [n](const Rows & R)
+  {
+    if(R.empty())
+    {
+      return SparseMatrix<double>();
+    }
+    vector<Triplet<double> > IJV;
+    for(int i = 0;i<(int)R.size();i++)
+    {
+      for(const auto & p : R[i])
+      {
+        IJV.emplace_back(i,p.first,p.second);
+      }
+    }
+    SparseMatrix<double> Aeq(R.size(),n);
+    Aeq.setFromTriplets(IJV.begin(),IJV.end());
+    return Aeq;
+  };
+
+  // Edit a sequence of handles and constraints, and compare each update to
+  // a fresh min_quad_with_fixed_precompute/solve
+  const auto edit_sequence = [&](
+    const string & name,
+    const SparseMatrix<double> & A,
+    const bool pd,
+    const Rows & R0)
+  {
+    printf("%s\n",name.c_str());
+    igl::min_quad_with_fixed_update_data<double> data;
+    vector<int> b = {0,n/3,2*n/3};
+    Rows R = R0;
+    double max_err = 0;
+    const auto step = [&](const string & edit,const bool first)
+    {
+      const VectorXi known = Map<const VectorXi>(b.data(),b.size());
+      const SparseMatrix<double> Aeq = sparse_rows(R);
+      MatrixXd Y(b.size(),2);
+      for(int i = 0;i<(int)b.size();i++)
+      {
+        Y(i,0) = sin(b[i]);
+        Y(i,1) = cos(b[i]);
+      }
+      const VectorXd Beq = VectorXd::LinSpaced(R.size(),1,2);
+      double t = igl::get_seconds();
+      if(first)
+      {
+        igl::min_quad_with_fixed_update_precompute(A,known,Aeq,pd,data);
+      }else
+      {
+        igl::min_quad_with_fixed_update(known,Aeq,data);
+      }
+      MatrixXd Z;
+      igl::min_quad_with_fixed_update_solve(data,B,Y,Beq,Z);
+      const double t_update = igl::get_seconds()-t;
+      t = igl::get_seconds();
+      igl::min_quad_with_fixed_data<double> fresh;
+      igl::min_quad_with_fixed_precompute(A,known,Aeq,pd,fresh);
+      MatrixXd Z_ref(n,Y.cols());
+      for(int c = 0;c<Y.cols();c++)
+      {
+        VectorXd Yc = Y.col(c),Zc;
+        igl::min_quad_with_fixed_solve(fresh,B,Yc,Beq,Zc);
+        Z_ref.col(c) = Zc;
+      }
+      const double t_fresh = igl::get_seconds()-t;
+      const double err =
+        (Z-Z_ref).cwiseAbs().maxCoeff()/Z_ref.cwiseAbs().maxCoeff();
+      max_err = std::max(max_err,err);
+      printf("  %-26s %8.4f s  fresh %8.4f s  rel. error %g\n",
+        edit.c_str(),t_update,t_fresh,err);
+    };
+    step("precompute 3 handles",true);
+    b.push_back(n/7);
+    b.push_back(n/7+13);
+    step("add 2 handles",false);
+    b.erase(b.begin()+1);
+    step("remove a base handle",false);
+    R.push_back({{n/9,1.0},{n/9+1,-1.0},{n/3,0.5}});
+    step("add a constraint",false);
+    std::swap(b[0],b[2]);
+    step("reorder handles",false);
+    b.resize(3);
+    R = R0;
+    step("back to 3 handles",false);
+    printf("  %-26s %g\n","max rel. error",max_err);
+  };
+
+  const Rows no_rows;
+  const Rows two_rows = {{{7,1.0},{9,-1.0}},{{n/2,1.0},{n/2+5,1.0}}};
+  // Symmetric positive definite
+  const SparseMatrix<double> A = -L;
+  edit_sequence("Symmetric, empty Aeq",A,true,no_rows);
+  edit_sequence("Symmetric, 2 constraints",A,true,two_rows);
+  // Non-symmetric: scale the strict upper triangle
+  SparseMatrix<double> N = A;
+  for(int k = 0;k<N.outerSize();k++)
+  {
+    for(SparseMatrix<double>::InnerIterator it(N,k);it;++it)
+    {
+      if(it.row() < it.col())
+      {
+        it.valueRef() *= 1.1;
+      }
+    }
+  }
+  edit_sequence("Non-symmetric, empty Aeq",N,false,no_rows);
+  edit_sequence("Non-symmetric, 2 constraints",N,false,two_rows);
+}
@@ -0,0 +1,118 @@
+#include <igl/fit_rotations.h>
+#include <igl/get_seconds.h>
+#include <Eigen/Core>
+#include <Eigen/SVD>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+
+// Random stack of nr dim by dim covariance matrices, some of them rank
+// deficient, badly conditioned, reflections or badly scaled
+Eigen::MatrixXd random_covariances(const int nr,const int dim)
+{
+  Eigen::MatrixXd S = Eigen::MatrixXd::Random(nr*dim,dim);
+  for(int r = 0;r<nr;r++)
+  {
+    for(int i = 0;i<dim;i++)
+    {
+      if(r%7 == 0)
+      {
+        S(i*nr+r,dim-1) = S(i*nr+r,0);
+      }
+      if(r%11 == 3)
+      {
+        S(i*nr+r,0) *= 1e-6;
+      }
+      if(r%13 == 5)
+      {
+        S.row(i*nr+r) *= 1e5;
+      }
+    }
+  }
+  return S;
+}
+
+// Compare rotations fit by func to the reference R_ref, ignoring
+// covariance matrices whose rotation is not unique
+void compare(
+  const std::string & name,
+  const Eigen::MatrixXd & S,
+  const Eigen::MatrixXd & R_ref,
+  const double t_ref,
+  const std::function<void(Eigen::MatrixXd &)> & func)
+{
+  using namespace Eigen;
+  const int dim = S.cols();
+  const int nr = S.rows()/dim;
+  MatrixXd R;
+  const double t = igl::get_seconds();
+  func(R);
+  const double time = igl::get_seconds()-t;
+  double max_err = 0;
+  double max_det_err = 0;
+  for(int r = 0;r<nr;r++)
+  {
+    MatrixXd si(dim,dim);
+    for(int i = 0;i<dim;i++)
+    {
+      for(int j = 0;j<dim;j++)
+      {
+        si(i,j) = S(i*nr+r,j);
+      }
+    }
+    const VectorXd s = JacobiSVD<MatrixXd>(si).singularValues();
+    const MatrixXd ri = R.block(0,r*dim,dim,dim);
+    max_det_err = std::max(max_det_err,std::abs(ri.determinant()-1));
+    if(s(dim-2) > 1e-8*s(0))
+    {
+      max_err = std::max(max_err,(ri-R_ref.block(0,r*dim,dim,dim)).norm());
+    }
+  }
+  printf("%-30s %8.3f s  speedup %6.2f  max |R-R_ref| %g  max |det-1| %g\n",
+    name.c_str(),time,t_ref/time,max_err,max_det_err);
+}
+
+int main(int argc, char * argv[])
+{
+  using namespace std;
+  using namespace Eigen;
+  cout<<"Usage: ./718_FitRotations_bin [#rotations]"<<endl;
+  const int nr = argc>=2 ? atoi(argv[1]) : 100000;
+
+  // 3D: reference is the double precision polar_svd of fit_rotations
+  {
+    const MatrixXd S = random_covariances(nr,3);
+    MatrixXd R_ref;
+    double t = igl::get_seconds();
+    igl::fit_rotations(S,false,R_ref);
+    const double t_ref = igl::get_seconds()-t;
+    printf("%d 3x3 rotations\n",nr);
+    printf("%-30s %8.3f s\n","fit_rotations (double)",t_ref);
+    compare("fit_rotations (single)",S,R_ref,t_ref,[&](MatrixXd & R)
+    {
+      igl::fit_rotations(S,true,R);
+    });
+    compare("fit_rotations_SIMD",S,R_ref,t_ref,[&](MatrixXd & R)
+    {
+      igl::fit_rotations_SIMD(S,R);
+    });
+  }
+  // 2D: reference is fit_rotations_planar
+  {
+    const MatrixXd S = random_covariances(nr,2);
+    MatrixXd R_ref;
+    double t = igl::get_seconds();
+    igl::fit_rotations_planar(S,R_ref);
+    const double t_ref = igl::get_seconds()-t;
+    printf("%d 2x2 rotations\n",nr);
+    printf("%-30s %8.3f s\n","fit_rotations_planar",t_ref);
+    compare("fit_rotations_SIMD",S,R_ref,t_ref,[&](MatrixXd & R)
+    {
+      igl::fit_rotations_SIMD(S,R);
+    });
+  }
+}
@@ -0,0 +1,138 @@
+#include <igl/biharmonic_coordinates.h>
+#include <igl/cotmatrix.h>
+#include <igl/get_seconds.h>
+#include <igl/massmatrix.h>
+#include <igl/min_quad_with_fixed.h>
+#include <igl/readMESH.h>
+#include <igl/ThreadPool.h>
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#ifdef __GLIBC__
+#  include <malloc.h>
+#endif
+
+#include "tutorial_shared_path.h"
+
+// Returns the value in MB of a field of /proc/self/status (e.g. "VmRSS:" for
+// the current and "VmHWM:" for the peak resident set size), or -1 if not
+// available (not on Linux)
+double status_mb(const std::string & field)
+{
+  std::ifstream status("/proc/self/status");
+  std::string key;
+  while(status >> key)
+  {
+    if(key == field)
+    {
+      double kb;
+      status >> kb;
+      return kb/1024.;
+    }
+  }
+  return -1;
+}
+
+// Return freed memory to the system and reset the peak resident set size to
+// the current one
+void reset_peak()
+{
+#ifdef __GLIBC__
+  malloc_trim(0);
+#endif
+  std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+int main(int argc, char * argv[])
+{
+  using namespace std;
+  using namespace Eigen;
+  cout<<"Usage: ./719_MultiColumnSolve_bin [#handles]"<<endl;
+  MatrixXd V;
+  MatrixXi T,F;
+  igl::readMESH(TUTORIAL_SHARED_PATH "/hand.mesh",V,T,F);
+  const int nh = argc>=2 ? atoi(argv[1]) : 1000;
+  // Point handles at surface vertices spread over their index range
+  vector<int> surface(F.data(),F.data()+F.size());
+  std::sort(surface.begin(),surface.end());
+  surface.erase(std::unique(surface.begin(),surface.end()),surface.end());
+  vector<vector<int> > S(nh);
+  VectorXi b(nh);
+  for(int h = 0;h<nh;h++)
+  {
+    b(h) = surface[(long)h*surface.size()/nh];
+    S[h] = {b(h)};
+  }
+  printf("%d handles on a mesh with %d vertices and %d tets, %d threads\n",
+    nh,(int)V.rows(),(int)T.rows(),
+    (int)igl::ThreadPool::instance().num_threads());
+
+  // Report time and memory used on top of what is already allocated, and
+  // return the solution
+  const auto measure = [&](
+    const string & name,
+    const function<void(MatrixXd &)> & run,
+    const MatrixXd & W_ref)->MatrixXd
+  {
+    MatrixXd W;
+    reset_peak();
+    const double before = status_mb("VmRSS:");
+    const double t = igl::get_seconds();
+    run(W);
+    const double time = igl::get_seconds()-t;
+    const double peak = status_mb("VmHWM:");
+    printf("%-30s %8.3f s  peak %8.1f MB",
+      name.c_str(),time,before<0 ? -1.0 : peak-before);
+    if(W_ref.size() > 0)
+    {
+      printf("  max |W-W_serial| %g",(W-W_ref).cwiseAbs().maxCoeff());
+    }
+    printf("\n");
+    return W;
+  };
+
+  measure("biharmonic_coordinates",[&](MatrixXd & W)
+  {
+    igl::biharmonic_coordinates(V,T,S,2,W);
+  },MatrixXd());
+
+  // Bi-Laplacian system of the same size: one column per handle
+  SparseMatrix<double> L,M;
+  igl::cotmatrix(V,T,L);
+  igl::massmatrix(V,T,igl::MASSMATRIX_TYPE_DEFAULT,M);
+  const VectorXd Minv = M.diagonal().cwiseInverse();
+  const SparseMatrix<double> A = L.transpose()*Minv.asDiagonal()*L;
+  igl::min_quad_with_fixed_data<double> data;
+  double t = igl::get_seconds();
+  igl::min_quad_with_fixed_precompute(A,b,SparseMatrix<double>(),true,data);
+  printf("%-30s %8.3f s\n","min_quad_with_fixed_precompute",
+    igl::get_seconds()-t);
+  const VectorXd B = VectorXd::Zero(V.rows());
+  const MatrixXd Y = MatrixXd::Identity(nh,nh);
+  const VectorXd Beq;
+  const MatrixXd W_serial =
+    measure("serial (column by column)",[&](MatrixXd & W)
+  {
+    W.resize(V.rows(),nh);
+    for(int c = 0;c<nh;c++)
+    {
+      VectorXd Yc = Y.col(c),Wc;
+      igl::min_quad_with_fixed_solve(data,B,Yc,Beq,Wc);
+      W.col(c) = Wc;
+    }
+  },MatrixXd());
+  for(const int max_block : {1,8,64,256})
+  {
+    measure("max_block = "+to_string(max_block),[&](MatrixXd & W)
+    {
+      igl::min_quad_with_fixed_solve(data,B,Y,Beq,max_block,W);
+    },W_serial);
+  }
+}
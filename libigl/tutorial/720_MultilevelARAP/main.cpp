@@ -0,0 +1,142 @@
+#include <igl/arap.h>
+#include <igl/arap_multilevel.h>
+#include <igl/get_seconds.h>
+#include <igl/read_triangle_mesh.h>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "tutorial_shared_path.h"
+
+// Fix the vertices in the bottom and top 5% of the bounding box along y, the
+// top ones are rotated about the centroid and moved sideways
+void handles(
+  const Eigen::MatrixXd & V,
+  Eigen::VectorXi & b,
+  Eigen::MatrixXd & bc)
+{
+  using namespace Eigen;
+  const double ymin = V.col(1).minCoeff();
+  const double ymax = V.col(1).maxCoeff();
+  const double h = ymax-ymin;
+  const Matrix3d R =
+    (AngleAxisd(1.0,Vector3d::UnitY())*AngleAxisd(0.5,Vector3d::UnitX()))
+    .toRotationMatrix();
+  const RowVector3d c = V.colwise().mean();
+  std::vector<int> bv;
+  for(int i = 0;i<V.rows();i++)
+  {
+    if(V(i,1) < ymin+0.05*h || V(i,1) > ymax-0.05*h)
+    {
+      bv.push_back(i);
+    }
+  }
+  b.resize(bv.size());
+  bc.resize(bv.size(),3);
+  for(int i = 0;i<(int)bv.size();i++)
+  {
+    b(i) = bv[i];
+    bc.row(i) = V.row(b(i));
+    if(V(b(i),1) > ymax-0.05*h)
+    {
+      bc.row(i) = (V.row(b(i))-c)*R.transpose()+c+RowVector3d(0.2*h,0,0);
+    }
+  }
+}
+
+// Run single iterations of data on U until its energy is within tol of Estar
+// relative to E0-Estar, and return the time spent (-1 if not reached within
+// max_iter iterations)
+double time_to_tolerance(
+  const Eigen::MatrixXd & bc,
+  const double E0,
+  const double Estar,
+  const double tol,
+  const int max_iter,
+  igl::ARAPData & data,
+  Eigen::MatrixXd & U,
+  int & iter)
+{
+  data.max_iter = 1;
+  double time = 0;
+  for(iter = 0;iter<max_iter;iter++)
+  {
+    const double t = igl::get_seconds();
+    igl::arap_solve(bc,data,U);
+    // energies(0) is the energy of U before this iteration's global step
+    if(data.energies(0)-Estar <= tol*(E0-Estar))
+    {
+      return time;
+    }
+    time += igl::get_seconds()-t;
+  }
+  return -1;
+}
+
+int main(int argc, char * argv[])
+{
+  using namespace std;
+  using namespace Eigen;
+  cout<<"Usage: ./720_MultilevelARAP_bin [filename.(off|obj|ply)] "<<
+    "[#reference iterations]"<<endl;
+  vector<string> filenames = {
+    TUTORIAL_SHARED_PATH "/armadillo.obj",
+    TUTORIAL_SHARED_PATH "/beetle.off",
+    TUTORIAL_SHARED_PATH "/face.obj"};
+  if(argc>=2)
+  {
+    filenames = {argv[1]};
+  }
+  const int max_iter = argc>=3 ? atoi(argv[2]) : 1000;
+  const double tol = 1e-5;
+  for(const string & filename : filenames)
+  {
+    MatrixXd V;
+    MatrixXi F;
+    igl::read_triangle_mesh(filename,V,F);
+    VectorXi b;
+    MatrixXd bc;
+    handles(V,b,bc);
+    printf("%s: %d vertices, %d faces, %d handles\n",
+      filename.substr(filename.find_last_of("/\\")+1).c_str(),
+      (int)V.rows(),(int)F.rows(),(int)b.rows());
+
+    // Reference minimum energy: many flat iterations from the rest pose
+    igl::ARAPData flat;
+    double t = igl::get_seconds();
+    igl::arap_precomputation(V,F,3,b,flat);
+    printf("  %-28s %8.3f s\n","flat precomputation",igl::get_seconds()-t);
+    MatrixXd U = V;
+    flat.max_iter = max_iter;
+    igl::arap_solve(bc,flat,U);
+    const double E0 = flat.energies(0);
+    const double Estar = flat.energies.minCoeff();
+
+    int iter;
+    U = V;
+    const double t_flat =
+      time_to_tolerance(bc,E0,Estar,tol,max_iter,flat,U,iter);
+    printf("  %-28s %8.3f s  %4d iterations\n","flat to 1e-5",t_flat,iter);
+
+    // Multilevel: solve on the coarse levels only, then iterate on the input
+    // mesh
+    igl::ARAPMultilevelData multi;
+    multi.max_iter = 0;
+    t = igl::get_seconds();
+    igl::arap_multilevel_precomputation(V,F,3,b,multi);
+    printf("  %-28s %8.3f s  %d levels\n","multilevel precomputation",
+      igl::get_seconds()-t,(int)multi.V.size());
+    U = V;
+    t = igl::get_seconds();
+    igl::arap_multilevel_solve(bc,multi,U);
+    const double t_coarse = igl::get_seconds()-t;
+    const double t_fine =
+      time_to_tolerance(bc,E0,Estar,tol,max_iter,*multi.data[0],U,iter);
+    printf("  %-28s %8.3f s  %4d iterations on the input mesh\n",
+      "multilevel to 1e-5",t_fine<0 ? -1 : t_coarse+t_fine,iter);
+  }
+}